@@ -0,0 +1,75 @@
+#ifndef __CC_MATH_AABB__
+#define __CC_MATH_AABB__
+
+#include <cstddef>
+#include <vector>
+#include "Vec3.hpp"
+#include "Mat4.hpp"
+#include "StridedSpan.hpp"
+
+namespace cc {
+  namespace math {
+    // Axis-aligned bounding box.  A default constructed box is empty (inverted) and grows to fit whatever is added to it.
+    template<typename T>
+    class Aabb {
+    public:
+      inline Aabb();
+      inline Aabb( const Vec3<T>& boundsMin, const Vec3<T>& boundsMax );
+      inline Aabb( const Aabb<T>& rhs );
+
+      inline Aabb<T>& operator=( const Aabb<T>& rhs );
+
+      // Growing.
+      inline void    reset   ();
+      inline void    expand  ( const Vec3<T>& point );
+      inline void    expand  ( const Aabb<T>& box );
+      inline Aabb<T> merged  ( const Aabb<T>& box ) const;
+      inline Aabb<T> clipped ( const Aabb<T>& box ) const;
+
+      // Queries.
+      inline bool    isEmpty    () const;
+      inline bool    overlaps   ( const Aabb<T>& box ) const;
+      inline bool    contains   ( const Vec3<T>& point ) const;
+      inline bool    contains   ( const Aabb<T>& box ) const;
+      inline Vec3<T> center     () const;
+      inline Vec3<T> size       () const;
+      inline Vec3<T> halfSize   () const;
+      inline T       surfaceArea() const;
+      inline T       volume     () const;
+      inline int     longestAxis() const;
+
+      /**
+       * Transforms the box by an affine matrix and returns the box enclosing the result (Arvo's method).
+       * Transforms the center and accumulates the absolute matrix times the half size, rather than all eight corners.
+       * @param[in] mat Affine transformation.
+       * @return Box enclosing the transformed box.
+       */
+      inline Aabb<T> transformed( const Mat4<T>& mat ) const;
+
+    public:
+      Vec3<T> boundsMin;
+      Vec3<T> boundsMax;
+    };
+
+    /**
+     * Computes the bounds of a set of points.  Large inputs are split across threads, and each thread
+     * reduces four points per step into independent lanes so the min/max loop vectorizes.
+     * @param[in] points Points to bound; may be strided, e.g. positions inside an interleaved vertex buffer.
+     * @return Bounds of the points, or an empty box if there are none.
+     */
+    template<typename T>
+    inline Aabb<T> computeAabb( StridedSpan<const Vec3<T> > points );
+    template<typename T>
+    inline Aabb<T> computeAabb( const std::vector<Vec3<T> >& points );
+  } /* math */
+
+  // Typedefs.
+  typedef cc::math::Aabb<float>        Aabbf;
+  typedef cc::math::Aabb<double>       Aabbd;
+  typedef cc::math::Aabb<int>          Aabbi;
+
+} /* cc */
+
+#include "Aabb.inl"
+
+#endif /* __CC_MATH_AABB__ */
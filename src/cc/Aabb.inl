@@ -0,0 +1,241 @@
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "Aabb.hpp"
+#include "Parallel.hpp"
+
+namespace cc {
+  namespace math {
+    template<typename T>
+    inline Aabb<T>::Aabb()
+      : boundsMin(std::numeric_limits<T>::max()), boundsMax(std::numeric_limits<T>::lowest()) {
+    }
+
+    template<typename T>
+    inline Aabb<T>::Aabb( const Vec3<T>& boundsMin, const Vec3<T>& boundsMax )
+      : boundsMin(boundsMin), boundsMax(boundsMax) {
+    }
+
+    template<typename T>
+    inline Aabb<T>::Aabb( const Aabb<T>& rhs )
+      : boundsMin(rhs.boundsMin), boundsMax(rhs.boundsMax) {
+    }
+
+    template<typename T>
+    inline Aabb<T>& Aabb<T>::operator=( const Aabb<T>& rhs ) {
+      boundsMin = rhs.boundsMin;
+      boundsMax = rhs.boundsMax;
+      return *this;
+    }
+
+    template<typename T>
+    inline void Aabb<T>::reset() {
+      boundsMin = Vec3<T>(std::numeric_limits<T>::max());
+      boundsMax = Vec3<T>(std::numeric_limits<T>::lowest());
+    }
+
+    template<typename T>
+    inline void Aabb<T>::expand( const Vec3<T>& point ) {
+      boundsMin = boundsMin.minimum(point);
+      boundsMax = boundsMax.maximum(point);
+    }
+
+    template<typename T>
+    inline void Aabb<T>::expand( const Aabb<T>& box ) {
+      boundsMin = boundsMin.minimum(box.boundsMin);
+      boundsMax = boundsMax.maximum(box.boundsMax);
+    }
+
+    template<typename T>
+    inline Aabb<T> Aabb<T>::merged( const Aabb<T>& box ) const {
+      return Aabb<T>(boundsMin.minimum(box.boundsMin), boundsMax.maximum(box.boundsMax));
+    }
+
+    template<typename T>
+    inline Aabb<T> Aabb<T>::clipped( const Aabb<T>& box ) const {
+      // Disjoint boxes produce an inverted (empty) result.
+      return Aabb<T>(boundsMin.maximum(box.boundsMin), boundsMax.minimum(box.boundsMax));
+    }
+
+    template<typename T>
+    inline bool Aabb<T>::isEmpty() const {
+      return boundsMin.x > boundsMax.x || boundsMin.y > boundsMax.y || boundsMin.z > boundsMax.z;
+    }
+
+    template<typename T>
+    inline bool Aabb<T>::overlaps( const Aabb<T>& box ) const {
+      return (boundsMin.x <= box.boundsMax.x && boundsMax.x >= box.boundsMin.x) &&
+             (boundsMin.y <= box.boundsMax.y && boundsMax.y >= box.boundsMin.y) &&
+             (boundsMin.z <= box.boundsMax.z && boundsMax.z >= box.boundsMin.z);
+    }
+
+    template<typename T>
+    inline bool Aabb<T>::contains( const Vec3<T>& point ) const {
+      return (point.x >= boundsMin.x && point.x <= boundsMax.x) &&
+             (point.y >= boundsMin.y && point.y <= boundsMax.y) &&
+             (point.z >= boundsMin.z && point.z <= boundsMax.z);
+    }
+
+    template<typename T>
+    inline bool Aabb<T>::contains( const Aabb<T>& box ) const {
+      return (box.boundsMin.x >= boundsMin.x && box.boundsMax.x <= boundsMax.x) &&
+             (box.boundsMin.y >= boundsMin.y && box.boundsMax.y <= boundsMax.y) &&
+             (box.boundsMin.z >= boundsMin.z && box.boundsMax.z <= boundsMax.z);
+    }
+
+    template<typename T>
+    inline Vec3<T> Aabb<T>::center() const {
+      return (boundsMin + boundsMax) / static_cast<T>(2);
+    }
+
+    template<typename T>
+    inline Vec3<T> Aabb<T>::size() const {
+      return boundsMax - boundsMin;
+    }
+
+    template<typename T>
+    inline Vec3<T> Aabb<T>::halfSize() const {
+      return (boundsMax - boundsMin) / static_cast<T>(2);
+    }
+
+    template<typename T>
+    inline T Aabb<T>::surfaceArea() const {
+      if( isEmpty() ) {
+        return static_cast<T>(0);
+      }
+      const Vec3<T> e = size();
+      return static_cast<T>(2) * (e.x * e.y + e.y * e.z + e.z * e.x);
+    }
+
+    template<typename T>
+    inline T Aabb<T>::volume() const {
+      if( isEmpty() ) {
+        return static_cast<T>(0);
+      }
+      const Vec3<T> e = size();
+      return e.x * e.y * e.z;
+    }
+
+    template<typename T>
+    inline int Aabb<T>::longestAxis() const {
+      const Vec3<T> e = size();
+      if( e.x >= e.y && e.x >= e.z ) {
+        return 0;
+      }
+      return (e.y >= e.z) ? 1 : 2;
+    }
+
+    template<typename T>
+    inline Aabb<T> Aabb<T>::transformed( const Mat4<T>& mat ) const {
+      if( isEmpty() ) {
+        return Aabb<T>();
+      }
+
+      // Matrices are column-major: mat[column][row].
+      const Vec3<T> c = center();
+      const Vec3<T> h = halfSize();
+      Vec3<T> newCenter(mat[3][0], mat[3][1], mat[3][2]);
+      Vec3<T> newHalf(static_cast<T>(0));
+      for( unsigned int row = 0; row < 3; ++row ) {
+        for( unsigned int col = 0; col < 3; ++col ) {
+          const T m = mat[col][row];
+          newCenter[row] += m * c[col];
+          newHalf[row] += static_cast<T>(std::abs(m)) * h[col];
+        }
+      }
+      return Aabb<T>(newCenter - newHalf, newCenter + newHalf);
+    }
+
+    template<typename T>
+    inline bool operator==( const Aabb<T>& lhs, const Aabb<T>& rhs ) {
+      return lhs.boundsMin.equalTo(rhs.boundsMin) && lhs.boundsMax.equalTo(rhs.boundsMax);
+    }
+
+    template<typename T>
+    inline std::ostream& operator<<( std::ostream& os, const Aabb<T>& rhs ) {
+      os << "Min: " << rhs.boundsMin << "Max: " << rhs.boundsMax;
+      return os;
+    }
+
+    template<typename T>
+    inline Aabb<T> computeAabb( StridedSpan<const Vec3<T> > points ) {
+      // Vec3 is three packed T, so contiguous points can be walked as a flat array.
+      static_assert(sizeof(Vec3<T>) == sizeof(T) * 3, "Vec3 must be tightly packed");
+
+      struct Local {
+        enum { LANES = 12 }; // Four points of three components.
+
+        static inline void update( const T* p, T* lo, T* hi ) {
+          for( unsigned int k = 0; k < LANES; ++k ) {
+            lo[k] = (p[k] < lo[k]) ? p[k] : lo[k];
+            hi[k] = (p[k] > hi[k]) ? p[k] : hi[k];
+          }
+        }
+
+        static inline Aabb<T> reduce( const StridedSpan<const Vec3<T> >& points, std::size_t begin, std::size_t end ) {
+          T lo[LANES];
+          T hi[LANES];
+          for( unsigned int k = 0; k < LANES; ++k ) {
+            lo[k] = std::numeric_limits<T>::max();
+            hi[k] = std::numeric_limits<T>::lowest();
+          }
+
+          // Independent lanes with no data-dependent branches; compilers turn this into packed min/max.
+          // Strided input is gathered four points at a time into the same lane layout.
+          const std::size_t blocks = (end - begin) / 4;
+          if( points.isContiguous() ) {
+            const T* const data = &points[begin].x;
+            for( std::size_t b = 0; b < blocks; ++b ) {
+              update(data + b * LANES, lo, hi);
+            }
+          } else {
+            T gathered[LANES];
+            for( std::size_t b = 0; b < blocks; ++b ) {
+              for( unsigned int j = 0; j < 4; ++j ) {
+                const Vec3<T>& p = points[begin + b * 4 + j];
+                gathered[j * 3 + 0] = p.x;
+                gathered[j * 3 + 1] = p.y;
+                gathered[j * 3 + 2] = p.z;
+              }
+              update(gathered, lo, hi);
+            }
+          }
+          for( std::size_t i = begin + blocks * 4; i < end; ++i ) {
+            for( unsigned int k = 0; k < 3; ++k ) {
+              const T v = points[i][k];
+              lo[k] = (v < lo[k]) ? v : lo[k];
+              hi[k] = (v > hi[k]) ? v : hi[k];
+            }
+          }
+
+          Aabb<T> result;
+          for( unsigned int k = 0; k < LANES; ++k ) {
+            result.boundsMin[k % 3] = (lo[k] < result.boundsMin[k % 3]) ? lo[k] : result.boundsMin[k % 3];
+            result.boundsMax[k % 3] = (hi[k] > result.boundsMax[k % 3]) ? hi[k] : result.boundsMax[k % 3];
+          }
+          return result;
+        }
+      };
+
+      if( points.empty() ) {
+        return Aabb<T>();
+      }
+
+      std::vector<Aabb<T> > partial(parallelThreadCount());
+      const unsigned int chunks = parallelFor(points.size(), 1 << 16, [&]( std::size_t begin, std::size_t end, unsigned int chunk ) {
+        partial[chunk] = Local::reduce(points, begin, end);
+      });
+
+      Aabb<T> result;
+      for( unsigned int i = 0; i < chunks; ++i ) {
+        result.expand(partial[i]);
+      }
+      return result;
+    }
+
+    template<typename T>
+    inline Aabb<T> computeAabb( const std::vector<Vec3<T> >& points ) {
+      return computeAabb(StridedSpan<const Vec3<T> >(points));
+    }
+  } /* math */
+} /* cc */
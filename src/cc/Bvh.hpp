@@ -0,0 +1,146 @@
+#ifndef __CC_MATH_BVH__
+#define __CC_MATH_BVH__
+
+#include <vector>
+#include "Vec3.hpp"
+#include "StridedSpan.hpp"
+
+namespace cc {
+  namespace math {
+    /**
+     * A single node of a Bvh.  With float this packs into 32 bytes, so two siblings share a cache line.
+     * Interior nodes store the index of their first child in leftFirst; the second child always follows it.
+     * Leaves store the index of their first triangle in leftFirst and a non-zero triCount.
+     */
+    template<typename T>
+    struct BvhNode {
+      Vec3<T>      boundsMin;
+      unsigned int leftFirst;
+      Vec3<T>      boundsMax;
+      unsigned int triCount;
+
+      inline bool isLeaf() const { return triCount > 0; }
+    };
+
+    /**
+     * Result of a ray query against a Bvh.
+     */
+    template<typename T>
+    struct BvhRayHit {
+      T            t;        /**< Distance along the ray in multiples of its direction. */
+      T            u;        /**< Barycentric weight of the triangle's second vertex. */
+      T            v;        /**< Barycentric weight of the triangle's third vertex. */
+      unsigned int triangle; /**< Index of the triangle in the source index buffer (first index / 3). */
+    };
+
+    /**
+     * Result of a closest point query against a Bvh.
+     */
+    template<typename T>
+    struct BvhClosestPoint {
+      Vec3<T>      position;    /**< Closest point on the mesh. */
+      Vec3<T>      barycentric; /**< Weights of the triangle's three vertices at position. */
+      T            sqrDistance; /**< Squared distance from the query point to position. */
+      unsigned int triangle;    /**< Index of the triangle in the source index buffer (first index / 3). */
+      bool         found;       /**< False if nothing was within the query distance; the other members are then undefined. */
+    };
+
+    // Bounding volume hierarchy over an indexed triangle mesh, built with a binned SAH.
+    template<typename T>
+    class Bvh {
+    public:
+      inline Bvh();
+
+      /**
+       * Builds the hierarchy.  Large subtrees are built in parallel across all hardware threads.
+       * The triangles are copied into the hierarchy in leaf order, so the source buffers may be freed afterwards.
+       * @param[in] positions   Vertex positions; may be strided, e.g. inside an interleaved vertex buffer.
+       * @param[in] indices     Triangle list; three indices into positions per triangle.
+       * @param[in] maxLeafSize Maximum number of triangles in a leaf.
+       */
+      inline void build( StridedSpan<const Vec3<T> > positions, const std::vector<unsigned int>& indices, unsigned int maxLeafSize=4 );
+      inline void build( const std::vector<Vec3<T> >& positions, const std::vector<unsigned int>& indices, unsigned int maxLeafSize=4 );
+      inline void clear();
+
+      /**
+       * Finds the nearest triangle hit by a ray.
+       * @param[in]  origin    Origin of the ray.
+       * @param[in]  direction Direction of the ray (need not be normalized).
+       * @param[in]  maxT      Hits further than this (in multiples of direction) are ignored.
+       * @param[out] outHit    Nearest hit.  Only written when something is hit.
+       * @return True if any triangle was hit; false otherwise.
+       */
+      inline bool intersectRay( const Vec3<T>& origin, const Vec3<T>& direction, T maxT, BvhRayHit<T>* outHit ) const;
+
+      /**
+       * Tests if a ray hits any triangle, stopping at the first hit found.
+       * @param[in] origin    Origin of the ray.
+       * @param[in] direction Direction of the ray (need not be normalized).
+       * @param[in] maxT      Hits further than this (in multiples of direction) are ignored.
+       * @return True if any triangle was hit; false otherwise.
+       */
+      inline bool occluded( const Vec3<T>& origin, const Vec3<T>& direction, T maxT ) const;
+
+      /**
+       * Finds the closest point on the mesh to a given point.
+       * @param[in]  point       Point to test from.
+       * @param[in]  maxDistance Only points closer than this are considered.
+       * @param[out] outPos      Closest point on the mesh.  Optional.
+       * @param[out] outTriangle Source index of the triangle the point lies on.  Optional.
+       * @return True if a point within maxDistance was found; false otherwise.
+       */
+      inline bool closestPoint( const Vec3<T>& point, T maxDistance, Vec3<T>* outPos, unsigned int* outTriangle ) const;
+
+      /**
+       * Finds the closest point on the mesh to a given point, along with its triangle and barycentric coordinates.
+       * @param[in]  point       Point to test from.
+       * @param[in]  maxDistance Only points closer than this are considered.
+       * @param[out] outResult   Closest point.  Its found member is always written.
+       * @return True if a point within maxDistance was found; false otherwise.
+       */
+      inline bool closestPoint( const Vec3<T>& point, T maxDistance, BvhClosestPoint<T>* outResult ) const;
+
+      /**
+       * Finds the closest point on the mesh for many points at once.
+       * Queries are reordered along a Morton curve and split across threads.  Each query starts from the
+       * distance to the previous query's triangle, so nearby points prune most of the tree immediately.
+       * @param[in]  points      Points to test from; may be strided.
+       * @param[in]  maxDistance Only points closer than this are considered.
+       * @param[out] outResults  One result per point, in the same order as points.
+       * @return Number of points for which a closest point was found.
+       */
+      inline unsigned int closestPoints( StridedSpan<const Vec3<T> > points, T maxDistance, std::vector<BvhClosestPoint<T> >* outResults ) const;
+      inline unsigned int closestPoints( const std::vector<Vec3<T> >& points, T maxDistance, std::vector<BvhClosestPoint<T> >* outResults ) const;
+
+      inline bool                            empty        () const;
+      inline unsigned int                    triangleCount() const;
+      inline unsigned int                    nodeCount    () const;
+      inline unsigned int                    depth        () const;
+      inline const std::vector<BvhNode<T> >& nodes        () const;
+
+    private:
+      struct BuildContext;
+      struct TraversalStack;
+
+      inline void subdivide        ( BuildContext& ctx, unsigned int nodeIdx, unsigned int depth );
+      inline T    rayNodeEntry     ( const BvhNode<T>& node, const Vec3<T>& origin, const Vec3<T>& invDir, T maxT ) const;
+      inline T    sqrDistanceToNode( const BvhNode<T>& node, const Vec3<T>& point ) const;
+      inline bool closestPointFrom ( const Vec3<T>& point, T maxSqrDistance, unsigned int hint, BvhClosestPoint<T>* outResult, unsigned int* outLeafTriangle ) const;
+
+    private:
+      std::vector<BvhNode<T> >  _nodes;
+      std::vector<Vec3<T> >     _vertices;  // Three per triangle, in leaf order.
+      std::vector<unsigned int> _triangles; // Leaf order to source triangle index.
+      unsigned int              _depth;
+    };
+  } /* math */
+
+  // Typedefs.
+  typedef cc::math::Bvh<float>  Bvhf;
+  typedef cc::math::Bvh<double> Bvhd;
+
+} /* cc */
+
+#include "Bvh.inl"
+
+#endif /* __CC_MATH_BVH__ */
@@ -0,0 +1,648 @@
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <limits>
+#include <thread>
+#include <utility>
+#include "Bvh.hpp"
+#include "ClosestPoint.hpp"
+#include "Intersection.hpp"
+#include "Parallel.hpp"
+
+namespace cc {
+  namespace math {
+    template<typename T>
+    struct Bvh<T>::BuildContext {
+      static const unsigned int BINS = 16;
+      static const unsigned int PARALLEL_MIN_TRIANGLES = 8192;
+
+      struct Bin {
+        Vec3<T>      boundsMin;
+        Vec3<T>      boundsMax;
+        unsigned int count;
+      };
+
+      // Build-time record of a triangle.  Records are partitioned in place so every node's triangles stay contiguous.
+      struct Triangle {
+        Vec3<T>      boundsMin;
+        Vec3<T>      boundsMax;
+        Vec3<T>      centroid;
+        unsigned int index;
+      };
+
+      std::vector<Triangle>      triangles;
+      std::atomic<unsigned int>  nodesUsed;
+      std::atomic<unsigned int>  maxDepth;
+      unsigned int               maxLeafSize;
+      unsigned int               spawnDepth;
+
+      static inline T halfArea( const Vec3<T>& bmin, const Vec3<T>& bmax ) {
+        const Vec3<T> e = bmax - bmin;
+        return e.x * e.y + e.y * e.z + e.z * e.x;
+      }
+
+      static inline void resetBin( Bin& bin ) {
+        bin.boundsMin = Vec3<T>(std::numeric_limits<T>::max());
+        bin.boundsMax = Vec3<T>(-std::numeric_limits<T>::max());
+        bin.count = 0;
+      }
+
+      static inline void growBin( Bin& bin, const Bin& other ) {
+        bin.boundsMin = bin.boundsMin.minimum(other.boundsMin);
+        bin.boundsMax = bin.boundsMax.maximum(other.boundsMax);
+        bin.count += other.count;
+      }
+
+      // Bounds of the triangles (and of their centroids) in triangles[first+begin, first+end).
+      inline void accumulateBounds( unsigned int first, std::size_t begin, std::size_t end, Bin& outBounds, Bin& outCentroids ) const {
+        for( std::size_t i = begin; i < end; ++i ) {
+          const Triangle& tri = triangles[first + i];
+          outBounds.boundsMin = outBounds.boundsMin.minimum(tri.boundsMin);
+          outBounds.boundsMax = outBounds.boundsMax.maximum(tri.boundsMax);
+          outCentroids.boundsMin = outCentroids.boundsMin.minimum(tri.centroid);
+          outCentroids.boundsMax = outCentroids.boundsMax.maximum(tri.centroid);
+        }
+      }
+
+      inline void computeBounds( unsigned int first, unsigned int count, bool parallel, Bin& outBounds, Bin& outCentroids ) const {
+        resetBin(outBounds);
+        resetBin(outCentroids);
+        if( !parallel ) {
+          accumulateBounds(first, 0, count, outBounds, outCentroids);
+          return;
+        }
+
+        std::vector<Bin> partial(parallelThreadCount() * 2);
+        for( unsigned int i = 0; i < partial.size(); ++i ) {
+          resetBin(partial[i]);
+        }
+        const unsigned int used = parallelFor(count, PARALLEL_MIN_TRIANGLES, [&]( std::size_t begin, std::size_t end, unsigned int chunk ) {
+          accumulateBounds(first, begin, end, partial[chunk * 2], partial[chunk * 2 + 1]);
+        });
+        for( unsigned int i = 0; i < used; ++i ) {
+          growBin(outBounds, partial[i * 2]);
+          growBin(outCentroids, partial[i * 2 + 1]);
+        }
+      }
+
+      static inline unsigned int binIndex( T value, T cmin, T scale ) {
+        const int bin = static_cast<int>((value - cmin) * scale);
+        return static_cast<unsigned int>((bin < 0) ? 0 : ((bin >= static_cast<int>(BINS)) ? BINS - 1 : bin));
+      }
+
+      // Bins the triangles in triangles[first+begin, first+end) along all three axes at once.
+      inline void accumulateBins( unsigned int first, std::size_t begin, std::size_t end, const Vec3<T>& cmin, const Vec3<T>& scale, Bin* outBins ) const {
+        for( std::size_t i = begin; i < end; ++i ) {
+          const Triangle& tri = triangles[first + i];
+          for( unsigned int axis = 0; axis < 3; ++axis ) {
+            Bin& bin = outBins[axis * BINS + binIndex(tri.centroid[axis], cmin[axis], scale[axis])];
+            bin.boundsMin = bin.boundsMin.minimum(tri.boundsMin);
+            bin.boundsMax = bin.boundsMax.maximum(tri.boundsMax);
+            bin.count += 1;
+          }
+        }
+      }
+
+      inline void binTriangles( unsigned int first, unsigned int count, bool parallel, const Vec3<T>& cmin, const Vec3<T>& scale, Bin (&outBins)[3][BINS] ) const {
+        for( unsigned int axis = 0; axis < 3; ++axis ) {
+          for( unsigned int b = 0; b < BINS; ++b ) {
+            resetBin(outBins[axis][b]);
+          }
+        }
+        if( !parallel ) {
+          accumulateBins(first, 0, count, cmin, scale, &outBins[0][0]);
+          return;
+        }
+
+        std::vector<Bin> partial(parallelThreadCount() * 3 * BINS);
+        for( unsigned int i = 0; i < partial.size(); ++i ) {
+          resetBin(partial[i]);
+        }
+        const unsigned int used = parallelFor(count, PARALLEL_MIN_TRIANGLES, [&]( std::size_t begin, std::size_t end, unsigned int chunk ) {
+          accumulateBins(first, begin, end, cmin, scale, &partial[chunk * 3 * BINS]);
+        });
+        for( unsigned int chunk = 0; chunk < used; ++chunk ) {
+          for( unsigned int b = 0; b < 3 * BINS; ++b ) {
+            growBin(outBins[b / BINS][b % BINS], partial[chunk * 3 * BINS + b]);
+          }
+        }
+      }
+    };
+
+    template<typename T>
+    inline Bvh<T>::Bvh()
+      : _depth(0) {
+    }
+
+    template<typename T>
+    inline void Bvh<T>::build( const std::vector<Vec3<T> >& positions, const std::vector<unsigned int>& indices, unsigned int maxLeafSize ) {
+      build(StridedSpan<const Vec3<T> >(positions), indices, maxLeafSize);
+    }
+
+    template<typename T>
+    inline void Bvh<T>::build( StridedSpan<const Vec3<T> > positions, const std::vector<unsigned int>& indices, unsigned int maxLeafSize ) {
+      assert(indices.size() % 3 == 0);
+      clear();
+
+      const unsigned int triCount = static_cast<unsigned int>(indices.size() / 3);
+      if( triCount == 0 ) {
+        return;
+      }
+
+      BuildContext ctx;
+      ctx.triangles.resize(triCount);
+      ctx.maxLeafSize = (maxLeafSize == 0) ? 1 : maxLeafSize;
+      ctx.nodesUsed = 1;
+      ctx.maxDepth = 0;
+      // Enough levels of task splitting to give every thread a subtree.
+      ctx.spawnDepth = 0;
+      while( (1u << ctx.spawnDepth) < parallelThreadCount() ) {
+        ++ctx.spawnDepth;
+      }
+
+      parallelFor(triCount, BuildContext::PARALLEL_MIN_TRIANGLES, [&]( std::size_t begin, std::size_t end, unsigned int ) {
+        const T third = static_cast<T>(1) / static_cast<T>(3);
+        for( std::size_t i = begin; i < end; ++i ) {
+          const Vec3<T>& a = positions[indices[i * 3 + 0]];
+          const Vec3<T>& b = positions[indices[i * 3 + 1]];
+          const Vec3<T>& c = positions[indices[i * 3 + 2]];
+          typename BuildContext::Triangle& tri = ctx.triangles[i];
+          tri.boundsMin = a.minimum(b).minimum(c);
+          tri.boundsMax = a.maximum(b).maximum(c);
+          tri.centroid = (a + b + c) * third;
+          tri.index = static_cast<unsigned int>(i);
+        }
+      });
+
+      // A binary tree with n leaves has at most 2n-1 nodes; children are allocated in pairs after the root.
+      _nodes.resize(triCount * 2);
+      BvhNode<T>& root = _nodes[0];
+      root.leftFirst = 0;
+      root.triCount = triCount;
+      subdivide(ctx, 0, 0);
+      _nodes.resize(ctx.nodesUsed);
+      _depth = ctx.maxDepth;
+
+      // Copy the triangles in leaf order so traversal reads them sequentially.
+      _vertices.resize(triCount * 3);
+      _triangles.resize(triCount);
+      parallelFor(triCount, BuildContext::PARALLEL_MIN_TRIANGLES, [&]( std::size_t begin, std::size_t end, unsigned int ) {
+        for( std::size_t i = begin; i < end; ++i ) {
+          const unsigned int tri = ctx.triangles[i].index;
+          _triangles[i] = tri;
+          _vertices[i * 3 + 0] = positions[indices[tri * 3 + 0]];
+          _vertices[i * 3 + 1] = positions[indices[tri * 3 + 1]];
+          _vertices[i * 3 + 2] = positions[indices[tri * 3 + 2]];
+        }
+      });
+    }
+
+    template<typename T>
+    inline void Bvh<T>::clear() {
+      _nodes.clear();
+      _vertices.clear();
+      _triangles.clear();
+      _depth = 0;
+    }
+
+    template<typename T>
+    inline void Bvh<T>::subdivide( BuildContext& ctx, unsigned int nodeIdx, unsigned int depth ) {
+      typedef typename BuildContext::Bin Bin;
+      const unsigned int BINS = BuildContext::BINS;
+
+      unsigned int prevDepth = ctx.maxDepth.load();
+      while( depth > prevDepth && !ctx.maxDepth.compare_exchange_weak(prevDepth, depth) ) {
+      }
+
+      BvhNode<T>& node = _nodes[nodeIdx];
+      const unsigned int first = node.leftFirst;
+      const unsigned int count = node.triCount;
+      const bool parallel = (depth == 0) && (count >= BuildContext::PARALLEL_MIN_TRIANGLES);
+
+      Bin bounds, centroidBounds;
+      ctx.computeBounds(first, count, parallel, bounds, centroidBounds);
+      node.boundsMin = bounds.boundsMin;
+      node.boundsMax = bounds.boundsMax;
+      if( count <= 1 ) {
+        return;
+      }
+
+      // Find the cheapest SAH split over all three axes.
+      const Vec3<T> extent = centroidBounds.boundsMax - centroidBounds.boundsMin;
+      int bestAxis = -1;
+      unsigned int bestSplit = 0;
+      T bestCost = std::numeric_limits<T>::max();
+      if( extent.x > static_cast<T>(0) || extent.y > static_cast<T>(0) || extent.z > static_cast<T>(0) ) {
+        Vec3<T> scale;
+        for( unsigned int axis = 0; axis < 3; ++axis ) {
+          scale[axis] = (extent[axis] > static_cast<T>(0)) ? static_cast<T>(BINS) / extent[axis] : static_cast<T>(0);
+        }
+
+        Bin bins[3][BuildContext::BINS];
+        ctx.binTriangles(first, count, parallel, centroidBounds.boundsMin, scale, bins);
+
+        for( unsigned int axis = 0; axis < 3; ++axis ) {
+          if( extent[axis] <= static_cast<T>(0) ) {
+            continue;
+          }
+          T leftArea[BuildContext::BINS - 1];
+          unsigned int leftCount[BuildContext::BINS - 1];
+          Bin left; BuildContext::resetBin(left);
+          for( unsigned int i = 0; i < BINS - 1; ++i ) {
+            BuildContext::growBin(left, bins[axis][i]);
+            leftCount[i] = left.count;
+            leftArea[i] = (left.count > 0) ? BuildContext::halfArea(left.boundsMin, left.boundsMax) : static_cast<T>(0);
+          }
+          Bin right; BuildContext::resetBin(right);
+          for( unsigned int i = BINS - 1; i > 0; --i ) {
+            BuildContext::growBin(right, bins[axis][i]);
+            if( leftCount[i - 1] == 0 || right.count == 0 ) {
+              continue;
+            }
+            const T cost = static_cast<T>(leftCount[i - 1]) * leftArea[i - 1] + static_cast<T>(right.count) * BuildContext::halfArea(right.boundsMin, right.boundsMax);
+            if( cost < bestCost ) {
+              bestCost = cost;
+              bestAxis = static_cast<int>(axis);
+              bestSplit = i;
+            }
+          }
+        }
+      }
+
+      // Small nodes only split when the SAH says traversing two children is cheaper than intersecting every triangle.
+      if( count <= ctx.maxLeafSize ) {
+        const T nodeArea = BuildContext::halfArea(node.boundsMin, node.boundsMax);
+        if( bestAxis < 0 || nodeArea + bestCost >= static_cast<T>(count) * nodeArea ) {
+          return;
+        }
+      }
+
+      typedef typename BuildContext::Triangle Triangle;
+      Triangle* const begin = &ctx.triangles[first];
+      Triangle* const end = begin + count;
+      Triangle* mid = begin + count / 2;
+      if( bestAxis >= 0 ) {
+        const unsigned int axis = static_cast<unsigned int>(bestAxis);
+        const T cmin = centroidBounds.boundsMin[axis];
+        const T scale = static_cast<T>(BINS) / extent[axis];
+        mid = std::partition(begin, end, [&]( const Triangle& tri ) {
+          return BuildContext::binIndex(tri.centroid[axis], cmin, scale) < bestSplit;
+        });
+      }
+      // Coincident centroids can't be separated by binning; fall back to an even split.
+      if( mid == begin || mid == end ) {
+        mid = begin + count / 2;
+      }
+      const unsigned int leftCount = static_cast<unsigned int>(mid - begin);
+
+      const unsigned int leftIdx = ctx.nodesUsed.fetch_add(2);
+      _nodes[leftIdx].leftFirst = first;
+      _nodes[leftIdx].triCount = leftCount;
+      _nodes[leftIdx + 1].leftFirst = first + leftCount;
+      _nodes[leftIdx + 1].triCount = count - leftCount;
+      node.leftFirst = leftIdx;
+      node.triCount = 0;
+
+      if( depth < ctx.spawnDepth && count >= BuildContext::PARALLEL_MIN_TRIANGLES ) {
+        std::thread worker([&ctx, this, leftIdx, depth]() { subdivide(ctx, leftIdx, depth + 1); });
+        subdivide(ctx, leftIdx + 1, depth + 1);
+        worker.join();
+      } else {
+        subdivide(ctx, leftIdx, depth + 1);
+        subdivide(ctx, leftIdx + 1, depth + 1);
+      }
+    }
+
+    template<typename T>
+    inline T Bvh<T>::rayNodeEntry( const BvhNode<T>& node, const Vec3<T>& origin, const Vec3<T>& invDir, T maxT ) const {
+      const T tx1 = (node.boundsMin.x - origin.x) * invDir.x;
+      const T tx2 = (node.boundsMax.x - origin.x) * invDir.x;
+      const T ty1 = (node.boundsMin.y - origin.y) * invDir.y;
+      const T ty2 = (node.boundsMax.y - origin.y) * invDir.y;
+      const T tz1 = (node.boundsMin.z - origin.z) * invDir.z;
+      const T tz2 = (node.boundsMax.z - origin.z) * invDir.z;
+      const T tmin = std::max(std::max(std::min(tx1, tx2), std::min(ty1, ty2)), std::min(tz1, tz2));
+      const T tmax = std::min(std::min(std::max(tx1, tx2), std::max(ty1, ty2)), std::max(tz1, tz2));
+      return (tmax >= tmin && tmin < maxT && tmax >= static_cast<T>(0)) ? tmin : std::numeric_limits<T>::max();
+    }
+
+    // Traversal stack of (node, entry distance) pairs; stays on the stack frame unless the tree is unusually deep.
+    template<typename T>
+    struct Bvh<T>::TraversalStack {
+      static const unsigned int LOCAL_SIZE = 64;
+
+      unsigned int              localNodes[LOCAL_SIZE];
+      T                         localDists[LOCAL_SIZE];
+      std::vector<unsigned int> heapNodes;
+      std::vector<T>            heapDists;
+      unsigned int*             nodes;
+      T*                        dists;
+      unsigned int              size;
+
+      // Each visited level adds at most one entry on top of the root.
+      explicit TraversalStack( unsigned int depth )
+        : nodes(localNodes), dists(localDists), size(0) {
+        if( depth + 2 > LOCAL_SIZE ) {
+          heapNodes.resize(depth + 2);
+          heapDists.resize(depth + 2);
+          nodes = &heapNodes[0];
+          dists = &heapDists[0];
+        }
+      }
+
+      inline void push( unsigned int node, T dist ) {
+        nodes[size] = node;
+        dists[size] = dist;
+        ++size;
+      }
+
+      // Pops the next node whose entry distance is below the limit.
+      inline bool pop( T limit, unsigned int* outNode ) {
+        while( size > 0 ) {
+          --size;
+          if( dists[size] < limit ) {
+            *outNode = nodes[size];
+            return true;
+          }
+        }
+        return false;
+      }
+    };
+
+    template<typename T>
+    inline bool Bvh<T>::intersectRay( const Vec3<T>& origin, const Vec3<T>& direction, T maxT, BvhRayHit<T>* outHit ) const {
+      if( _nodes.empty() ) {
+        return false;
+      }
+
+      const Vec3<T> invDir = static_cast<T>(1) / direction;
+      const T miss = std::numeric_limits<T>::max();
+      bool hit = false;
+      T bestT = maxT;
+      T bestU = static_cast<T>(0);
+      T bestV = static_cast<T>(0);
+      unsigned int bestTri = 0;
+
+      TraversalStack stack(_depth);
+      stack.push(0, rayNodeEntry(_nodes[0], origin, invDir, bestT));
+      unsigned int nodeIdx = 0;
+      while( stack.pop(bestT, &nodeIdx) ) {
+        const BvhNode<T>& node = _nodes[nodeIdx];
+        if( node.isLeaf() ) {
+          for( unsigned int i = node.leftFirst; i < node.leftFirst + node.triCount; ++i ) {
+            T t, u, v;
+            if( rayIntersectsTriangle(origin, direction, _vertices[i * 3], _vertices[i * 3 + 1], _vertices[i * 3 + 2], &t, &u, &v) && t < bestT ) {
+              hit = true;
+              bestT = t;
+              bestU = u;
+              bestV = v;
+              bestTri = i;
+            }
+          }
+          continue;
+        }
+
+        // Push the farther child first so the nearer one is visited next.
+        const unsigned int left = node.leftFirst;
+        const T leftT = rayNodeEntry(_nodes[left], origin, invDir, bestT);
+        const T rightT = rayNodeEntry(_nodes[left + 1], origin, invDir, bestT);
+        if( leftT <= rightT ) {
+          if( rightT != miss ) stack.push(left + 1, rightT);
+          if( leftT != miss ) stack.push(left, leftT);
+        } else {
+          if( leftT != miss ) stack.push(left, leftT);
+          stack.push(left + 1, rightT);
+        }
+      }
+
+      if( hit && outHit != nullptr ) {
+        outHit->t = bestT;
+        outHit->u = bestU;
+        outHit->v = bestV;
+        outHit->triangle = _triangles[bestTri];
+      }
+      return hit;
+    }
+
+    template<typename T>
+    inline bool Bvh<T>::occluded( const Vec3<T>& origin, const Vec3<T>& direction, T maxT ) const {
+      if( _nodes.empty() ) {
+        return false;
+      }
+
+      const Vec3<T> invDir = static_cast<T>(1) / direction;
+      TraversalStack stack(_depth);
+      stack.push(0, rayNodeEntry(_nodes[0], origin, invDir, maxT));
+      unsigned int nodeIdx = 0;
+      while( stack.pop(maxT, &nodeIdx) ) {
+        const BvhNode<T>& node = _nodes[nodeIdx];
+        if( node.isLeaf() ) {
+          for( unsigned int i = node.leftFirst; i < node.leftFirst + node.triCount; ++i ) {
+            T t;
+            if( rayIntersectsTriangle(origin, direction, _vertices[i * 3], _vertices[i * 3 + 1], _vertices[i * 3 + 2], &t, static_cast<T*>(nullptr), static_cast<T*>(nullptr)) && t < maxT ) {
+              return true;
+            }
+          }
+          continue;
+        }
+        stack.push(node.leftFirst + 1, rayNodeEntry(_nodes[node.leftFirst + 1], origin, invDir, maxT));
+        stack.push(node.leftFirst, rayNodeEntry(_nodes[node.leftFirst], origin, invDir, maxT));
+      }
+      return false;
+    }
+
+    template<typename T>
+    inline T Bvh<T>::sqrDistanceToNode( const BvhNode<T>& node, const Vec3<T>& point ) const {
+      // Zero when the point is inside the box.
+      const Vec3<T> d = (node.boundsMin - point).maximum(point - node.boundsMax).maximum(Vec3<T>(static_cast<T>(0)));
+      return d.sqrMagnitude();
+    }
+
+    template<typename T>
+    inline bool Bvh<T>::closestPointFrom( const Vec3<T>& point, T maxSqrDistance, unsigned int hint, BvhClosestPoint<T>* outResult, unsigned int* outLeafTriangle ) const {
+      BvhClosestPoint<T>& best = *outResult;
+      best.found = false;
+      best.sqrDistance = maxSqrDistance;
+      unsigned int bestTri = 0;
+      if( _nodes.empty() ) {
+        return false;
+      }
+
+      // A triangle known to be near (typically the previous query's answer) gives an upper bound before traversal starts.
+      if( hint < _triangles.size() ) {
+        Vec3<T> bary;
+        const Vec3<T> q = closestPointOnTriangle(point, _vertices[hint * 3], _vertices[hint * 3 + 1], _vertices[hint * 3 + 2], &bary);
+        const T dist2 = q.sqrDistance(point);
+        if( dist2 < best.sqrDistance ) {
+          best.found = true;
+          best.sqrDistance = dist2;
+          best.position = q;
+          best.barycentric = bary;
+          bestTri = hint;
+        }
+      }
+
+      TraversalStack stack(_depth);
+      stack.push(0, sqrDistanceToNode(_nodes[0], point));
+      unsigned int nodeIdx = 0;
+      while( stack.pop(best.sqrDistance, &nodeIdx) ) {
+        const BvhNode<T>& node = _nodes[nodeIdx];
+        if( node.isLeaf() ) {
+          for( unsigned int i = node.leftFirst; i < node.leftFirst + node.triCount; ++i ) {
+            Vec3<T> bary;
+            const Vec3<T> q = closestPointOnTriangle(point, _vertices[i * 3], _vertices[i * 3 + 1], _vertices[i * 3 + 2], &bary);
+            const T dist2 = q.sqrDistance(point);
+            if( dist2 < best.sqrDistance ) {
+              best.found = true;
+              best.sqrDistance = dist2;
+              best.position = q;
+              best.barycentric = bary;
+              bestTri = i;
+            }
+          }
+          continue;
+        }
+
+        // Descend into the nearer child first; the bound on the stack lets the other be skipped later.
+        const unsigned int left = node.leftFirst;
+        const T leftD = sqrDistanceToNode(_nodes[left], point);
+        const T rightD = sqrDistanceToNode(_nodes[left + 1], point);
+        if( leftD <= rightD ) {
+          stack.push(left + 1, rightD);
+          stack.push(left, leftD);
+        } else {
+          stack.push(left, leftD);
+          stack.push(left + 1, rightD);
+        }
+      }
+
+      if( best.found ) {
+        best.triangle = _triangles[bestTri];
+        if( outLeafTriangle != nullptr ) {
+          *outLeafTriangle = bestTri;
+        }
+      }
+      return best.found;
+    }
+
+    template<typename T>
+    inline bool Bvh<T>::closestPoint( const Vec3<T>& point, T maxDistance, Vec3<T>* outPos, unsigned int* outTriangle ) const {
+      BvhClosestPoint<T> result;
+      if( !closestPointFrom(point, maxDistance * maxDistance, ~0u, &result, nullptr) ) {
+        return false;
+      }
+      if( outPos != nullptr ) {
+        *outPos = result.position;
+      }
+      if( outTriangle != nullptr ) {
+        *outTriangle = result.triangle;
+      }
+      return true;
+    }
+
+    template<typename T>
+    inline bool Bvh<T>::closestPoint( const Vec3<T>& point, T maxDistance, BvhClosestPoint<T>* outResult ) const {
+      if( outResult == nullptr ) {
+        return false;
+      }
+      return closestPointFrom(point, maxDistance * maxDistance, ~0u, outResult, nullptr);
+    }
+
+    template<typename T>
+    inline unsigned int Bvh<T>::closestPoints( const std::vector<Vec3<T> >& points, T maxDistance, std::vector<BvhClosestPoint<T> >* outResults ) const {
+      return closestPoints(StridedSpan<const Vec3<T> >(points), maxDistance, outResults);
+    }
+
+    template<typename T>
+    inline unsigned int Bvh<T>::closestPoints( StridedSpan<const Vec3<T> > points, T maxDistance, std::vector<BvhClosestPoint<T> >* outResults ) const {
+      if( outResults == nullptr ) {
+        return 0;
+      }
+      outResults->resize(points.size());
+      if( points.empty() ) {
+        return 0;
+      }
+
+      // Spreads the low 10 bits of v so there are two zero bits between each.
+      struct Morton {
+        static inline unsigned int expandBits( unsigned int v ) {
+          v = (v * 0x00010001u) & 0xFF0000FFu;
+          v = (v * 0x00000101u) & 0x0F00F00Fu;
+          v = (v * 0x00000011u) & 0xC30C30C3u;
+          v = (v * 0x00000005u) & 0x49249249u;
+          return v;
+        }
+      };
+
+      // Sort the queries along a Morton curve over their bounds so consecutive queries are spatially close.
+      Vec3<T> qmin(std::numeric_limits<T>::max());
+      Vec3<T> qmax(-std::numeric_limits<T>::max());
+      for( std::size_t i = 0; i < points.size(); ++i ) {
+        qmin = qmin.minimum(points[i]);
+        qmax = qmax.maximum(points[i]);
+      }
+      const Vec3<T> extent = qmax - qmin;
+      Vec3<T> scale;
+      for( unsigned int axis = 0; axis < 3; ++axis ) {
+        scale[axis] = (extent[axis] > static_cast<T>(0)) ? static_cast<T>(1023) / extent[axis] : static_cast<T>(0);
+      }
+      std::vector<std::pair<unsigned int, unsigned int> > order(points.size());
+      parallelFor(points.size(), 4096, [&]( std::size_t begin, std::size_t end, unsigned int ) {
+        for( std::size_t i = begin; i < end; ++i ) {
+          const Vec3<T> q = (points[i] - qmin) * scale;
+          const unsigned int code = (Morton::expandBits(static_cast<unsigned int>(q.x)) << 2) |
+                                    (Morton::expandBits(static_cast<unsigned int>(q.y)) << 1) |
+                                     Morton::expandBits(static_cast<unsigned int>(q.z));
+          order[i] = std::make_pair(code, static_cast<unsigned int>(i));
+        }
+      });
+      std::sort(order.begin(), order.end());
+
+      const T maxSqrDistance = maxDistance * maxDistance;
+      std::vector<BvhClosestPoint<T> >& results = *outResults;
+      std::vector<unsigned int> foundPerChunk(parallelThreadCount(), 0);
+      const unsigned int chunks = parallelFor(order.size(), 1024, [&]( std::size_t begin, std::size_t end, unsigned int chunk ) {
+        unsigned int hint = ~0u;
+        unsigned int found = 0;
+        for( std::size_t i = begin; i < end; ++i ) {
+          const unsigned int idx = order[i].second;
+          if( closestPointFrom(points[idx], maxSqrDistance, hint, &results[idx], &hint) ) {
+            ++found;
+          }
+        }
+        foundPerChunk[chunk] = found;
+      });
+
+      unsigned int found = 0;
+      for( unsigned int i = 0; i < chunks; ++i ) {
+        found += foundPerChunk[i];
+      }
+      return found;
+    }
+
+    template<typename T>
+    inline bool Bvh<T>::empty() const {
+      return _nodes.empty();
+    }
+
+    template<typename T>
+    inline unsigned int Bvh<T>::triangleCount() const {
+      return static_cast<unsigned int>(_triangles.size());
+    }
+
+    template<typename T>
+    inline unsigned int Bvh<T>::nodeCount() const {
+      return static_cast<unsigned int>(_nodes.size());
+    }
+
+    template<typename T>
+    inline unsigned int Bvh<T>::depth() const {
+      return _depth;
+    }
+
+    template<typename T>
+    inline const std::vector<BvhNode<T> >& Bvh<T>::nodes() const {
+      return _nodes;
+    }
+  } /* math */
+} /* cc */
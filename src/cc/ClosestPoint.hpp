@@ -1,70 +1,141 @@
 #ifndef __CC_MATH_CLOSESTPOINT__
 #define	__CC_MATH_CLOSESTPOINT__
 
+#include "Common.hpp"
+#include "Constants.hpp"
 #include "Vec3.hpp"
+#include "Vec3Soa.hpp"
 
 namespace cc {
   namespace math {
     /**
-     * Compute the closes point on a triangle.
-     * @param[in] p  The point to test from.
-     * @param[in] t0 The first vertex of the triangle.
-     * @param[in] t1 The second vertex of the triangle.
-     * @param[in] t2 The third vertex of the triangle.
+     * Compute the closest point on a triangle and its barycentric coordinates.
+     * @param[in]  p              The point to test from.
+     * @param[in]  t0             The first vertex of the triangle.
+     * @param[in]  t1             The second vertex of the triangle.
+     * @param[in]  t2             The third vertex of the triangle.
+     * @param[out] outBarycentric Weights of t0, t1 and t2 at the closest point.  Optional.
      * @return The position of the closest point on the triangle.
      */
     template<typename T>
-    inline Vec3<T> closestPointOnTriangle( const Vec3<T>& p, const Vec3<T>& t0, const Vec3<T>& t1, const Vec3<T>& t2 ) {
+    inline Vec3<T> closestPointOnTriangle( const Vec3<T>& p, const Vec3<T>& t0, const Vec3<T>& t1, const Vec3<T>& t2, Vec3<T>* outBarycentric ) {
       /* Real-Time Collision Detection - Section 5.1.5 */
+      const T zero = static_cast<T>(0);
+      const T one = static_cast<T>(1);
 
       // Check if P in vertex region outside A
       Vec3<T> ab = t1 - t0;
       Vec3<T> ac = t2 - t0;
       Vec3<T> ap = p - t0;
-      float d1 = ab.dot(ap);
-      float d2 = ac.dot(ap);
-      if (d1 <= 0.0f && d2 <= 0.0f) return t0; // barycentric coordinates (1,0,0)
+      T d1 = ab.dot(ap);
+      T d2 = ac.dot(ap);
+      if (d1 <= zero && d2 <= zero) {
+        if( outBarycentric != nullptr ) *outBarycentric = Vec3<T>(one, zero, zero);
+        return t0;
+      }
 
       // Check if P in vertex region outside B
       Vec3<T> bp = p - t1;
-      float d3 = ab.dot(bp);
-      float d4 = ac.dot(bp);
-      if (d3 >= 0.0f && d4 <= d3) return t1; // barycentric coordinates (0,1,0)
+      T d3 = ab.dot(bp);
+      T d4 = ac.dot(bp);
+      if (d3 >= zero && d4 <= d3) {
+        if( outBarycentric != nullptr ) *outBarycentric = Vec3<T>(zero, one, zero);
+        return t1;
+      }
 
       // Check if P in edge region of AB, if so return projection of P onto AB
-      float vc = d1*d4 - d3*d2;
-      if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
-          float v = d1 / (d1 - d3);
-          return t0 + v * ab; // barycentric coordinates (1-v,v,0)
+      T vc = d1*d4 - d3*d2;
+      if (vc <= zero && d1 >= zero && d3 <= zero) {
+          T v = d1 / (d1 - d3);
+          if( outBarycentric != nullptr ) *outBarycentric = Vec3<T>(one - v, v, zero);
+          return t0 + v * ab;
       }
 
       // Check if P in vertex region outside C
       Vec3<T> cp = p - t2;
-      float d5 = ab.dot(cp);
-      float d6 = ac.dot(cp);
-      if (d6 >= 0.0f && d5 <= d6) return t2; // barycentric coordinates (0,0,1)
+      T d5 = ab.dot(cp);
+      T d6 = ac.dot(cp);
+      if (d6 >= zero && d5 <= d6) {
+        if( outBarycentric != nullptr ) *outBarycentric = Vec3<T>(zero, zero, one);
+        return t2;
+      }
 
       // Check if P in edge region of AC, if so return projection of P onto AC
-      float vb = d5*d2 - d1*d6;
-      if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
-          float w = d2 / (d2 - d6);
-          return t0 + w * ac; // barycentric coordinates (1-w,0,w)
+      T vb = d5*d2 - d1*d6;
+      if (vb <= zero && d2 >= zero && d6 <= zero) {
+          T w = d2 / (d2 - d6);
+          if( outBarycentric != nullptr ) *outBarycentric = Vec3<T>(one - w, zero, w);
+          return t0 + w * ac;
       }
 
       // Check if P in edge region of BC, if so return projection of P onto BC
-      float va = d3*d6 - d5*d4;
-      if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
-          float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
-          return t1 + w * (t2 - t1); // barycentric coordinates (0,1-w,w)
+      T va = d3*d6 - d5*d4;
+      if (va <= zero && (d4 - d3) >= zero && (d5 - d6) >= zero) {
+          T w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+          if( outBarycentric != nullptr ) *outBarycentric = Vec3<T>(zero, one - w, w);
+          return t1 + w * (t2 - t1);
       }
 
       // P inside face region. Compute Q through its barycentric coordinates (u,v,w)
-      float denom = 1.0f / (va + vb + vc);
-      float v = vb * denom;
-      float w = vc * denom;
-      return t0 + ab * v + ac * w; // = u*a + v*b + w*c, u = va * denom = 1.0f - v - w
+      T denom = one / (va + vb + vc);
+      T v = vb * denom;
+      T w = vc * denom;
+      if( outBarycentric != nullptr ) *outBarycentric = Vec3<T>(one - v - w, v, w);
+      return t0 + ab * v + ac * w; // = u*a + v*b + w*c, u = va * denom = 1 - v - w
+    }
+
+    /**
+     * Compute the closes point on a triangle.
+     * @param[in] p  The point to test from.
+     * @param[in] t0 The first vertex of the triangle.
+     * @param[in] t1 The second vertex of the triangle.
+     * @param[in] t2 The third vertex of the triangle.
+     * @return The position of the closest point on the triangle.
+     */
+    template<typename T>
+    inline Vec3<T> closestPointOnTriangle( const Vec3<T>& p, const Vec3<T>& t0, const Vec3<T>& t1, const Vec3<T>& t2 ) {
+      return closestPointOnTriangle(p, t0, t1, t2, static_cast<Vec3<T>*>(nullptr));
     }
     
+    /**
+     * Compute the closest point on a segment.
+     * @param[in]  p    The point to test from.
+     * @param[in]  a    The beginning of the segment.
+     * @param[in]  b    The end of the segment.
+     * @param[out] outT Parametric position of the closest point, in [0, 1] from a to b.  Optional.
+     * @return The closest point on the segment.
+     */
+    template<typename T>
+    inline Vec3<T> closestPointOnSegment( const Vec3<T>& p, const Vec3<T>& a, const Vec3<T>& b, T* outT ) {
+      const T zero = static_cast<T>(0);
+      const T one = static_cast<T>(1);
+      const Vec3<T> ab = b - a;
+
+      // Project point onto AB, but deferring divide by DP(ab,ab).
+      T t = (p - a).dot(ab);
+      Vec3<T> pos;
+      if( t <= zero ) {
+        // point projects outside the [A,B] interval, on the A side; clamp to A.
+        t = zero;
+        pos = a;
+      } else {
+        const T denom = ab.dot(ab); // Always nonnegative since denom = ||ab||^2.
+        if( t >= denom ) {
+          // point projects outside the [A,B] interval, on the B side; clamp to B.
+          t = one;
+          pos = b;
+        } else {
+          // point projects inside the [A,B] interval; must do deferred divide now.
+          t = t / denom;
+          pos = a + t * ab;
+        }
+      }
+      if( outT != nullptr ) {
+        *outT = t;
+      }
+      return pos;
+    }
+
    /**
      * Compute the closes point on a triangle.
      * @param[in]  p    The point to test from.
@@ -81,29 +152,167 @@ namespace cc {
         return;
       }
 
-      const Vec3<T> ab = b - a;
+      T t;
+      *outPos = closestPointOnSegment(p, a, b, &t);
+      *outT = static_cast<float>(t);
+    }
 
-      // Project point onto AB, but deferring divide by DP(ab,ab).
-      *outT = (p - a).dot(ab);
+    /**
+     * Compute the closest points between two segments.
+     * @param[in]  p1     The beginning of the first segment.
+     * @param[in]  q1     The end of the first segment.
+     * @param[in]  p2     The beginning of the second segment.
+     * @param[in]  q2     The end of the second segment.
+     * @param[out] outS   Parametric position of the closest point on the first segment.  Optional.
+     * @param[out] outT   Parametric position of the closest point on the second segment.  Optional.
+     * @param[out] outC1  The closest point on the first segment.  Optional.
+     * @param[out] outC2  The closest point on the second segment.  Optional.
+     * @return The squared distance between the two closest points.
+     */
+    template<typename T>
+    inline T closestPointsBetweenSegments( const Vec3<T>& p1, const Vec3<T>& q1, const Vec3<T>& p2, const Vec3<T>& q2, T* outS, T* outT, Vec3<T>* outC1, Vec3<T>* outC2 ) {
+      /* Real-Time Collision Detection - Section 5.1.9 */
+      const T zero = static_cast<T>(0);
+      const T one = static_cast<T>(1);
+      const T eps = static_cast<T>(EPSILON);
 
-      if( *outT <= 0.0f ) {
-        // point projects outside the [A,B] interval, on the A side; clamp to A.
-        *outT = 0.0f;
-        *outPos = a;
+      const Vec3<T> d1 = q1 - p1; // Direction vector of segment S1
+      const Vec3<T> d2 = q2 - p2; // Direction vector of segment S2
+      const Vec3<T> r = p1 - p2;
+      const T a = d1.dot(d1); // Squared length of segment S1, always nonnegative
+      const T e = d2.dot(d2); // Squared length of segment S2, always nonnegative
+      const T f = d2.dot(r);
+
+      T s = zero;
+      T t = zero;
+      if( a <= eps && e <= eps ) {
+        // Both segments degenerate into points.
+      } else if( a <= eps ) {
+        // First segment degenerates into a point.
+        t = clamp(f / e, zero, one);
       } else {
-        const float denom = ab.dot(ab); // Always nonnegative since denom = ||ab||^2.
-        if( *outT >= denom  ) {
-          // point projects outside the [A,B] interval, on the B side; clamp to B.
-          *outT = 1.0f;
-          *outPos = b;
+        const T c = d1.dot(r);
+        if( e <= eps ) {
+          // Second segment degenerates into a point.
+          s = clamp(-c / a, zero, one);
         } else {
-          // point projects inside the [A,B] interval; must do deferred divide now.
-          *outT = (*outT) / denom;
-          *outPos = a + (*outT) * ab;
+          // The general nondegenerate case starts here.
+          const T b = d1.dot(d2);
+          const T denom = a*e - b*b; // Always nonnegative
+
+          // If segments not parallel, compute closest point on L1 to L2 and clamp to segment S1.
+          // Else pick arbitrary s (here 0).
+          if( denom != zero ) {
+            s = clamp((b*f - c*e) / denom, zero, one);
+          }
+
+          // Compute point on L2 closest to S1(s), then clamp to S2 and recompute s for the new t if needed.
+          t = (b*s + f) / e;
+          if( t < zero ) {
+            t = zero;
+            s = clamp(-c / a, zero, one);
+          } else if( t > one ) {
+            t = one;
+            s = clamp((b - c) / a, zero, one);
+          }
         }
       }
+
+      const Vec3<T> c1 = p1 + d1 * s;
+      const Vec3<T> c2 = p2 + d2 * t;
+      if( outS != nullptr ) *outS = s;
+      if( outT != nullptr ) *outT = t;
+      if( outC1 != nullptr ) *outC1 = c1;
+      if( outC2 != nullptr ) *outC2 = c2;
+      return c1.sqrDistance(c2);
     }
-    
+
+    /**
+     * Compute the closest points between N pairs of segments at once.  Every lane runs the same branchless
+     * sequence (degenerate and parallel segments are handled by selects), so the loop vectorizes.
+     * @param[in]  p1             The beginnings of the first segments.
+     * @param[in]  q1             The ends of the first segments.
+     * @param[in]  p2             The beginnings of the second segments.
+     * @param[in]  q2             The ends of the second segments.
+     * @param[out] outS           Parametric positions of the closest points on the first segments.  Optional.
+     * @param[out] outT           Parametric positions of the closest points on the second segments.  Optional.
+     * @param[out] outSqrDistance Squared distances between the closest points.
+     */
+    template<typename T, unsigned int N>
+    inline void closestPointsBetweenSegments( const Vec3Soa<T, N>& p1, const Vec3Soa<T, N>& q1, const Vec3Soa<T, N>& p2, const Vec3Soa<T, N>& q2, T* outS, T* outT, T* outSqrDistance ) {
+      const T zero = static_cast<T>(0);
+      const T one = static_cast<T>(1);
+      const T eps = static_cast<T>(EPSILON);
+
+      T lanesS[N];
+      T lanesT[N];
+      for( unsigned int k = 0; k < N; ++k ) {
+        const T d1x = q1.x[k] - p1.x[k], d1y = q1.y[k] - p1.y[k], d1z = q1.z[k] - p1.z[k];
+        const T d2x = q2.x[k] - p2.x[k], d2y = q2.y[k] - p2.y[k], d2z = q2.z[k] - p2.z[k];
+        const T rx = p1.x[k] - p2.x[k], ry = p1.y[k] - p2.y[k], rz = p1.z[k] - p2.z[k];
+        const T a = d1x*d1x + d1y*d1y + d1z*d1z;
+        const T e = d2x*d2x + d2y*d2y + d2z*d2z;
+        const T b = d1x*d2x + d1y*d2y + d1z*d2z;
+        const T c = d1x*rx + d1y*ry + d1z*rz;
+        const T f = d2x*rx + d2y*ry + d2z*rz;
+        const T denom = a*e - b*b;
+
+        // Same cases as the scalar version.  Divisors are swapped for one where their result is discarded.
+        const bool aOk = a > eps;
+        const bool eOk = e > eps;
+        const T invA = one / (aOk ? a : one);
+        const T invE = one / (eOk ? e : one);
+        const T invDenom = one / ((denom > zero) ? denom : one);
+
+        T s = (aOk && eOk && denom > zero) ? (b*f - c*e) * invDenom : zero;
+        s = (s < zero) ? zero : ((s > one) ? one : s);
+        // A degenerate second segment takes the t < 0 path, which clamps t to 0 and solves for s.
+        const T tRaw = eOk ? (b*s + f) * invE : -one;
+        T sLow = -c * invA;
+        sLow = aOk ? ((sLow < zero) ? zero : ((sLow > one) ? one : sLow)) : zero;
+        T sHigh = (b - c) * invA;
+        sHigh = aOk ? ((sHigh < zero) ? zero : ((sHigh > one) ? one : sHigh)) : zero;
+
+        lanesS[k] = (tRaw < zero) ? sLow : ((tRaw > one) ? sHigh : s);
+        lanesT[k] = (tRaw < zero) ? zero : ((tRaw > one) ? one : tRaw);
+      }
+
+      for( unsigned int k = 0; k < N; ++k ) {
+        const T dx = (p1.x[k] + (q1.x[k] - p1.x[k]) * lanesS[k]) - (p2.x[k] + (q2.x[k] - p2.x[k]) * lanesT[k]);
+        const T dy = (p1.y[k] + (q1.y[k] - p1.y[k]) * lanesS[k]) - (p2.y[k] + (q2.y[k] - p2.y[k]) * lanesT[k]);
+        const T dz = (p1.z[k] + (q1.z[k] - p1.z[k]) * lanesS[k]) - (p2.z[k] + (q2.z[k] - p2.z[k]) * lanesT[k]);
+        outSqrDistance[k] = dx*dx + dy*dy + dz*dz;
+      }
+      if( outS != nullptr ) {
+        for( unsigned int k = 0; k < N; ++k ) outS[k] = lanesS[k];
+      }
+      if( outT != nullptr ) {
+        for( unsigned int k = 0; k < N; ++k ) outT[k] = lanesT[k];
+      }
+    }
+
+    /**
+     * Compute the squared distances from N points to N segments at once.
+     * @param[in]  p              The points to test from.
+     * @param[in]  a              The beginnings of the segments.
+     * @param[in]  b              The ends of the segments.
+     * @param[out] outSqrDistance Squared distances from each point to its segment.
+     */
+    template<typename T, unsigned int N>
+    inline void sqrDistanceToSegment( const Vec3Soa<T, N>& p, const Vec3Soa<T, N>& a, const Vec3Soa<T, N>& b, T* outSqrDistance ) {
+      const T zero = static_cast<T>(0);
+      const T one = static_cast<T>(1);
+      for( unsigned int k = 0; k < N; ++k ) {
+        const T abx = b.x[k] - a.x[k], aby = b.y[k] - a.y[k], abz = b.z[k] - a.z[k];
+        const T apx = p.x[k] - a.x[k], apy = p.y[k] - a.y[k], apz = p.z[k] - a.z[k];
+        const T denom = abx*abx + aby*aby + abz*abz;
+        T t = (apx*abx + apy*aby + apz*abz) / ((denom > zero) ? denom : one);
+        t = (t < zero) ? zero : ((t > one) ? one : t);
+        const T dx = apx - abx * t, dy = apy - aby * t, dz = apz - abz * t;
+        outSqrDistance[k] = dx*dx + dy*dy + dz*dz;
+      }
+    }
+
   } /* math */
 } /* cc */
 
@@ -0,0 +1,152 @@
+#ifndef __CC_MATH_CONVEXHULL__
+#define __CC_MATH_CONVEXHULL__
+
+#include <vector>
+#include "Vec3.hpp"
+#include "Plane.hpp"
+#include "StridedSpan.hpp"
+
+namespace cc {
+  namespace math {
+    /**
+     * Triangulated convex hull.  Each flat side is triangulated as a fan, so it appears as several triangles with the
+     * same plane.  For GJK, PointsSupport over the vertices is the hull's support function.
+     */
+    template<typename T>
+    struct ConvexHull {
+      std::vector<Vec3<T> >     vertices; /**< Hull vertices; a subset of the input points. */
+      std::vector<unsigned int> indices;  /**< Three indices into vertices per face, counter-clockwise seen from outside. */
+      std::vector<Plane<T> >    planes;   /**< Plane of each face, with a unit normal pointing out of the hull. */
+
+      inline void clear() {
+        vertices.clear();
+        indices.clear();
+        planes.clear();
+      }
+    };
+
+    /**
+     * Builds 3D convex hulls with quickhull (Barber et al.), seeded from mostSeparatedPointsOnAabb.
+     * Faces are polygons over half-edges.  After each point is added, neighbouring faces that are coplanar or concave to
+     * within the roundoff tolerance are merged, which keeps the hull convex so that the horizon seen from the next point
+     * is a single loop; points within the tolerance of the hull are treated as on it.
+     * Faces and half-edges come from pools that are recycled as faces are replaced or merged, and kept between builds
+     * along with all other working storage, so building many hulls with one QuickHull allocates only while the pools grow.
+     * Gregorius - Implementing Quickhull (GDC 2014)
+     */
+    template<typename T>
+    class QuickHull {
+    public:
+      inline QuickHull();
+
+      /**
+       * Computes the convex hull of a set of points.
+       * @param[in]  points  Points to enclose; may be strided.
+       * @param[out] outHull Hull of the points.  Cleared first.
+       * @return True if the hull was built; false if there are fewer than four points or they are all coplanar.
+       */
+      inline bool build( StridedSpan<const Vec3<T> > points, ConvexHull<T>* outHull );
+      inline bool build( const std::vector<Vec3<T> >& points, ConvexHull<T>* outHull );
+
+      // Number of face records in the pool.  Replaced faces are recycled, so this follows the most faces alive at once
+      // during a build rather than the number of faces created.
+      inline unsigned int poolSize() const;
+
+    private:
+      enum { NONE = 0xFFFFFFFF };
+      enum Mark { VISIBLE, NON_CONVEX, DELETED };
+
+      // Half-edge ending at vertex, with face on its left; the edge starts at the vertex of prev.
+      struct HalfEdge {
+        unsigned int vertex;
+        unsigned int face;
+        unsigned int next;
+        unsigned int prev;
+        unsigned int twin;
+      };
+
+      // Convex polygon; neighbours that are coplanar or concave to within tolerance are merged into it.
+      struct Face {
+        unsigned int edge;         // Any half-edge of the face.
+        unsigned int vertexCount;
+        Plane<T>     plane;
+        Vec3<T>      centroid;
+        T            area;         // Twice the area, only compared.
+        unsigned int outside;      // First point in front of this face, linked through _next; NONE if there are none.
+        unsigned int furthest;     // Point furthest in front of this face.
+        T            furthestDist;
+        Mark         mark;
+      };
+
+      // Horizon search state of one visible face: the next edge to cross and how many are left.
+      struct HorizonFrame {
+        unsigned int edge;
+        unsigned int remaining;
+      };
+
+      inline unsigned int addTriangle( unsigned int i, unsigned int j, unsigned int k );
+      inline void computePlane( unsigned int face );
+      inline void setTwins( unsigned int e, unsigned int f );
+      inline void addOutside( unsigned int point, unsigned int face, T dist );
+      inline void assign( unsigned int point, const unsigned int* faces, unsigned int faceCount );
+      inline void releasePoints( unsigned int face, unsigned int absorbing );
+      inline void deleteFace( unsigned int face );
+      inline void expand( unsigned int face, unsigned int eye );
+      inline T oppositeDistance( unsigned int edge ) const;
+      inline bool mergeAdjacent( unsigned int face, bool anyNonConvex );
+      inline void mergeAcross( unsigned int face, unsigned int edge );
+      inline void dropRedundantVertex( unsigned int face, unsigned int prev );
+
+    private:
+      std::vector<Vec3<T> >       _points;    // Input points, relative to the center of their bounds.
+      T                           _epsilon;
+      std::vector<HalfEdge>       _edges;
+      std::vector<Face>           _faces;
+      std::vector<unsigned int>   _freeEdges;
+      std::vector<unsigned int>   _freeFaces;
+      std::vector<unsigned int>   _pending;   // Faces that may have points in front of them.
+      std::vector<unsigned int>   _next;      // Next point in the same outside list, per point.
+      std::vector<unsigned int>   _horizon;   // Edges of the visible faces bordering the rest, in order around the eye.
+      std::vector<HorizonFrame>   _stack;
+      std::vector<unsigned int>   _visible;
+      std::vector<unsigned int>   _newFaces;
+      std::vector<unsigned int>   _orphans;
+      std::vector<unsigned int>   _discarded; // Faces a merge collapsed besides the one it absorbed.
+      std::vector<unsigned int>   _remap;
+    };
+
+    /**
+     * Computes the convex hull of a set of points.  To build many hulls, reuse a QuickHull or use computeConvexHulls.
+     * @param[in]  points  Points to enclose; may be strided.
+     * @param[out] outHull Hull of the points.  Cleared first.
+     * @return True if the hull was built; false if there are fewer than four points or they are all coplanar.
+     */
+    template<typename T>
+    inline bool computeConvexHull( StridedSpan<const Vec3<T> > points, ConvexHull<T>* outHull );
+    template<typename T>
+    inline bool computeConvexHull( const std::vector<Vec3<T> >& points, ConvexHull<T>* outHull );
+
+    /**
+     * Computes the convex hulls of many independent point sets, e.g. the collision proxies of every asset being loaded.
+     * The inputs are split across threads, each with its own QuickHull.
+     * @param[in]  inputs   Point sets to enclose.
+     * @param[out] outHulls Hull of each point set; empty where it could not be built.  Resized to the number of inputs.
+     * @return Number of hulls built.
+     */
+    template<typename T>
+    inline unsigned int computeConvexHulls( const std::vector<StridedSpan<const Vec3<T> > >& inputs, std::vector<ConvexHull<T> >* outHulls );
+    template<typename T>
+    inline unsigned int computeConvexHulls( const std::vector<std::vector<Vec3<T> > >& inputs, std::vector<ConvexHull<T> >* outHulls );
+  } /* math */
+
+  // Typedefs.
+  typedef cc::math::ConvexHull<float>  ConvexHullf;
+  typedef cc::math::ConvexHull<double> ConvexHulld;
+  typedef cc::math::QuickHull<float>   QuickHullf;
+  typedef cc::math::QuickHull<double>  QuickHulld;
+
+} /* cc */
+
+#include "ConvexHull.inl"
+
+#endif /* __CC_MATH_CONVEXHULL__ */
@@ -0,0 +1,601 @@
+#include <cmath>
+#include <limits>
+#include "ConvexHull.hpp"
+#include "Aabb.hpp"
+#include "Intersection.hpp"
+#include "Parallel.hpp"
+
+namespace cc {
+  namespace math {
+    template<typename T>
+    inline QuickHull<T>::QuickHull()
+      : _epsilon(static_cast<T>(0)) {
+    }
+
+    template<typename T>
+    inline bool QuickHull<T>::build( StridedSpan<const Vec3<T> > points, ConvexHull<T>* outHull ) {
+      if( outHull == nullptr ) {
+        return false;
+      }
+      outHull->clear();
+      _edges.clear();
+      _faces.clear();
+      _freeEdges.clear();
+      _freeFaces.clear();
+      _pending.clear();
+      const unsigned int count = static_cast<unsigned int>(points.size());
+      if( count < 4 ) {
+        return false;
+      }
+
+      // Work relative to the center of the bounds, so points far from the origin keep their precision.
+      const Aabb<T> bounds = computeAabb(points);
+      const Vec3<T> center = (bounds.boundsMin + bounds.boundsMax) * static_cast<T>(0.5);
+      _points.resize(count);
+      parallelFor(count, 1 << 16, [&]( std::size_t begin, std::size_t end, unsigned int ) {
+        for( std::size_t i = begin; i < end; ++i ) {
+          _points[i] = points[i] - center;
+        }
+      });
+
+      // Tolerance scaled to the magnitude of the coordinates (Barber et al., Section 4).
+      const T zero = static_cast<T>(0);
+      const Vec3<T> halfExtent = (bounds.boundsMax - bounds.boundsMin) * static_cast<T>(0.5);
+      _epsilon = static_cast<T>(3) * (halfExtent.x + halfExtent.y + halfExtent.z) * std::numeric_limits<T>::epsilon();
+
+      // Seed tetrahedron: the most separated pair, then the point furthest from their line, then from their plane.
+      int minIdx = 0;
+      int maxIdx = 0;
+      mostSeparatedPointsOnAabb(StridedSpan<const Vec3<T> >(_points), &minIdx, &maxIdx);
+      unsigned int seed[4] = { static_cast<unsigned int>(minIdx), static_cast<unsigned int>(maxIdx), 0, 0 };
+      const Vec3<T> axis = _points[seed[1]] - _points[seed[0]];
+      const T axisLength = axis.magnitude();
+      if( axisLength <= _epsilon ) {
+        return false;
+      }
+      T best = zero;
+      for( unsigned int i = 0; i < count; ++i ) {
+        const T dist = axis.cross(_points[i] - _points[seed[0]]).sqrMagnitude();
+        if( dist > best ) {
+          best = dist;
+          seed[2] = i;
+        }
+      }
+      if( std::sqrt(best) / axisLength <= _epsilon ) {
+        return false;
+      }
+      const Plane<T> base = Plane<T>::fromPoints(_points[seed[0]], _points[seed[1]], _points[seed[2]]);
+      best = zero;
+      for( unsigned int i = 0; i < count; ++i ) {
+        const T dist = std::abs(base.distance(_points[i]));
+        if( dist > best ) {
+          best = dist;
+          seed[3] = i;
+        }
+      }
+      if( best <= _epsilon ) {
+        return false;
+      }
+
+      // Every face wound outwards, away from the vertex it leaves out.
+      static const unsigned int tetra[4][4] = { {0, 1, 2, 3}, {0, 3, 1, 2}, {0, 2, 3, 1}, {1, 3, 2, 0} };
+      for( unsigned int i = 0; i < 4; ++i ) {
+        const unsigned int* t = tetra[i];
+        const Vec3<T>& a = _points[seed[t[0]]];
+        if( (_points[seed[t[1]]] - a).cross(_points[seed[t[2]]] - a).dot(_points[seed[t[3]]] - a) > zero ) {
+          addTriangle(seed[t[0]], seed[t[2]], seed[t[1]]);
+        } else {
+          addTriangle(seed[t[0]], seed[t[1]], seed[t[2]]);
+        }
+      }
+      // Each edge's twin runs between the same two vertices the other way.
+      for( unsigned int e = 0; e < 12; ++e ) {
+        for( unsigned int g = e + 1; g < 12; ++g ) {
+          if( _edges[e].vertex == _edges[_edges[g].prev].vertex && _edges[g].vertex == _edges[_edges[e].prev].vertex ) {
+            setTwins(e, g);
+          }
+        }
+      }
+
+      _next.assign(count, NONE);
+      const unsigned int initial[4] = { 0, 1, 2, 3 };
+      for( unsigned int i = 0; i < count; ++i ) {
+        if( i != seed[0] && i != seed[1] && i != seed[2] && i != seed[3] ) {
+          assign(i, initial, 4);
+        }
+      }
+
+      // Each step adds the point furthest in front of a face, replacing every face it can see.
+      while( !_pending.empty() ) {
+        const unsigned int f = _pending.back();
+        _pending.pop_back();
+        if( _faces[f].mark != DELETED && _faces[f].outside != NONE ) {
+          expand(f, _faces[f].furthest);
+        }
+      }
+
+      // Triangulate each face as a fan around its first vertex.
+      _remap.assign(count, NONE);
+      for( unsigned int f = 0; f < _faces.size(); ++f ) {
+        const Face& face = _faces[f];
+        if( face.mark == DELETED ) {
+          continue;
+        }
+        const Plane<T> plane(face.plane.normal, face.plane.d + face.plane.normal.dot(center));
+        unsigned int fan[2] = { 0, 0 };
+        unsigned int e = face.edge;
+        for( unsigned int k = 0; k < face.vertexCount; ++k, e = _edges[e].next ) {
+          const unsigned int v = _edges[e].vertex;
+          if( _remap[v] == NONE ) {
+            _remap[v] = static_cast<unsigned int>(outHull->vertices.size());
+            outHull->vertices.push_back(points[v]);
+          }
+          if( k >= 2 ) {
+            outHull->indices.push_back(fan[0]);
+            outHull->indices.push_back(fan[1]);
+            outHull->indices.push_back(_remap[v]);
+            outHull->planes.push_back(plane);
+          }
+          fan[(k == 0) ? 0 : 1] = _remap[v];
+        }
+      }
+      return true;
+    }
+
+    template<typename T>
+    inline bool QuickHull<T>::build( const std::vector<Vec3<T> >& points, ConvexHull<T>* outHull ) {
+      return build(StridedSpan<const Vec3<T> >(points), outHull);
+    }
+
+    template<typename T>
+    inline unsigned int QuickHull<T>::poolSize() const {
+      return static_cast<unsigned int>(_faces.size());
+    }
+
+    template<typename T>
+    inline unsigned int QuickHull<T>::addTriangle( unsigned int i, unsigned int j, unsigned int k ) {
+      unsigned int idx;
+      if( !_freeFaces.empty() ) {
+        idx = _freeFaces.back();
+        _freeFaces.pop_back();
+      } else {
+        idx = static_cast<unsigned int>(_faces.size());
+        _faces.push_back(Face());
+      }
+      unsigned int e[3];
+      for( unsigned int n = 0; n < 3; ++n ) {
+        if( !_freeEdges.empty() ) {
+          e[n] = _freeEdges.back();
+          _freeEdges.pop_back();
+        } else {
+          e[n] = static_cast<unsigned int>(_edges.size());
+          _edges.push_back(HalfEdge());
+        }
+      }
+      const unsigned int v[3] = { i, j, k };
+      for( unsigned int n = 0; n < 3; ++n ) {
+        const HalfEdge edge = { v[(n + 1) % 3], idx, e[(n + 1) % 3], e[(n + 2) % 3], NONE };
+        _edges[e[n]] = edge;
+      }
+      Face& f = _faces[idx];
+      f.edge = e[0];
+      f.outside = NONE;
+      f.furthest = NONE;
+      f.furthestDist = static_cast<T>(0);
+      f.mark = VISIBLE;
+      computePlane(idx);
+      return idx;
+    }
+
+    template<typename T>
+    inline void QuickHull<T>::computePlane( unsigned int face ) {
+      Face& f = _faces[face];
+      // Sum of the fan's cross products, which for a polygon that is not quite flat is the best fit normal.
+      const unsigned int e0 = f.edge;
+      const Vec3<T>& p0 = _points[_edges[e0].vertex];
+      Vec3<T> centroid = p0;
+      Vec3<T> n(static_cast<T>(0));
+      unsigned int vertexCount = 1;
+      unsigned int e = _edges[e0].next;
+      Vec3<T> d2 = _points[_edges[e].vertex] - p0;
+      centroid += _points[_edges[e].vertex];
+      ++vertexCount;
+      for( e = _edges[e].next; e != e0; e = _edges[e].next ) {
+        const Vec3<T> d1 = d2;
+        d2 = _points[_edges[e].vertex] - p0;
+        n += d1.cross(d2);
+        centroid += _points[_edges[e].vertex];
+        ++vertexCount;
+      }
+      f.vertexCount = vertexCount;
+      f.centroid = centroid / static_cast<T>(vertexCount);
+      f.area = n.magnitude();
+      // A sliver face gets a zero normal, so no point is ever in front of it and its neighbours merge it away.
+      f.plane = Plane<T>((f.area > static_cast<T>(0)) ? n / f.area : Vec3<T>(static_cast<T>(0)), f.centroid);
+    }
+
+    template<typename T>
+    inline void QuickHull<T>::setTwins( unsigned int e, unsigned int f ) {
+      _edges[e].twin = f;
+      _edges[f].twin = e;
+    }
+
+    template<typename T>
+    inline void QuickHull<T>::addOutside( unsigned int point, unsigned int face, T dist ) {
+      Face& f = _faces[face];
+      if( f.outside == NONE ) {
+        _pending.push_back(face);
+      }
+      _next[point] = f.outside;
+      f.outside = point;
+      if( dist > f.furthestDist ) {
+        f.furthestDist = dist;
+        f.furthest = point;
+      }
+    }
+
+    template<typename T>
+    inline void QuickHull<T>::assign( unsigned int point, const unsigned int* faces, unsigned int faceCount ) {
+      // The face the point is furthest in front of takes it; points within tolerance of every face are on the hull or
+      // inside it, and dropped.
+      T best = _epsilon;
+      unsigned int bestFace = NONE;
+      for( unsigned int i = 0; i < faceCount; ++i ) {
+        if( _faces[faces[i]].mark == DELETED ) {
+          continue;
+        }
+        const T dist = _faces[faces[i]].plane.distance(_points[point]);
+        if( dist > best ) {
+          best = dist;
+          bestFace = faces[i];
+        }
+      }
+      if( bestFace != NONE ) {
+        addOutside(point, bestFace, best);
+      }
+    }
+
+    template<typename T>
+    inline void QuickHull<T>::releasePoints( unsigned int face, unsigned int absorbing ) {
+      // Points still in front of the absorbing face move to it; the rest wait for the new faces.
+      unsigned int p = _faces[face].outside;
+      _faces[face].outside = NONE;
+      _faces[face].furthest = NONE;
+      _faces[face].furthestDist = static_cast<T>(0);
+      while( p != NONE ) {
+        const unsigned int next = _next[p];
+        const T dist = (absorbing != NONE) ? _faces[absorbing].plane.distance(_points[p]) : static_cast<T>(0);
+        if( absorbing != NONE && dist > _epsilon ) {
+          addOutside(p, absorbing, dist);
+        } else {
+          _orphans.push_back(p);
+        }
+        p = next;
+      }
+    }
+
+    template<typename T>
+    inline void QuickHull<T>::deleteFace( unsigned int face ) {
+      releasePoints(face, NONE);
+      _faces[face].mark = DELETED;
+      _visible.push_back(face);
+    }
+
+    template<typename T>
+    inline void QuickHull<T>::expand( unsigned int face, unsigned int eye ) {
+      const Vec3<T> eyePoint = _points[eye];
+      _orphans.clear();
+      _horizon.clear();
+      _visible.clear();
+
+      // Depth-first walk over the visible faces, with the stack in place of recursion so large hulls cannot overflow it.
+      // Each face is entered across one edge and continues from the edge after it, so the horizon comes out in order.
+      _stack.clear();
+      deleteFace(face);
+      const HorizonFrame root = { _faces[face].edge, _faces[face].vertexCount };
+      _stack.push_back(root);
+      while( !_stack.empty() ) {
+        HorizonFrame& top = _stack.back();
+        if( top.remaining == 0 ) {
+          _stack.pop_back();
+          continue;
+        }
+        const unsigned int e = top.edge;
+        top.edge = _edges[e].next;
+        --top.remaining;
+        const unsigned int twin = _edges[e].twin;
+        const unsigned int opposite = _edges[twin].face;
+        if( _faces[opposite].mark == DELETED ) {
+          continue;
+        }
+        if( _faces[opposite].plane.distance(eyePoint) > _epsilon ) {
+          deleteFace(opposite);
+          const HorizonFrame frame = { _edges[twin].next, _faces[opposite].vertexCount - 1 };
+          _stack.push_back(frame);
+        } else {
+          _horizon.push_back(e);
+        }
+      }
+
+      // Fan of triangles joining the eye to the horizon; edge 0 of each lies on the horizon, 1 leaves it for the eye,
+      // and 2 returns from the eye.
+      _newFaces.clear();
+      const unsigned int horizonCount = static_cast<unsigned int>(_horizon.size());
+      for( unsigned int h = 0; h < horizonCount; ++h ) {
+        const unsigned int e = _horizon[h];
+        const unsigned int f = addTriangle(_edges[_edges[e].prev].vertex, _edges[e].vertex, eye);
+        const unsigned int fe = _faces[f].edge;
+        setTwins(fe, _edges[e].twin);
+        if( h > 0 ) {
+          setTwins(_edges[fe].prev, _edges[_faces[_newFaces.back()].edge].next);
+        }
+        _newFaces.push_back(f);
+      }
+      if( horizonCount > 0 ) {
+        setTwins(_edges[_faces[_newFaces.front()].edge].prev, _edges[_faces[_newFaces.back()].edge].next);
+      }
+
+      // The fan has read the horizon, so the visible faces and their edges can go back to the pools.
+      for( unsigned int i = 0; i < _visible.size(); ++i ) {
+        unsigned int e = _faces[_visible[i]].edge;
+        for( unsigned int k = 0; k < _faces[_visible[i]].vertexCount; ++k, e = _edges[e].next ) {
+          _freeEdges.push_back(e);
+        }
+        _freeFaces.push_back(_visible[i]);
+      }
+
+      // Merge away creases that are concave or flat to within tolerance: first judged from the larger face of each pair,
+      // then from either side for the faces that are still not convex.
+      for( unsigned int i = 0; i < _newFaces.size(); ++i ) {
+        if( _faces[_newFaces[i]].mark == VISIBLE ) {
+          while( mergeAdjacent(_newFaces[i], false) ) {
+          }
+        }
+      }
+      for( unsigned int i = 0; i < _newFaces.size(); ++i ) {
+        if( _faces[_newFaces[i]].mark == NON_CONVEX ) {
+          _faces[_newFaces[i]].mark = VISIBLE;
+          while( mergeAdjacent(_newFaces[i], true) ) {
+          }
+        }
+      }
+
+      if( !_newFaces.empty() ) {
+        for( unsigned int i = 0; i < _orphans.size(); ++i ) {
+          if( _orphans[i] != eye ) {
+            assign(_orphans[i], &_newFaces[0], static_cast<unsigned int>(_newFaces.size()));
+          }
+        }
+      }
+    }
+
+    template<typename T>
+    inline T QuickHull<T>::oppositeDistance( unsigned int edge ) const {
+      // Height of the centroid of the face across the edge above the plane of the edge's face.
+      return _faces[_edges[edge].face].plane.distance(_faces[_edges[_edges[edge].twin].face].centroid);
+    }
+
+    template<typename T>
+    inline bool QuickHull<T>::mergeAdjacent( unsigned int face, bool anyNonConvex ) {
+      const unsigned int first = _faces[face].edge;
+      unsigned int e = first;
+      bool convex = true;
+      do {
+        const unsigned int twin = _edges[e].twin;
+        const unsigned int opposite = _edges[twin].face;
+        bool merge = false;
+        if( anyNonConvex ) {
+          merge = oppositeDistance(e) > -_epsilon || oppositeDistance(twin) > -_epsilon;
+        } else {
+          // The larger face has the more reliable plane, so it decides; the other side only flags a crease to revisit.
+          const bool larger = _faces[face].area > _faces[opposite].area;
+          if( oppositeDistance(larger ? e : twin) > -_epsilon ) {
+            merge = true;
+          } else if( oppositeDistance(larger ? twin : e) > -_epsilon ) {
+            convex = false;
+          }
+        }
+        if( merge ) {
+          mergeAcross(face, e);
+          return true;
+        }
+        e = _edges[e].next;
+      } while( e != first );
+      if( !convex ) {
+        _faces[face].mark = NON_CONVEX;
+      }
+      return false;
+    }
+
+    template<typename T>
+    inline void QuickHull<T>::mergeAcross( unsigned int face, unsigned int edge ) {
+      const unsigned int oppositeEdge = _edges[edge].twin;
+      const unsigned int opposite = _edges[oppositeEdge].face;
+      _faces[opposite].mark = DELETED;
+      _freeFaces.push_back(opposite);
+
+      // The faces may share a chain of edges; find its ends on both sides.
+      unsigned int edgePrev = _edges[edge].prev;
+      unsigned int edgeNext = _edges[edge].next;
+      unsigned int oppositePrev = _edges[oppositeEdge].prev;
+      unsigned int oppositeNext = _edges[oppositeEdge].next;
+      unsigned int shared = 1;
+      while( _edges[_edges[edgePrev].twin].face == opposite ) {
+        edgePrev = _edges[edgePrev].prev;
+        oppositeNext = _edges[oppositeNext].next;
+        ++shared;
+      }
+      while( _edges[_edges[edgeNext].twin].face == opposite ) {
+        edgeNext = _edges[edgeNext].next;
+        oppositePrev = _edges[oppositePrev].prev;
+        ++shared;
+      }
+
+      // The shared chain goes back to the pool from this side.
+      for( unsigned int e = _edges[edgePrev].next; e != edgeNext; e = _edges[e].next ) {
+        _freeEdges.push_back(e);
+      }
+
+      _discarded.clear();
+      if( shared == _faces[opposite].vertexCount ) {
+        // The opposite face is enclosed by this one and has no edges left to take over, so the chain is cut out.
+        unsigned int e = oppositeEdge;
+        for( unsigned int k = 0; k < shared; ++k, e = _edges[e].next ) {
+          _freeEdges.push_back(e);
+        }
+        _edges[edgePrev].next = edgeNext;
+        _edges[edgeNext].prev = edgePrev;
+        _faces[face].edge = edgeNext;
+        dropRedundantVertex(face, edgePrev);
+      } else {
+        for( unsigned int e = _edges[oppositePrev].next; e != oppositeNext; e = _edges[e].next ) {
+          _freeEdges.push_back(e);
+        }
+
+        // Take over the rest of the opposite face and splice it in where the shared chain was.
+        const unsigned int end = _edges[oppositePrev].next;
+        for( unsigned int e = oppositeNext; e != end; e = _edges[e].next ) {
+          _edges[e].face = face;
+        }
+        _edges[oppositePrev].next = edgeNext;
+        _edges[edgeNext].prev = oppositePrev;
+        _edges[edgePrev].next = oppositeNext;
+        _edges[oppositeNext].prev = edgePrev;
+        _faces[face].edge = edgeNext;
+        // If the opposite face gave a single edge, the first call may drop it, so the second looks up its successor again;
+        // it may even drop edgePrev, which then no longer belongs to the face.
+        dropRedundantVertex(face, oppositePrev);
+        if( _edges[edgePrev].face == face ) {
+          dropRedundantVertex(face, edgePrev);
+        }
+      }
+      computePlane(face);
+
+      releasePoints(opposite, face);
+      for( unsigned int i = 0; i < _discarded.size(); ++i ) {
+        releasePoints(_discarded[i], face);
+      }
+    }
+
+    template<typename T>
+    inline void QuickHull<T>::dropRedundantVertex( unsigned int face, unsigned int prev ) {
+      const unsigned int next = _edges[prev].next;
+      const unsigned int opposite = _edges[_edges[next].twin].face;
+      if( _edges[_edges[prev].twin].face != opposite ) {
+        return;
+      }
+
+      if( _faces[opposite].vertexCount == 3 ) {
+        const unsigned int third = _edges[_edges[next].twin].prev;
+        const unsigned int thirdTwin = _edges[third].twin;
+        if( _edges[thirdTwin].face == face ) {
+          // The triangle is enclosed by the face, so all three of its edges are cut out of the face's ring, and the
+          // vertex where the ring closes up again may be redundant in turn.
+          unsigned int first = prev;
+          if( _edges[next].next != thirdTwin ) {
+            if( _edges[prev].prev != thirdTwin ) {
+              return;
+            }
+            first = thirdTwin;
+          }
+          const unsigned int before = _edges[first].prev;
+          const unsigned int after = _edges[_edges[_edges[first].next].next].next;
+          unsigned int e = first;
+          for( unsigned int k = 0; k < 3; ++k, e = _edges[e].next ) {
+            _edges[e].face = NONE;
+            _freeEdges.push_back(e);
+            _freeEdges.push_back(_edges[e].twin);
+          }
+          _faces[opposite].mark = DELETED;
+          _freeFaces.push_back(opposite);
+          _discarded.push_back(opposite);
+          _edges[before].next = after;
+          _edges[after].prev = before;
+          _faces[face].edge = after;
+          dropRedundantVertex(face, before);
+          return;
+        }
+      }
+
+      // Both edges border the same face, so the vertex between them is redundant: next takes over from the start of
+      // prev, and the opposite face either loses the vertex too or, if it was a triangle, collapses into its third edge.
+      unsigned int oppositeEdge;
+      if( _faces[face].edge == prev ) {
+        _faces[face].edge = next;
+      }
+      _edges[prev].face = NONE;
+      _freeEdges.push_back(prev);
+      _freeEdges.push_back(_edges[next].twin);
+      if( _faces[opposite].vertexCount == 3 ) {
+        const unsigned int third = _edges[_edges[next].twin].prev;
+        oppositeEdge = _edges[third].twin;
+        _faces[opposite].mark = DELETED;
+        _freeFaces.push_back(opposite);
+        _freeEdges.push_back(_edges[_edges[next].twin].next);
+        _freeEdges.push_back(third);
+        _discarded.push_back(opposite);
+      } else {
+        oppositeEdge = _edges[_edges[next].twin].next;
+        if( _faces[opposite].edge == _edges[oppositeEdge].prev ) {
+          _faces[opposite].edge = oppositeEdge;
+        }
+        _edges[oppositeEdge].prev = _edges[_edges[oppositeEdge].prev].prev;
+        _edges[_edges[oppositeEdge].prev].next = oppositeEdge;
+        computePlane(opposite);
+      }
+      _edges[next].prev = _edges[prev].prev;
+      _edges[_edges[next].prev].next = next;
+      setTwins(next, oppositeEdge);
+
+      // Next may now border the same face as a neighbour, so either of its ends can be redundant in turn.
+      dropRedundantVertex(face, _edges[next].prev);
+      if( _edges[next].face == face ) {
+        dropRedundantVertex(face, next);
+      }
+    }
+
+    template<typename T>
+    inline bool computeConvexHull( StridedSpan<const Vec3<T> > points, ConvexHull<T>* outHull ) {
+      QuickHull<T> quickHull;
+      return quickHull.build(points, outHull);
+    }
+
+    template<typename T>
+    inline bool computeConvexHull( const std::vector<Vec3<T> >& points, ConvexHull<T>* outHull ) {
+      return computeConvexHull(StridedSpan<const Vec3<T> >(points), outHull);
+    }
+
+    template<typename T>
+    inline unsigned int computeConvexHulls( const std::vector<StridedSpan<const Vec3<T> > >& inputs, std::vector<ConvexHull<T> >* outHulls ) {
+      if( outHulls == nullptr ) {
+        return 0;
+      }
+      outHulls->resize(inputs.size());
+      std::vector<unsigned int> chunkBuilt(parallelThreadCount(), 0u);
+      const unsigned int chunks = parallelFor(inputs.size(), 1, [&]( std::size_t begin, std::size_t end, unsigned int chunk ) {
+        QuickHull<T> quickHull;
+        unsigned int built = 0;
+        for( std::size_t i = begin; i < end; ++i ) {
+          built += quickHull.build(inputs[i], &(*outHulls)[i]) ? 1 : 0;
+        }
+        chunkBuilt[chunk] = built;
+      });
+
+      unsigned int result = 0;
+      for( unsigned int c = 0; c < chunks; ++c ) {
+        result += chunkBuilt[c];
+      }
+      return result;
+    }
+
+    template<typename T>
+    inline unsigned int computeConvexHulls( const std::vector<std::vector<Vec3<T> > >& inputs, std::vector<ConvexHull<T> >* outHulls ) {
+      std::vector<StridedSpan<const Vec3<T> > > spans;
+      spans.reserve(inputs.size());
+      for( std::size_t i = 0; i < inputs.size(); ++i ) {
+        spans.push_back(StridedSpan<const Vec3<T> >(inputs[i]));
+      }
+      return computeConvexHulls(spans, outHulls);
+    }
+  } /* math */
+} /* cc */
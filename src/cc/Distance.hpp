@@ -1,20 +1,98 @@
 #ifndef __CC_MATH_DISTANCE__
 #define	__CC_MATH_DISTANCE__
 
+#include <cstddef>
+#include <vector>
 #include "Vec3.hpp"
+#include "Parallel.hpp"
+#include "StridedSpan.hpp"
 
 namespace cc {
   namespace math {
     /**
      * Compute the perpendicular distance from a point to a plane.
+     * For many points against one plane, Plane precomputes the plane's offset; see also distancesToPlane.
      * @param[in] point       Point to test from.
      * @param[in] planePoint  Point on the plane.
      * @param[in] planeNormal Normal of the plane.
      * @return perpendicular distance from the point to the plane.
      */
     template<typename T>
-    inline float perpendicularDistanceToPointFromPlane( const Vec3<T>& point, const Vec3<T>& planePoint, const Vec3<T>& planeNormal ) {
-      return point.dot(planeNormal) - planePoint.dot(planeNormal);
+    inline T perpendicularDistanceToPointFromPlane( const Vec3<T>& point, const Vec3<T>& planePoint, const Vec3<T>& planeNormal ) {
+      return (point - planePoint).dot(planeNormal);
+    }
+
+    /**
+     * Find the point farthest from a given position.  Ties resolve to the lowest index.
+     * Large inputs are split across threads; each thread measures eight points per step in independent lanes.
+     * @param[in]  points         Points to search; must not be empty.
+     * @param[in]  from           Position to measure from.
+     * @param[out] outSqrDistance Squared distance to the farthest point.  Optional.
+     * @return Index of the farthest point.
+     */
+    template<typename T>
+    inline std::size_t farthestPoint( StridedSpan<const Vec3<T> > points, const Vec3<T>& from, T* outSqrDistance ) {
+      struct Farthest {
+        T           dist2;
+        std::size_t index;
+
+        static inline Farthest scan( const StridedSpan<const Vec3<T> >& points, std::size_t begin, std::size_t end, const Vec3<T>& from ) {
+          enum { LANES = 8 };
+          T best[LANES];
+          std::size_t bestIdx[LANES];
+          for( unsigned int k = 0; k < LANES; ++k ) {
+            best[k] = static_cast<T>(-1);
+            bestIdx[k] = begin;
+          }
+
+          const std::size_t blocks = (end - begin) / LANES;
+          for( std::size_t b = 0; b < blocks; ++b ) {
+            const std::size_t first = begin + b * LANES;
+            T dist2[LANES];
+            for( unsigned int k = 0; k < LANES; ++k ) {
+              const T dx = points[first + k].x - from.x;
+              const T dy = points[first + k].y - from.y;
+              const T dz = points[first + k].z - from.z;
+              dist2[k] = dx * dx + dy * dy + dz * dz;
+            }
+            for( unsigned int k = 0; k < LANES; ++k ) {
+              const bool further = dist2[k] > best[k];
+              best[k] = further ? dist2[k] : best[k];
+              bestIdx[k] = further ? first + k : bestIdx[k];
+            }
+          }
+
+          Farthest result = { static_cast<T>(-1), begin };
+          for( unsigned int k = 0; k < LANES; ++k ) {
+            result.merge(best[k], bestIdx[k]);
+          }
+          for( std::size_t i = begin + blocks * LANES; i < end; ++i ) {
+            result.merge(points[i].sqrDistance(from), i);
+          }
+          return result;
+        }
+
+        inline void merge( T otherDist2, std::size_t otherIndex ) {
+          if( otherDist2 > dist2 || (otherDist2 == dist2 && otherIndex < index) ) {
+            dist2 = otherDist2;
+            index = otherIndex;
+          }
+        }
+      };
+
+      std::vector<Farthest> partial(parallelThreadCount());
+      const unsigned int chunks = parallelFor(points.size(), 1 << 16, [&]( std::size_t begin, std::size_t end, unsigned int chunk ) {
+        partial[chunk] = Farthest::scan(points, begin, end, from);
+      });
+
+      Farthest result = partial[0];
+      for( unsigned int i = 1; i < chunks; ++i ) {
+        result.merge(partial[i].dist2, partial[i].index);
+      }
+      if( outSqrDistance != nullptr ) {
+        *outSqrDistance = result.dist2;
+      }
+      return result.index;
     }
   } /* math */
 } /* cc */
@@ -0,0 +1,136 @@
+#ifndef __CC_MATH_GJK__
+#define __CC_MATH_GJK__
+
+#include "Vec3.hpp"
+#include "Aabb.hpp"
+#include "StridedSpan.hpp"
+
+namespace cc {
+  namespace math {
+    /**
+     * Simplex cached between GJK queries of the same pair of shapes.  It stores the search directions that
+     * produced the final simplex; the next query re-evaluates them against the shapes' current poses, so a
+     * pair that moved only slightly starts on (or next to) the answer and converges in one or two iterations.
+     * A default constructed (or reset) cache starts from scratch.
+     */
+    template<typename T>
+    struct GjkSimplex {
+      Vec3<T>      directions[4];
+      unsigned int count;
+
+      inline GjkSimplex() : count(0) {}
+      inline void reset() { count = 0; }
+    };
+
+    /**
+     * Result of a GJK distance query.
+     */
+    template<typename T>
+    struct GjkResult {
+      Vec3<T>      pointA;       /**< Closest point on the first shape.  Undefined when intersecting. */
+      Vec3<T>      pointB;       /**< Closest point on the second shape.  Undefined when intersecting. */
+      T            distance;     /**< Distance between the shapes; zero when intersecting. */
+      unsigned int iterations;   /**< Number of support evaluations after warm-starting. */
+      bool         intersecting; /**< True if the shapes touch or overlap. */
+    };
+
+    /**
+     * Result of an EPA penetration query.
+     */
+    template<typename T>
+    struct EpaResult {
+      Vec3<T>      normal;     /**< Unit direction from the first shape into the second.  Moving the second shape by normal * depth separates them. */
+      Vec3<T>      pointA;     /**< Deepest point of the first shape inside the second. */
+      Vec3<T>      pointB;     /**< Deepest point of the second shape inside the first. */
+      T            depth;      /**< Penetration depth. */
+      unsigned int iterations; /**< Number of polytope expansions. */
+    };
+
+    /**
+     * Compute the distance between two convex shapes (Gilbert-Johnson-Keerthi).
+     * Shapes are given as support functions: callables taking a direction (not necessarily unit length)
+     * and returning the point of the shape furthest along it, e.g. SphereSupport or a lambda.
+     * @param[in]     shapeA    Support function of the first shape.
+     * @param[in]     shapeB    Support function of the second shape.
+     * @param[in,out] simplex   Warm-start cache for this pair.  Optional.
+     * @param[out]    outResult Closest points and distance.  Optional.
+     * @return Distance between the shapes, or zero if they intersect.
+     */
+    template<typename T, typename SupportA, typename SupportB>
+    inline T gjkDistance( const SupportA& shapeA, const SupportB& shapeB, GjkSimplex<T>* simplex, GjkResult<T>* outResult );
+
+    /**
+     * Test if two convex shapes intersect.  Stops as soon as a separating direction is found, so this is
+     * cheaper than gjkDistance when only a yes/no answer is needed.
+     * @param[in]     shapeA  Support function of the first shape.
+     * @param[in]     shapeB  Support function of the second shape.
+     * @param[in,out] simplex Warm-start cache for this pair.  Optional.
+     * @return True if the shapes touch or overlap; false otherwise.
+     */
+    template<typename T, typename SupportA, typename SupportB>
+    inline bool gjkIntersects( const SupportA& shapeA, const SupportB& shapeB, GjkSimplex<T>* simplex );
+
+    /**
+     * Compute the penetration of two overlapping convex shapes (GJK followed by the Expanding Polytope Algorithm).
+     * @param[in]     shapeA    Support function of the first shape.
+     * @param[in]     shapeB    Support function of the second shape.
+     * @param[in,out] simplex   Warm-start cache for this pair.  Optional.
+     * @param[out]    outResult Penetration normal, depth and deepest points.
+     * @return True if the shapes overlap by a measurable depth; false otherwise, and outResult is not written.
+     */
+    template<typename T, typename SupportA, typename SupportB>
+    inline bool epaPenetration( const SupportA& shapeA, const SupportB& shapeB, GjkSimplex<T>* simplex, EpaResult<T>* outResult );
+
+    // Support function of a single point.
+    template<typename T>
+    struct PointSupport {
+      Vec3<T> point;
+
+      inline explicit PointSupport( const Vec3<T>& point ) : point(point) {}
+      inline Vec3<T> operator()( const Vec3<T>& ) const { return point; }
+    };
+
+    // Support function of a sphere.
+    template<typename T>
+    struct SphereSupport {
+      Vec3<T> center;
+      T       radius;
+
+      inline SphereSupport( const Vec3<T>& center, T radius ) : center(center), radius(radius) {}
+      inline Vec3<T> operator()( const Vec3<T>& direction ) const;
+    };
+
+    // Support function of a capsule (a segment swept by a sphere).
+    template<typename T>
+    struct CapsuleSupport {
+      Vec3<T> a;
+      Vec3<T> b;
+      T       radius;
+
+      inline CapsuleSupport( const Vec3<T>& a, const Vec3<T>& b, T radius ) : a(a), b(b), radius(radius) {}
+      inline Vec3<T> operator()( const Vec3<T>& direction ) const;
+    };
+
+    // Support function of an axis-aligned box.
+    template<typename T>
+    struct AabbSupport {
+      Aabb<T> box;
+
+      inline explicit AabbSupport( const Aabb<T>& box ) : box(box) {}
+      inline Vec3<T> operator()( const Vec3<T>& direction ) const;
+    };
+
+    // Support function of the convex hull of a set of points (by linear scan; best for small hulls).
+    template<typename T>
+    struct PointsSupport {
+      StridedSpan<const Vec3<T> > points;
+
+      inline explicit PointsSupport( StridedSpan<const Vec3<T> > points ) : points(points) {}
+      inline Vec3<T> operator()( const Vec3<T>& direction ) const;
+    };
+  } /* math */
+} /* cc */
+
+#include "Gjk.inl"
+
+#endif /* __CC_MATH_GJK__ */
@@ -0,0 +1,617 @@
+#include <cmath>
+#include <limits>
+#include "Gjk.hpp"
+#include "ClosestPoint.hpp"
+
+namespace cc {
+  namespace math {
+    namespace detail {
+      /**
+       * Working simplex of a GJK query.  Each vertex is a point of the Minkowski difference A - B together with
+       * the points of A and B and the search direction that produced it, so closest points and the warm-start
+       * cache can be recovered from the final barycentric weights.
+       */
+      template<typename T>
+      struct GjkWorkSimplex {
+        enum { MAX_ITERATIONS = 64 };
+
+        // Closest point of a sub-simplex to the origin, as weights of the vertices that support it.
+        struct Feature {
+          unsigned int idx[3];
+          T            weight[3];
+          unsigned int count;
+          Vec3<T>      v;
+        };
+
+        Vec3<T>      w[4];
+        Vec3<T>      a[4];
+        Vec3<T>      b[4];
+        Vec3<T>      dir[4];
+        T            lambda[4];
+        unsigned int count;
+
+        template<typename SupportA, typename SupportB>
+        inline void support( const SupportA& shapeA, const SupportB& shapeB, const Vec3<T>& direction, unsigned int slot ) {
+          a[slot] = shapeA(direction);
+          b[slot] = shapeB(-direction);
+          w[slot] = a[slot] - b[slot];
+          dir[slot] = direction;
+        }
+
+        inline bool isDuplicate( unsigned int slot ) const {
+          for( unsigned int i = 0; i < count; ++i ) {
+            if( i != slot && w[i].sqrDistance(w[slot]) <= tolerance() * tolerance() * w[slot].sqrMagnitude() ) {
+              return true;
+            }
+          }
+          return false;
+        }
+
+        inline T maxSqrMagnitude() const {
+          T result = static_cast<T>(0);
+          for( unsigned int i = 0; i < count; ++i ) {
+            const T m = w[i].sqrMagnitude();
+            result = (m > result) ? m : result;
+          }
+          return result;
+        }
+
+        static inline T tolerance() {
+          return std::numeric_limits<T>::epsilon() * static_cast<T>(128);
+        }
+
+        inline void segmentFeature( unsigned int i, unsigned int j, Feature* f ) const {
+          T t;
+          f->v = closestPointOnSegment(Vec3<T>(static_cast<T>(0)), w[i], w[j], &t);
+          if( t <= static_cast<T>(0) ) {
+            f->count = 1; f->idx[0] = i; f->weight[0] = static_cast<T>(1);
+          } else if( t >= static_cast<T>(1) ) {
+            f->count = 1; f->idx[0] = j; f->weight[0] = static_cast<T>(1);
+          } else {
+            f->count = 2;
+            f->idx[0] = i; f->weight[0] = static_cast<T>(1) - t;
+            f->idx[1] = j; f->weight[1] = t;
+          }
+        }
+
+        inline void triangleFeature( unsigned int i, unsigned int j, unsigned int k, Feature* f ) const {
+          const Vec3<T> ab = w[j] - w[i];
+          const Vec3<T> ac = w[k] - w[i];
+          if( ab.cross(ac).sqrMagnitude() <= static_cast<T>(EPSILON) * ab.sqrMagnitude() * ac.sqrMagnitude() ) {
+            // Collinear vertices; the closest point lies on one of the edges.
+            Feature g = Feature();
+            segmentFeature(i, j, f);
+            segmentFeature(j, k, &g);
+            if( g.v.sqrMagnitude() < f->v.sqrMagnitude() ) *f = g;
+            segmentFeature(k, i, &g);
+            if( g.v.sqrMagnitude() < f->v.sqrMagnitude() ) *f = g;
+            return;
+          }
+
+          Vec3<T> bary;
+          f->v = closestPointOnTriangle(Vec3<T>(static_cast<T>(0)), w[i], w[j], w[k], &bary);
+          const unsigned int ids[3] = { i, j, k };
+          f->count = 0;
+          for( unsigned int m = 0; m < 3; ++m ) {
+            if( bary[m] > static_cast<T>(0) ) {
+              f->idx[f->count] = ids[m];
+              f->weight[f->count] = bary[m];
+              ++f->count;
+            }
+          }
+          if( f->count == 3 ) {
+            // Inside the face; projecting onto the normal keeps v perpendicular to it, where the weighted sum of
+            // vertices far larger than v would lose it to rounding and stall the search.
+            const Vec3<T> n = ab.cross(ac);
+            f->v = n * (n.dot(w[i]) / n.sqrMagnitude());
+          }
+        }
+
+        // Reduces the simplex to the vertices supporting a feature.
+        inline void keep( const Feature& f ) {
+          Vec3<T> nw[3], na[3], nb[3], nd[3];
+          for( unsigned int m = 0; m < f.count; ++m ) {
+            nw[m] = w[f.idx[m]];
+            na[m] = a[f.idx[m]];
+            nb[m] = b[f.idx[m]];
+            nd[m] = dir[f.idx[m]];
+          }
+          for( unsigned int m = 0; m < f.count; ++m ) {
+            w[m] = nw[m];
+            a[m] = na[m];
+            b[m] = nb[m];
+            dir[m] = nd[m];
+            lambda[m] = f.weight[m];
+          }
+          count = f.count;
+        }
+
+        /**
+         * Finds the point of the simplex closest to the origin and drops the vertices not needed to express it.
+         * @param[out] outV Closest point.
+         * @return False if the simplex is a tetrahedron enclosing the origin; true otherwise.
+         */
+        inline bool solve( Vec3<T>* outV ) {
+          Feature f;
+          switch( count ) {
+            case 1: {
+              lambda[0] = static_cast<T>(1);
+              *outV = w[0];
+              return true;
+            }
+            case 2: {
+              segmentFeature(0, 1, &f);
+              break;
+            }
+            case 3: {
+              triangleFeature(0, 1, 2, &f);
+              break;
+            }
+            default: {
+              /* Real-Time Collision Detection - Section 5.1.6 */
+              static const unsigned int faces[4][4] = { {0, 1, 2, 3}, {0, 3, 1, 2}, {0, 2, 3, 1}, {1, 3, 2, 0} };
+              const Vec3<T> ab = w[1] - w[0];
+              const Vec3<T> ac = w[2] - w[0];
+              const Vec3<T> ad = w[3] - w[0];
+              const T volume = ab.dot(ac.cross(ad));
+              const T scale = ab.magnitude() * ac.magnitude() * ad.magnitude();
+              const bool flat = std::abs(volume) <= static_cast<T>(EPSILON) * scale;
+
+              bool found = false;
+              for( unsigned int i = 0; i < 4; ++i ) {
+                const unsigned int* face = faces[i];
+                if( !flat ) {
+                  // Only faces with the origin on the opposite side from the fourth vertex can be closest.
+                  const Vec3<T> n = (w[face[1]] - w[face[0]]).cross(w[face[2]] - w[face[0]]);
+                  const T signOrigin = -n.dot(w[face[0]]);
+                  const T signOpposite = n.dot(w[face[3]] - w[face[0]]);
+                  if( signOrigin * signOpposite >= static_cast<T>(0) ) {
+                    continue;
+                  }
+                }
+                Feature g = Feature();
+                triangleFeature(face[0], face[1], face[2], &g);
+                if( !found || g.v.sqrMagnitude() < f.v.sqrMagnitude() ) {
+                  f = g;
+                  found = true;
+                }
+              }
+              if( !found ) {
+                return false;
+              }
+              break;
+            }
+          }
+          keep(f);
+          *outV = f.v;
+          return true;
+        }
+
+        /**
+         * Runs GJK from the cached simplex (if any) until it converges or encloses the origin.
+         * @param[out] outV          Closest point of the Minkowski difference to the origin.
+         * @param[out] outIterations Number of support evaluations made.
+         * @return True if the shapes intersect; false otherwise.
+         */
+        template<typename SupportA, typename SupportB>
+        inline bool run( const SupportA& shapeA, const SupportB& shapeB, GjkSimplex<T>* cache, bool stopAtSeparation, Vec3<T>* outV, unsigned int* outIterations ) {
+          count = 0;
+          if( cache != nullptr ) {
+            for( unsigned int i = 0; i < cache->count; ++i ) {
+              support(shapeA, shapeB, cache->directions[i], count);
+              if( !isDuplicate(count) ) {
+                ++count;
+              }
+            }
+          }
+          if( count == 0 ) {
+            support(shapeA, shapeB, Vec3<T>(static_cast<T>(1), static_cast<T>(0), static_cast<T>(0)), 0);
+            count = 1;
+          }
+
+          const T eps = tolerance();
+          T prevSqrDist = std::numeric_limits<T>::max();
+          bool intersecting = false;
+          unsigned int iterations = 0;
+          Vec3<T> v;
+          GjkWorkSimplex<T> best = GjkWorkSimplex<T>();
+          for( ;; ) {
+            if( !solve(&v) ) {
+              intersecting = true;
+              break;
+            }
+            const T vv = v.sqrMagnitude();
+            // Touching, to within rounding of the vertices.
+            if( vv <= eps * eps * maxSqrMagnitude() ) {
+              intersecting = true;
+              break;
+            }
+            // No progress; rounding has stalled the search (or misclassified a nearly flat simplex), so fall back to the best one seen.
+            if( vv >= prevSqrDist ) {
+              *this = best;
+              v = best.w[0] * best.lambda[0];
+              for( unsigned int i = 1; i < count; ++i ) {
+                v += best.w[i] * best.lambda[i];
+              }
+              break;
+            }
+            if( iterations >= MAX_ITERATIONS ) {
+              break;
+            }
+            prevSqrDist = vv;
+            best = *this;
+
+            ++iterations;
+            support(shapeA, shapeB, -v, count);
+            const T vw = v.dot(w[count]);
+            if( stopAtSeparation && vw > static_cast<T>(0) ) {
+              break;
+            }
+            // The new vertex gets no closer to the origin than v already is.
+            if( vv - vw <= eps * vv || isDuplicate(count) ) {
+              break;
+            }
+            ++count;
+          }
+
+          if( cache != nullptr ) {
+            for( unsigned int i = 0; i < count; ++i ) {
+              cache->directions[i] = dir[i];
+            }
+            cache->count = count;
+          }
+          *outV = v;
+          *outIterations = iterations;
+          return intersecting;
+        }
+      };
+      /**
+       * Convex polytope grown by EPA.  Faces know their neighbours, so the faces removed when a vertex is added are
+       * found by walking outwards from the expanded face; the hole is always a single region and its boundary a
+       * single loop, which keeps the polytope closed even when many faces are (nearly) coplanar, as with boxes.
+       * Fixed capacity, so a query never allocates.
+       */
+      template<typename T>
+      struct EpaPolytope {
+        enum {
+          MAX_ITERATIONS = 128,
+          MAX_VERTICES = MAX_ITERATIONS + 4,
+          MAX_FACES = 2 * MAX_VERTICES // Closed triangulated polytope: F = 2V - 4.
+        };
+
+        // Edge e of a face runs from v[e] to v[(e + 1) % 3]; adj[e] is the face across it, and adjEdge[e] the same edge in that face.
+        struct Face {
+          unsigned int v[3];
+          unsigned int adj[3];
+          unsigned int adjEdge[3];
+          Vec3<T>      normal;
+          T            dist;
+          unsigned int mark;
+          bool         live;
+        };
+
+        struct HorizonEdge {
+          unsigned int face;
+          unsigned int edge;
+        };
+
+        Vec3<T>      w[MAX_VERTICES];
+        Vec3<T>      a[MAX_VERTICES];
+        Vec3<T>      b[MAX_VERTICES];
+        unsigned int vertexCount;
+        Face         faces[MAX_FACES];
+        unsigned int faceCount;
+        unsigned int freeFaces[MAX_FACES];
+        unsigned int freeCount;
+        HorizonEdge  horizon[MAX_FACES];
+        unsigned int horizonCount;
+        unsigned int visible[MAX_FACES];
+        unsigned int visibleCount;
+
+        inline EpaPolytope() : vertexCount(0), faceCount(0), freeCount(0), horizonCount(0), visibleCount(0) {}
+
+        template<typename SupportA, typename SupportB>
+        inline unsigned int addVertex( const SupportA& shapeA, const SupportB& shapeB, const Vec3<T>& direction ) {
+          a[vertexCount] = shapeA(direction);
+          b[vertexCount] = shapeB(-direction);
+          w[vertexCount] = a[vertexCount] - b[vertexCount];
+          return vertexCount++;
+        }
+
+        // Adds a face; its normal follows the counter-clockwise winding of i, j, k.
+        inline unsigned int addFace( unsigned int i, unsigned int j, unsigned int k ) {
+          const unsigned int idx = (freeCount > 0) ? freeFaces[--freeCount] : faceCount++;
+          Face& f = faces[idx];
+          f.v[0] = i; f.v[1] = j; f.v[2] = k;
+          f.mark = 0;
+          f.live = true;
+          const Vec3<T> n = (w[j] - w[i]).cross(w[k] - w[i]);
+          const T len = n.magnitude();
+          if( len > static_cast<T>(0) ) {
+            f.normal = n / len;
+            f.dist = f.normal.dot(w[i]);
+          } else {
+            // Sliver faces are never expanded.
+            f.normal = Vec3<T>(static_cast<T>(0));
+            f.dist = std::numeric_limits<T>::max();
+          }
+          return idx;
+        }
+
+        inline void link( unsigned int f, unsigned int e, unsigned int g, unsigned int ge ) {
+          faces[f].adj[e] = g;
+          faces[f].adjEdge[e] = ge;
+          faces[g].adj[ge] = f;
+          faces[g].adjEdge[ge] = e;
+        }
+
+        // Links every pair of faces sharing an edge.  Quadratic, so only used for the initial tetrahedron.
+        inline void linkAll() {
+          for( unsigned int f = 0; f < faceCount; ++f ) {
+            for( unsigned int g = f + 1; g < faceCount; ++g ) {
+              for( unsigned int e = 0; e < 3; ++e ) {
+                for( unsigned int ge = 0; ge < 3; ++ge ) {
+                  if( faces[f].v[e] == faces[g].v[(ge + 1) % 3] && faces[f].v[(e + 1) % 3] == faces[g].v[ge] ) {
+                    link(f, e, g, ge);
+                  }
+                }
+              }
+            }
+          }
+        }
+
+        inline unsigned int closestFace() const {
+          unsigned int closest = MAX_FACES;
+          for( unsigned int i = 0; i < faceCount; ++i ) {
+            if( faces[i].live && (closest == MAX_FACES || faces[i].dist < faces[closest].dist) ) {
+              closest = i;
+            }
+          }
+          return closest;
+        }
+
+        // Walks from a visible face across edge e of face f, collecting visible faces and the horizon around them.
+        inline void silhouette( unsigned int f, unsigned int e, const Vec3<T>& point, T tolerance, unsigned int stamp ) {
+          Face& face = faces[f];
+          if( face.mark == stamp ) {
+            return;
+          }
+          if( face.normal.dot(point - w[face.v[0]]) <= tolerance ) {
+            horizon[horizonCount].face = f;
+            horizon[horizonCount].edge = e;
+            ++horizonCount;
+            return;
+          }
+          face.mark = stamp;
+          visible[visibleCount++] = f;
+          silhouette(face.adj[(e + 1) % 3], face.adjEdge[(e + 1) % 3], point, tolerance, stamp);
+          silhouette(face.adj[(e + 2) % 3], face.adjEdge[(e + 2) % 3], point, tolerance, stamp);
+        }
+
+        // Replaces the faces visible from vertex p (starting with face f) by a fan of faces joining p to the horizon.
+        inline void expand( unsigned int f, unsigned int p, T tolerance, unsigned int stamp ) {
+          horizonCount = 0;
+          visibleCount = 0;
+          faces[f].mark = stamp;
+          visible[visibleCount++] = f;
+          for( unsigned int e = 0; e < 3; ++e ) {
+            silhouette(faces[f].adj[e], faces[f].adjEdge[e], w[p], tolerance, stamp);
+          }
+
+          for( unsigned int i = 0; i < visibleCount; ++i ) {
+            faces[visible[i]].live = false;
+            freeFaces[freeCount++] = visible[i];
+          }
+
+          unsigned int fan[MAX_FACES];
+          for( unsigned int h = 0; h < horizonCount; ++h ) {
+            const Face& outside = faces[horizon[h].face];
+            const unsigned int e = horizon[h].edge;
+            fan[h] = addFace(outside.v[(e + 1) % 3], outside.v[e], p);
+            link(fan[h], 0, horizon[h].face, e);
+          }
+          // Neighbouring fan faces share the edge between p and their common horizon vertex.
+          for( unsigned int h = 0; h < horizonCount; ++h ) {
+            for( unsigned int k = 0; k < horizonCount; ++k ) {
+              if( faces[fan[k]].v[0] == faces[fan[h]].v[1] ) {
+                link(fan[h], 1, fan[k], 2);
+                break;
+              }
+            }
+          }
+        }
+      };
+    } /* detail */
+
+    template<typename T, typename SupportA, typename SupportB>
+    inline T gjkDistance( const SupportA& shapeA, const SupportB& shapeB, GjkSimplex<T>* simplex, GjkResult<T>* outResult ) {
+      detail::GjkWorkSimplex<T> s;
+      Vec3<T> v;
+      unsigned int iterations;
+      const bool intersecting = s.run(shapeA, shapeB, simplex, false, &v, &iterations);
+      const T distance = intersecting ? static_cast<T>(0) : v.magnitude();
+
+      if( outResult != nullptr ) {
+        outResult->pointA = Vec3<T>(static_cast<T>(0));
+        outResult->pointB = Vec3<T>(static_cast<T>(0));
+        if( !intersecting ) {
+          for( unsigned int i = 0; i < s.count; ++i ) {
+            outResult->pointA += s.a[i] * s.lambda[i];
+            outResult->pointB += s.b[i] * s.lambda[i];
+          }
+        }
+        outResult->distance = distance;
+        outResult->iterations = iterations;
+        outResult->intersecting = intersecting;
+      }
+      return distance;
+    }
+
+    template<typename T, typename SupportA, typename SupportB>
+    inline bool gjkIntersects( const SupportA& shapeA, const SupportB& shapeB, GjkSimplex<T>* simplex ) {
+      detail::GjkWorkSimplex<T> s;
+      Vec3<T> v;
+      unsigned int iterations;
+      return s.run(shapeA, shapeB, simplex, true, &v, &iterations);
+    }
+
+    template<typename T, typename SupportA, typename SupportB>
+    inline bool epaPenetration( const SupportA& shapeA, const SupportB& shapeB, GjkSimplex<T>* simplex, EpaResult<T>* outResult ) {
+      typedef detail::EpaPolytope<T> Polytope;
+      typedef typename Polytope::Face Face;
+
+      if( outResult == nullptr ) {
+        return false;
+      }
+
+      detail::GjkWorkSimplex<T> s;
+      Vec3<T> v;
+      unsigned int gjkIterations;
+      if( !s.run(shapeA, shapeB, simplex, false, &v, &gjkIterations) ) {
+        return false;
+      }
+
+      Polytope poly;
+      for( unsigned int i = 0; i < s.count; ++i ) {
+        poly.w[i] = s.w[i];
+        poly.a[i] = s.a[i];
+        poly.b[i] = s.b[i];
+      }
+      poly.vertexCount = s.count;
+
+      // GJK stops with fewer than four vertices when the shapes just touch; blow the simplex up into a tetrahedron.
+      const T eps = std::sqrt(std::numeric_limits<T>::epsilon());
+      const T zero = static_cast<T>(0);
+      const T one = static_cast<T>(1);
+      if( poly.vertexCount == 1 ) {
+        const Vec3<T> axes[6] = { Vec3<T>(one, zero, zero), Vec3<T>(-one, zero, zero), Vec3<T>(zero, one, zero),
+                                  Vec3<T>(zero, -one, zero), Vec3<T>(zero, zero, one), Vec3<T>(zero, zero, -one) };
+        for( unsigned int i = 0; i < 6 && poly.vertexCount == 1; ++i ) {
+          const unsigned int idx = poly.addVertex(shapeA, shapeB, axes[i]);
+          if( poly.w[idx].sqrDistance(poly.w[0]) <= eps * eps ) {
+            --poly.vertexCount;
+          }
+        }
+      }
+      if( poly.vertexCount == 2 ) {
+        const Vec3<T> line = (poly.w[1] - poly.w[0]).normalized();
+        const Vec3<T> axis = (std::abs(line.x) < std::abs(line.y)) ? ((std::abs(line.x) < std::abs(line.z)) ? Vec3<T>(one, zero, zero) : Vec3<T>(zero, zero, one))
+                                                                   : ((std::abs(line.y) < std::abs(line.z)) ? Vec3<T>(zero, one, zero) : Vec3<T>(zero, zero, one));
+        const Vec3<T> p = line.cross(axis).normalized();
+        const Vec3<T> q = line.cross(p);
+        const Vec3<T> dirs[4] = { p, -p, q, -q };
+        for( unsigned int i = 0; i < 4 && poly.vertexCount == 2; ++i ) {
+          const unsigned int idx = poly.addVertex(shapeA, shapeB, dirs[i]);
+          if( line.cross(poly.w[idx] - poly.w[0]).magnitude() <= eps ) {
+            --poly.vertexCount;
+          }
+        }
+      }
+      if( poly.vertexCount == 3 ) {
+        const Vec3<T> n = (poly.w[1] - poly.w[0]).cross(poly.w[2] - poly.w[0]).normalized();
+        for( unsigned int i = 0; i < 2 && poly.vertexCount == 3; ++i ) {
+          const unsigned int idx = poly.addVertex(shapeA, shapeB, (i == 0) ? n : -n);
+          if( std::abs(n.dot(poly.w[idx] - poly.w[0])) <= eps ) {
+            --poly.vertexCount;
+          }
+        }
+      }
+      if( poly.vertexCount < 4 ) {
+        return false;
+      }
+
+      // Initial tetrahedron, with every face wound outwards.
+      static const unsigned int tetra[4][4] = { {0, 1, 2, 3}, {0, 3, 1, 2}, {0, 2, 3, 1}, {1, 3, 2, 0} };
+      for( unsigned int i = 0; i < 4; ++i ) {
+        const unsigned int* t = tetra[i];
+        if( (poly.w[t[1]] - poly.w[t[0]]).cross(poly.w[t[2]] - poly.w[t[0]]).dot(poly.w[t[3]] - poly.w[t[0]]) > zero ) {
+          poly.addFace(t[0], t[2], t[1]);
+        } else {
+          poly.addFace(t[0], t[1], t[2]);
+        }
+        // The origin is outside (or on) the tetrahedron: the shapes only touch.
+        if( poly.faces[i].dist < -eps ) {
+          return false;
+        }
+      }
+      poly.linkAll();
+
+      // The closest face only moves outwards.  If rounding folds the polytope (the closest face jumps inwards),
+      // stop and report the last good face; its vertices are never removed, so a copy stays valid.
+      unsigned int iterations = 0;
+      Face face = poly.faces[poly.closestFace()];
+      while( iterations < Polytope::MAX_ITERATIONS && poly.vertexCount < Polytope::MAX_VERTICES ) {
+        const unsigned int idx = poly.addVertex(shapeA, shapeB, face.normal);
+        const T tolerance = eps * ((face.dist > one) ? face.dist : one);
+        if( face.normal.dot(poly.w[idx]) - face.dist <= tolerance ) {
+          --poly.vertexCount;
+          break;
+        }
+        ++iterations;
+        poly.expand(poly.closestFace(), idx, tolerance, iterations);
+        const Face& next = poly.faces[poly.closestFace()];
+        if( next.dist < face.dist - tolerance ) {
+          break;
+        }
+        face = next;
+      }
+
+      if( !(face.dist > zero) || face.dist == std::numeric_limits<T>::max() ) {
+        return false;
+      }
+
+      // The origin projects onto the closest face; its barycentrics map back onto both shapes.
+      Vec3<T> bary;
+      closestPointOnTriangle(face.normal * face.dist, poly.w[face.v[0]], poly.w[face.v[1]], poly.w[face.v[2]], &bary);
+      outResult->normal = face.normal;
+      outResult->depth = face.dist;
+      outResult->pointA = poly.a[face.v[0]] * bary.x + poly.a[face.v[1]] * bary.y + poly.a[face.v[2]] * bary.z;
+      outResult->pointB = poly.b[face.v[0]] * bary.x + poly.b[face.v[1]] * bary.y + poly.b[face.v[2]] * bary.z;
+      outResult->iterations = iterations;
+      return true;
+    }
+
+    template<typename T>
+    inline Vec3<T> SphereSupport<T>::operator()( const Vec3<T>& direction ) const {
+      const T len2 = direction.sqrMagnitude();
+      if( len2 <= static_cast<T>(0) ) {
+        return center;
+      }
+      return center + direction * (radius / static_cast<T>(std::sqrt(len2)));
+    }
+
+    template<typename T>
+    inline Vec3<T> CapsuleSupport<T>::operator()( const Vec3<T>& direction ) const {
+      const Vec3<T>& end = (direction.dot(a) >= direction.dot(b)) ? a : b;
+      const T len2 = direction.sqrMagnitude();
+      if( len2 <= static_cast<T>(0) ) {
+        return end;
+      }
+      return end + direction * (radius / static_cast<T>(std::sqrt(len2)));
+    }
+
+    template<typename T>
+    inline Vec3<T> AabbSupport<T>::operator()( const Vec3<T>& direction ) const {
+      return Vec3<T>((direction.x >= static_cast<T>(0)) ? box.boundsMax.x : box.boundsMin.x,
+                     (direction.y >= static_cast<T>(0)) ? box.boundsMax.y : box.boundsMin.y,
+                     (direction.z >= static_cast<T>(0)) ? box.boundsMax.z : box.boundsMin.z);
+    }
+
+    template<typename T>
+    inline Vec3<T> PointsSupport<T>::operator()( const Vec3<T>& direction ) const {
+      if( points.empty() ) {
+        return Vec3<T>(static_cast<T>(0));
+      }
+      std::size_t best = 0;
+      T bestDot = direction.dot(points[0]);
+      for( std::size_t i = 1; i < points.size(); ++i ) {
+        const T d = direction.dot(points[i]);
+        if( d > bestDot ) {
+          bestDot = d;
+          best = i;
+        }
+      }
+      return points[best];
+    }
+  } /* math */
+} /* cc */
@@ -1,13 +1,24 @@
 #ifndef __CC_MATH_INTERSECTION__
 #define	__CC_MATH_INTERSECTION__
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <random>
 #include <vector>
 #include "Vec3.hpp"
+#include "Vec3Soa.hpp"
+#include "ClosestPoint.hpp"
+#include "Distance.hpp"
+#include "Parallel.hpp"
+#include "StridedSpan.hpp"
 
 namespace cc {
   namespace math {
     /**
      * Test if a point is inside a triangle.
+     * To test many points against the same triangle, PreparedTriangle avoids redoing the setup and square roots.
      * @param[in] p  Point to test.
      * @param[in] t0 First vertex of the triangle.
      * @param[in] t1 Second vertex of the triangle.
@@ -76,68 +87,180 @@ namespace cc {
       return dist < -sphereRadius;
     }
     
+    /**
+     * Find the indices of the extreme points along each major axis.  Ties resolve to the lowest index.
+     * Large inputs are split across threads; each thread scans four points per step in independent lanes.
+     * @param[in]  points Points to search; must not be empty.
+     * @param[out] outMin Indices of the points with the smallest x, y and z.
+     * @param[out] outMax Indices of the points with the largest x, y and z.
+     */
+    template<typename T>
+    inline void extremePointsAlongAxes( StridedSpan<const Vec3<T> > points, unsigned int outMin[3], unsigned int outMax[3] ) {
+      static_assert(sizeof(Vec3<T>) == sizeof(T) * 3, "Vec3 must be tightly packed");
+
+      struct Extremes {
+        T            lo[3];
+        T            hi[3];
+        unsigned int loIdx[3];
+        unsigned int hiIdx[3];
+
+        // Keeps the smaller (larger) value; on a tie, the lower index.
+        inline void merge( unsigned int axis, T loVal, unsigned int loI, T hiVal, unsigned int hiI ) {
+          if( loVal < lo[axis] || (loVal == lo[axis] && loI < loIdx[axis]) ) {
+            lo[axis] = loVal;
+            loIdx[axis] = loI;
+          }
+          if( hiVal > hi[axis] || (hiVal == hi[axis] && hiI < hiIdx[axis]) ) {
+            hi[axis] = hiVal;
+            hiIdx[axis] = hiI;
+          }
+        }
+
+        static inline Extremes scan( const StridedSpan<const Vec3<T> >& points, unsigned int begin, unsigned int end ) {
+          enum { LANES = 12 }; // Four points of three components.
+          T lo[LANES], hi[LANES];
+          unsigned int loI[LANES], hiI[LANES];
+          for( unsigned int k = 0; k < LANES; ++k ) {
+            lo[k] = hi[k] = points[begin][k % 3];
+            loI[k] = hiI[k] = begin;
+          }
+
+          // Contiguous points are read in place; strided points are gathered into the same lane layout first.
+          const bool contiguous = points.isContiguous();
+          T gathered[LANES];
+          const unsigned int blocks = (end - begin) / 4;
+          for( unsigned int b = 0; b < blocks; ++b ) {
+            const unsigned int first = begin + b * 4;
+            const T* p = gathered;
+            if( contiguous ) {
+              p = &points[first].x;
+            } else {
+              for( unsigned int j = 0; j < 4; ++j ) {
+                gathered[j * 3 + 0] = points[first + j].x;
+                gathered[j * 3 + 1] = points[first + j].y;
+                gathered[j * 3 + 2] = points[first + j].z;
+              }
+            }
+            for( unsigned int k = 0; k < LANES; ++k ) {
+              const bool lower = p[k] < lo[k];
+              const bool higher = p[k] > hi[k];
+              lo[k] = lower ? p[k] : lo[k];
+              loI[k] = lower ? first + k / 3 : loI[k];
+              hi[k] = higher ? p[k] : hi[k];
+              hiI[k] = higher ? first + k / 3 : hiI[k];
+            }
+          }
+
+          Extremes result;
+          for( unsigned int axis = 0; axis < 3; ++axis ) {
+            result.lo[axis] = result.hi[axis] = points[begin][axis];
+            result.loIdx[axis] = result.hiIdx[axis] = begin;
+          }
+          for( unsigned int k = 0; k < LANES; ++k ) {
+            result.merge(k % 3, lo[k], loI[k], hi[k], hiI[k]);
+          }
+          for( unsigned int i = begin + blocks * 4; i < end; ++i ) {
+            for( unsigned int axis = 0; axis < 3; ++axis ) {
+              result.merge(axis, points[i][axis], i, points[i][axis], i);
+            }
+          }
+          return result;
+        }
+      };
+
+      std::vector<Extremes> partial(parallelThreadCount());
+      const unsigned int chunks = parallelFor(points.size(), 1 << 16, [&]( std::size_t begin, std::size_t end, unsigned int chunk ) {
+        partial[chunk] = Extremes::scan(points, static_cast<unsigned int>(begin), static_cast<unsigned int>(end));
+      });
+
+      Extremes result = partial[0];
+      for( unsigned int i = 1; i < chunks; ++i ) {
+        for( unsigned int axis = 0; axis < 3; ++axis ) {
+          result.merge(axis, partial[i].lo[axis], partial[i].loIdx[axis], partial[i].hi[axis], partial[i].hiIdx[axis]);
+        }
+      }
+      for( unsigned int axis = 0; axis < 3; ++axis ) {
+        outMin[axis] = result.loIdx[axis];
+        outMax[axis] = result.hiIdx[axis];
+      }
+    }
+
     // Find the indices of the most separated points on an AABB of a vector of points.
     /**
      * Find the indices of the most separated points on an AABB constructed by a list of points.
-     * @param[in]  points    Vector of points.
-     * @param[out] outMinIdx Index of the minimum extents in the vector along the picked axis.
-     * @param[out] outMaxIdx Index of the maximum extents in the vector along the picked axis.
+     * @param[in]  points    Points; may be strided, e.g. positions inside an interleaved vertex buffer.
+     * @param[out] outMinIdx Index of the minimum extents in the points along the picked axis.
+     * @param[out] outMaxIdx Index of the maximum extents in the points along the picked axis.
      */
     template<typename T>
-    inline void mostSeparatedPointsOnAabb( const std::vector<Vec3<T> >& points, int* outMinIdx, int* outMaxIdx ) {
+    inline void mostSeparatedPointsOnAabb( StridedSpan<const Vec3<T> > points, int* outMinIdx, int* outMaxIdx ) {
       // Safety check.
-      if( outMinIdx == nullptr || outMaxIdx == nullptr ) {
+      if( outMinIdx == nullptr || outMaxIdx == nullptr || points.empty() ) {
         return;
       }
       
       // Find the most extreme points along three major axis (X,Y,Z).
-      int minX = 0; int maxX = 0;
-      int minY = 0; int maxY = 0;
-      int minZ = 0; int maxZ = 0;
-      for( unsigned int i = 1; i < points.size(); ++i ) // Start at 1 'cause zero is the default for all of the values.
-      {
-        // Current point.
-        const Vec3<T>* const pt = &points[i];
-
-        // Update min/max.
-        minX = (pt->x < points[minX].x) ? i : minX;
-        maxX = (pt->x > points[maxX].x) ? i : maxX;
-        minY = (pt->y < points[minY].y) ? i : minY;
-        maxY = (pt->y > points[maxY].y) ? i : maxY;
-        minZ = (pt->z < points[minZ].z) ? i : minZ;
-        maxZ = (pt->z > points[maxZ].z) ? i : maxZ;
-      }
+      unsigned int mins[3];
+      unsigned int maxs[3];
+      extremePointsAlongAxes(points, mins, maxs);
 
       // Compute squared distances for the three pairs of points.
-      const float dist2x = (points[maxX] - points[minX]).dot(points[maxX] - points[minX]);
-      const float dist2y = (points[maxY] - points[minY]).dot(points[maxY] - points[minY]);
-      const float dist2z = (points[maxZ] - points[minZ]).dot(points[maxZ] - points[minZ]);
+      const T dist2x = points[maxs[0]].sqrDistance(points[mins[0]]);
+      const T dist2y = points[maxs[1]].sqrDistance(points[mins[1]]);
+      const T dist2z = points[maxs[2]].sqrDistance(points[mins[2]]);
 
       // Pick the pair that are the most distant.
-      *outMinIdx = minX;
-      *outMaxIdx = maxX;
+      *outMinIdx = static_cast<int>(mins[0]);
+      *outMaxIdx = static_cast<int>(maxs[0]);
       if( dist2y > dist2x && dist2y > dist2z )
       {
-        *outMinIdx = minY;
-        *outMaxIdx = maxY;
+        *outMinIdx = static_cast<int>(mins[1]);
+        *outMaxIdx = static_cast<int>(maxs[1]);
       }
       if( dist2z > dist2x && dist2z > dist2y )
       {
-        *outMinIdx = minZ;
-        *outMaxIdx = maxZ;
+        *outMinIdx = static_cast<int>(mins[2]);
+        *outMaxIdx = static_cast<int>(maxs[2]);
       }
     }
-    
+
+    template<typename T>
+    inline void mostSeparatedPointsOnAabb( const std::vector<Vec3<T> >& points, int* outMinIdx, int* outMaxIdx ) {
+      mostSeparatedPointsOnAabb(StridedSpan<const Vec3<T> >(points), outMinIdx, outMaxIdx);
+    }
+
+    /**
+     * Grows a sphere just enough to enclose a point (a single step of Ritter's algorithm).
+     * @param[in,out] spherePos    Position of the sphere.
+     * @param[in,out] sphereRadius Radius of the sphere.
+     * @param[in]     point        Point to enclose.
+     */
+    template<typename T>
+    inline void growSphereToPoint( Vec3<T>* spherePos, T* sphereRadius, const Vec3<T>& point ) {
+      const Vec3<T> d = point - *spherePos;
+      const T dist2 = d.sqrMagnitude();
+      if( dist2 <= (*sphereRadius) * (*sphereRadius) ) {
+        return;
+      }
+      const T dist = static_cast<T>(sqrt(dist2));
+      const T newRadius = (*sphereRadius + dist) * static_cast<T>(0.5);
+      *spherePos += d * ((newRadius - *sphereRadius) / dist);
+      *sphereRadius = newRadius;
+    }
+
     /**
-     * Create a sphere from a vector of points.
-     * @param[in]  points          Vector of points.
+     * Create a sphere from a vector of points (Ritter's algorithm).  The sphere starts from the most separated
+     * pair of points on their AABB and is then grown until it encloses every point.  This takes a few passes
+     * over the points: each finds the farthest point with a vectorized, multithreaded scan and grows towards it,
+     * and a final sequential Ritter pass guarantees containment.  The result is typically 5-20% larger than minimal.
+     * @param[in]  points          Points; may be strided, e.g. positions inside an interleaved vertex buffer.
      * @param[out] outSpherePos    Position of the center of the resulting sphere.
      * @param[out] outSphereRadius Radius of the resulting sphere.
      */
     template<typename T>
-    inline void createSphereFromPoints( const std::vector<Vec3<T> >& points, Vec3<T>* outSpherePos, T* outSphereRadius ) {
+    inline void createSphereFromPoints( StridedSpan<const Vec3<T> > points, Vec3<T>* outSpherePos, T* outSphereRadius ) {
       // Safety check.
-      if( outSpherePos == nullptr || outSphereRadius == nullptr ) {
+      if( outSpherePos == nullptr || outSphereRadius == nullptr || points.empty() ) {
         return;
       }
       
@@ -146,9 +269,156 @@ namespace cc {
       mostSeparatedPointsOnAabb<T>(points, &min, &max);
 
       // Compute the center point and the radius.
-      *outSpherePos = (points[min] + points[max]) * 0.5f;
-      *outSphereRadius = (points[max] - *outSpherePos).dot(points[max] - *outSpherePos);
-      *outSphereRadius = sqrt(*outSphereRadius);
+      *outSpherePos = (points[min] + points[max]) * static_cast<T>(0.5);
+      *outSphereRadius = static_cast<T>(sqrt(points[max].sqrDistance(*outSpherePos)));
+
+      // Grow towards the farthest point while it is outside; most inputs settle within a couple of passes.
+      const unsigned int FARTHEST_PASSES = 4;
+      for( unsigned int pass = 0; pass < FARTHEST_PASSES; ++pass ) {
+        T dist2;
+        const std::size_t far = farthestPoint(points, *outSpherePos, &dist2);
+        if( dist2 <= (*outSphereRadius) * (*outSphereRadius) ) {
+          return;
+        }
+        growSphereToPoint(outSpherePos, outSphereRadius, points[far]);
+      }
+
+      // Sequential pass; after it every point is inside.
+      for( std::size_t i = 0; i < points.size(); ++i ) {
+        growSphereToPoint(outSpherePos, outSphereRadius, points[i]);
+      }
+    }
+
+    template<typename T>
+    inline void createSphereFromPoints( const std::vector<Vec3<T> >& points, Vec3<T>* outSpherePos, T* outSphereRadius ) {
+      createSphereFromPoints(StridedSpan<const Vec3<T> >(points), outSpherePos, outSphereRadius);
+    }
+
+    /**
+     * Create the minimum bounding sphere of a vector of points (Welzl's algorithm, in its randomized
+     * incremental form).  Runs in expected linear time on a shuffled copy of the points.
+     * @param[in]  points          Points; may be strided, e.g. positions inside an interleaved vertex buffer.
+     * @param[out] outSpherePos    Position of the center of the resulting sphere.
+     * @param[out] outSphereRadius Radius of the resulting sphere.
+     */
+    template<typename T>
+    inline void createMinimumSphereFromPoints( StridedSpan<const Vec3<T> > points, Vec3<T>* outSpherePos, T* outSphereRadius ) {
+      if( outSpherePos == nullptr || outSphereRadius == nullptr || points.empty() ) {
+        return;
+      }
+
+      struct Local {
+        // Spheres store their squared radius and accept points within a small relative tolerance.
+        static inline bool outside( const Vec3<T>& p, const Vec3<T>& c, T r2 ) {
+          return p.sqrDistance(c) > r2 * (static_cast<T>(1) + static_cast<T>(1e-5)) + static_cast<T>(1e-12);
+        }
+
+        static inline void sphere2( const Vec3<T>& a, const Vec3<T>& b, Vec3<T>* c, T* r2 ) {
+          *c = (a + b) * static_cast<T>(0.5);
+          *r2 = a.sqrDistance(*c);
+        }
+
+        // Circumsphere of a triangle; falls back to the longest edge when the points are collinear.
+        static inline void sphere3( const Vec3<T>& a, const Vec3<T>& b, const Vec3<T>& d, Vec3<T>* c, T* r2 ) {
+          const Vec3<T> ab = b - a;
+          const Vec3<T> ad = d - a;
+          const Vec3<T> n = ab.cross(ad);
+          const T denom = static_cast<T>(2) * n.sqrMagnitude();
+          if( denom <= static_cast<T>(EPSILON) * ab.sqrMagnitude() * ad.sqrMagnitude() ) {
+            const T lab = ab.sqrMagnitude();
+            const T lad = ad.sqrMagnitude();
+            const T lbd = b.sqrDistance(d);
+            if( lab >= lad && lab >= lbd ) { sphere2(a, b, c, r2); }
+            else if( lad >= lbd ) { sphere2(a, d, c, r2); }
+            else { sphere2(b, d, c, r2); }
+            return;
+          }
+          const Vec3<T> offset = (n.cross(ab) * ad.sqrMagnitude() + ad.cross(n) * ab.sqrMagnitude()) / denom;
+          *c = a + offset;
+          *r2 = offset.sqrMagnitude();
+        }
+
+        // Circumsphere of a tetrahedron; falls back to the smallest enclosing triangle sphere when the points are coplanar.
+        static inline void sphere4( const Vec3<T>& a, const Vec3<T>& b, const Vec3<T>& d, const Vec3<T>& e, Vec3<T>* c, T* r2 ) {
+          const Vec3<T> ab = b - a;
+          const Vec3<T> ad = d - a;
+          const Vec3<T> ae = e - a;
+          const T det = static_cast<T>(2) * ab.dot(ad.cross(ae));
+          const T scale = ab.magnitude() * ad.magnitude() * ae.magnitude();
+          if( det > static_cast<T>(EPSILON) * scale || det < -static_cast<T>(EPSILON) * scale ) {
+            const Vec3<T> offset = (ad.cross(ae) * ab.sqrMagnitude() + ae.cross(ab) * ad.sqrMagnitude() + ab.cross(ad) * ae.sqrMagnitude()) / det;
+            *c = a + offset;
+            *r2 = offset.sqrMagnitude();
+            return;
+          }
+
+          const Vec3<T>* const pts[4] = { &a, &b, &d, &e };
+          bool found = false;
+          for( unsigned int skip = 0; skip < 4; ++skip ) {
+            const Vec3<T>* tri[3];
+            unsigned int n = 0;
+            for( unsigned int i = 0; i < 4; ++i ) {
+              if( i != skip ) tri[n++] = pts[i];
+            }
+            Vec3<T> tc; T tr2;
+            sphere3(*tri[0], *tri[1], *tri[2], &tc, &tr2);
+            if( !outside(*pts[skip], tc, tr2) && (!found || tr2 < *r2) ) {
+              *c = tc;
+              *r2 = tr2;
+              found = true;
+            }
+          }
+          if( !found ) {
+            sphere3(a, b, d, c, r2);
+          }
+        }
+      };
+
+      // Shuffle a copy so the expected number of sphere rebuilds stays constant per point.
+      std::vector<Vec3<T> > pts(points.size());
+      for( std::size_t i = 0; i < points.size(); ++i ) {
+        pts[i] = points[i];
+      }
+      std::mt19937 mt(0x5EED5EEDu);
+      std::shuffle(pts.begin(), pts.end(), mt);
+
+      Vec3<T> c = pts[0];
+      T r2 = static_cast<T>(0);
+      for( std::size_t i = 1; i < pts.size(); ++i ) {
+        if( !Local::outside(pts[i], c, r2) ) {
+          continue;
+        }
+        // pts[i] lies on the boundary of the minimum sphere of pts[0..i].
+        c = pts[i]; r2 = static_cast<T>(0);
+        for( std::size_t j = 0; j < i; ++j ) {
+          if( !Local::outside(pts[j], c, r2) ) {
+            continue;
+          }
+          Local::sphere2(pts[i], pts[j], &c, &r2);
+          for( std::size_t k = 0; k < j; ++k ) {
+            if( !Local::outside(pts[k], c, r2) ) {
+              continue;
+            }
+            Local::sphere3(pts[i], pts[j], pts[k], &c, &r2);
+            for( std::size_t l = 0; l < k; ++l ) {
+              if( Local::outside(pts[l], c, r2) ) {
+                Local::sphere4(pts[i], pts[j], pts[k], pts[l], &c, &r2);
+              }
+            }
+          }
+        }
+      }
+
+      // Absorb any rounding so every point is reported inside.
+      T maxDist2;
+      farthestPoint(points, c, &maxDist2);
+      *outSpherePos = c;
+      *outSphereRadius = static_cast<T>(sqrt((maxDist2 > r2) ? maxDist2 : r2));
+    }
+
+    template<typename T>
+    inline void createMinimumSphereFromPoints( const std::vector<Vec3<T> >& points, Vec3<T>* outSpherePos, T* outSphereRadius ) {
+      createMinimumSphereFromPoints(StridedSpan<const Vec3<T> >(points), outSpherePos, outSphereRadius);
     }
     
     // Test if a point is in a sphere.
@@ -172,8 +442,557 @@ namespace cc {
       
       return intersects;
     }
+
+    /**
+     * Test if a ray intersects a triangle (Moller-Trumbore).  Back faces are also reported.
+     * @param[in]  origin    Origin of the ray.
+     * @param[in]  direction Direction of the ray (need not be normalized).
+     * @param[in]  t0        First vertex of the triangle.
+     * @param[in]  t1        Second vertex of the triangle.
+     * @param[in]  t2        Third vertex of the triangle.
+     * @param[out] outT      Distance along the ray in multiples of direction.  Optional.
+     * @param[out] outU      Barycentric weight of t1 at the hit point.  Optional.
+     * @param[out] outV      Barycentric weight of t2 at the hit point.  Optional.
+     * @return True if the ray hits the triangle at a non-negative distance; false otherwise.
+     */
+    template<typename T>
+    inline bool rayIntersectsTriangle( const Vec3<T>& origin, const Vec3<T>& direction, const Vec3<T>& t0, const Vec3<T>& t1, const Vec3<T>& t2, T* outT, T* outU, T* outV ) {
+      const Vec3<T> e1 = t1 - t0;
+      const Vec3<T> e2 = t2 - t0;
+      const Vec3<T> p = direction.cross(e2);
+      const T det = e1.dot(p);
+      // Ray is parallel to the triangle's plane.
+      if( det == static_cast<T>(0) ) {
+        return false;
+      }
+      const T invDet = static_cast<T>(1) / det;
+
+      const Vec3<T> s = origin - t0;
+      const T u = s.dot(p) * invDet;
+      if( u < static_cast<T>(0) || u > static_cast<T>(1) ) {
+        return false;
+      }
+
+      const Vec3<T> q = s.cross(e1);
+      const T v = direction.dot(q) * invDet;
+      if( v < static_cast<T>(0) || u + v > static_cast<T>(1) ) {
+        return false;
+      }
+
+      const T t = e2.dot(q) * invDet;
+      if( t < static_cast<T>(0) ) {
+        return false;
+      }
+
+      if( outT != nullptr ) {
+        *outT = t;
+      }
+      if( outU != nullptr ) {
+        *outU = u;
+      }
+      if( outV != nullptr ) {
+        *outV = v;
+      }
+      return true;
+    }
+
+    /**
+     * Test if a ray intersects a sphere.
+     * Real-Time Collision Detection - Section 5.3.2
+     * @param[in]  origin    Origin of the ray.
+     * @param[in]  direction Direction of the ray (need not be normalized).
+     * @param[in]  center    Center of the sphere.
+     * @param[in]  radius    Radius of the sphere.
+     * @param[out] outT      Distance along the ray to the first hit, in multiples of direction; 0 if the origin is inside.  Optional.
+     * @return True if the ray hits the sphere at a non-negative distance; false otherwise.
+     */
+    template<typename T>
+    inline bool rayIntersectsSphere( const Vec3<T>& origin, const Vec3<T>& direction, const Vec3<T>& center, T radius, T* outT ) {
+      const Vec3<T> m = origin - center;
+      const T a = direction.dot(direction);
+      const T b = m.dot(direction);
+      const T c = m.dot(m) - radius * radius;
+      // Origin outside and pointing away.
+      if( c > static_cast<T>(0) && b > static_cast<T>(0) ) {
+        return false;
+      }
+      // A negative discriminant means the ray misses; a zero direction only hits from inside.
+      const T disc = b * b - a * c;
+      if( disc < static_cast<T>(0) || (a == static_cast<T>(0) && c > static_cast<T>(0)) ) {
+        return false;
+      }
+      if( outT != nullptr ) {
+        const T t = (a > static_cast<T>(0)) ? (-b - std::sqrt(disc)) / a : static_cast<T>(0);
+        *outT = (t > static_cast<T>(0)) ? t : static_cast<T>(0);
+      }
+      return true;
+    }
+
+    /**
+     * Test if a ray intersects an axis-aligned box (slab test).
+     * @param[in]  origin    Origin of the ray.
+     * @param[in]  direction Direction of the ray (need not be normalized).
+     * @param[in]  boxMin    Minimum corner of the box.
+     * @param[in]  boxMax    Maximum corner of the box.
+     * @param[out] outTNear  Distance along the ray where it enters the box, in multiples of direction; 0 if the origin is inside.  Optional.
+     * @param[out] outTFar   Distance along the ray where it leaves the box.  Optional.
+     * @return True if the ray hits the box at a non-negative distance; false otherwise.
+     */
+    template<typename T>
+    inline bool rayIntersectsAabb( const Vec3<T>& origin, const Vec3<T>& direction, const Vec3<T>& boxMin, const Vec3<T>& boxMax, T* outTNear, T* outTFar ) {
+      const Vec3<T> invDir = static_cast<T>(1) / direction;
+      T tNear = static_cast<T>(0);
+      T tFar = std::numeric_limits<T>::max();
+      for( unsigned int i = 0; i < 3; ++i ) {
+        const T t1 = (boxMin[i] - origin[i]) * invDir[i];
+        const T t2 = (boxMax[i] - origin[i]) * invDir[i];
+        tNear = std::max(tNear, std::min(t1, t2));
+        tFar = std::min(tFar, std::max(t1, t2));
+      }
+      if( tNear > tFar ) {
+        return false;
+      }
+      if( outTNear != nullptr ) {
+        *outTNear = tNear;
+      }
+      if( outTFar != nullptr ) {
+        *outTFar = tFar;
+      }
+      return true;
+    }
+
+    /**
+     * Test N rays against one axis-aligned box at once, e.g. a ray packet against a BVH node.
+     * Each lane is a slab test on the precomputed inverse direction, with no branches.
+     * @param[in]  origins  Origins of the rays.
+     * @param[in]  invDirs  Componentwise inverse of each ray's direction, 1 / direction.
+     * @param[in]  boxMin   Minimum corner of the box.
+     * @param[in]  boxMax   Maximum corner of the box.
+     * @param[in]  maxT     Farthest distance of interest along each ray, e.g. its closest hit so far.  N entries.
+     * @param[out] outTNear Distance along each ray where it enters the box; 0 if its origin is inside.  Only meaningful in lanes that hit.  Optional; N entries.
+     * @return Bitmask with bit k set if lane k's ray hits the box between 0 and maxT[k].
+     */
+    template<typename T, unsigned int N>
+    inline unsigned int rayIntersectsAabb( const Vec3Soa<T, N>& origins, const Vec3Soa<T, N>& invDirs, const Vec3<T>& boxMin, const Vec3<T>& boxMax, const T* maxT, T* outTNear ) {
+      static_assert(N <= 32, "Lane mask is 32 bits");
+      T tNear[N];
+      T tFar[N];
+      for( unsigned int k = 0; k < N; ++k ) {
+        tNear[k] = static_cast<T>(0);
+        tFar[k] = maxT[k];
+      }
+      // Axis-major so each pass is a straight run over the lanes.
+      const T* const o[3] = { origins.x, origins.y, origins.z };
+      const T* const inv[3] = { invDirs.x, invDirs.y, invDirs.z };
+      for( unsigned int i = 0; i < 3; ++i ) {
+        for( unsigned int k = 0; k < N; ++k ) {
+          const T t1 = (boxMin[i] - o[i][k]) * inv[i][k];
+          const T t2 = (boxMax[i] - o[i][k]) * inv[i][k];
+          tNear[k] = std::max(tNear[k], std::min(t1, t2));
+          tFar[k] = std::min(tFar[k], std::max(t1, t2));
+        }
+      }
+      unsigned int mask = 0;
+      for( unsigned int k = 0; k < N; ++k ) {
+        mask |= (tNear[k] <= tFar[k]) ? (1u << k) : 0u;
+      }
+      if( outTNear != nullptr ) {
+        std::copy(tNear, tNear + N, outTNear);
+      }
+      return mask;
+    }
+
+    /**
+     * Test one ray against N axis-aligned boxes at once, e.g. the children of a wide BVH node.
+     * Each lane is a slab test on the precomputed inverse direction, with no branches.
+     * @param[in]  origin   Origin of the ray.
+     * @param[in]  invDir   Componentwise inverse of the ray's direction, 1 / direction.
+     * @param[in]  boxMin   Minimum corners of the boxes.
+     * @param[in]  boxMax   Maximum corners of the boxes.
+     * @param[in]  maxT     Farthest distance of interest along the ray, e.g. its closest hit so far.
+     * @param[out] outTNear Distance along the ray where it enters each box; 0 if its origin is inside.  Only meaningful in lanes that hit.  Optional; N entries.
+     * @return Bitmask with bit k set if the ray hits lane k's box between 0 and maxT.
+     */
+    template<typename T, unsigned int N>
+    inline unsigned int rayIntersectsAabb( const Vec3<T>& origin, const Vec3<T>& invDir, const Vec3Soa<T, N>& boxMin, const Vec3Soa<T, N>& boxMax, T maxT, T* outTNear ) {
+      static_assert(N <= 32, "Lane mask is 32 bits");
+      T tNear[N];
+      T tFar[N];
+      for( unsigned int k = 0; k < N; ++k ) {
+        tNear[k] = static_cast<T>(0);
+        tFar[k] = maxT;
+      }
+      const T* const lo[3] = { boxMin.x, boxMin.y, boxMin.z };
+      const T* const hi[3] = { boxMax.x, boxMax.y, boxMax.z };
+      for( unsigned int i = 0; i < 3; ++i ) {
+        for( unsigned int k = 0; k < N; ++k ) {
+          const T t1 = (lo[i][k] - origin[i]) * invDir[i];
+          const T t2 = (hi[i][k] - origin[i]) * invDir[i];
+          tNear[k] = std::max(tNear[k], std::min(t1, t2));
+          tFar[k] = std::min(tFar[k], std::max(t1, t2));
+        }
+      }
+      unsigned int mask = 0;
+      for( unsigned int k = 0; k < N; ++k ) {
+        mask |= (tNear[k] <= tFar[k]) ? (1u << k) : 0u;
+      }
+      if( outTNear != nullptr ) {
+        std::copy(tNear, tNear + N, outTNear);
+      }
+      return mask;
+    }
+
+    /**
+     * Test if a sphere intersects a capsule.
+     * @param[in] spherePos     Position of the sphere.
+     * @param[in] sphereRadius  Radius of the sphere.
+     * @param[in] capsuleA      Start of the capsule's inner segment.
+     * @param[in] capsuleB      End of the capsule's inner segment.
+     * @param[in] capsuleRadius Radius of the capsule.
+     * @return True if the sphere and capsule touch or overlap; false otherwise.
+     */
+    template<typename T>
+    inline bool sphereIntersectsCapsule( const Vec3<T>& spherePos, const T& sphereRadius, const Vec3<T>& capsuleA, const Vec3<T>& capsuleB, const T& capsuleRadius ) {
+      const Vec3<T> closest = closestPointOnSegment(spherePos, capsuleA, capsuleB, static_cast<T*>(nullptr));
+      const T radius = sphereRadius + capsuleRadius;
+      return closest.sqrDistance(spherePos) <= radius * radius;
+    }
+
+    /**
+     * Test if two capsules intersect.
+     * @param[in] a0      Start of the first capsule's inner segment.
+     * @param[in] a1      End of the first capsule's inner segment.
+     * @param[in] aRadius Radius of the first capsule.
+     * @param[in] b0      Start of the second capsule's inner segment.
+     * @param[in] b1      End of the second capsule's inner segment.
+     * @param[in] bRadius Radius of the second capsule.
+     * @return True if the capsules touch or overlap; false otherwise.
+     */
+    template<typename T>
+    inline bool capsuleIntersectsCapsule( const Vec3<T>& a0, const Vec3<T>& a1, const T& aRadius, const Vec3<T>& b0, const Vec3<T>& b1, const T& bRadius ) {
+      const T dist2 = closestPointsBetweenSegments(a0, a1, b0, b1, static_cast<T*>(nullptr), static_cast<T*>(nullptr), static_cast<Vec3<T>*>(nullptr), static_cast<Vec3<T>*>(nullptr));
+      const T radius = aRadius + bRadius;
+      return dist2 <= radius * radius;
+    }
+
+    /**
+     * Test if a capsule intersects a triangle.  The capsule's segment either crosses the triangle, or the closest
+     * points lie on a triangle edge or at a segment endpoint, so those are the only distances measured.
+     * @param[in] capsuleA      Start of the capsule's inner segment.
+     * @param[in] capsuleB      End of the capsule's inner segment.
+     * @param[in] capsuleRadius Radius of the capsule.
+     * @param[in] t0            First vertex of the triangle.
+     * @param[in] t1            Second vertex of the triangle.
+     * @param[in] t2            Third vertex of the triangle.
+     * @return True if the capsule and triangle touch or overlap; false otherwise.
+     */
+    template<typename T>
+    inline bool capsuleIntersectsTriangle( const Vec3<T>& capsuleA, const Vec3<T>& capsuleB, const T& capsuleRadius, const Vec3<T>& t0, const Vec3<T>& t1, const Vec3<T>& t2 ) {
+      const T radius2 = capsuleRadius * capsuleRadius;
+
+      // Segment endpoints against the face.
+      if( closestPointOnTriangle(capsuleA, t0, t1, t2).sqrDistance(capsuleA) <= radius2 ||
+          closestPointOnTriangle(capsuleB, t0, t1, t2).sqrDistance(capsuleB) <= radius2 ) {
+        return true;
+      }
+
+      // Segment against the edges.
+      T* const noT = nullptr;
+      Vec3<T>* const noPos = nullptr;
+      if( closestPointsBetweenSegments(capsuleA, capsuleB, t0, t1, noT, noT, noPos, noPos) <= radius2 ||
+          closestPointsBetweenSegments(capsuleA, capsuleB, t1, t2, noT, noT, noPos, noPos) <= radius2 ||
+          closestPointsBetweenSegments(capsuleA, capsuleB, t2, t0, noT, noT, noPos, noPos) <= radius2 ) {
+        return true;
+      }
+
+      // Segment passing through the face.
+      T t;
+      return rayIntersectsTriangle(capsuleA, capsuleB - capsuleA, t0, t1, t2, &t, noT, noT) && t <= static_cast<T>(1);
+    }
+
+    /**
+     * Test N spheres against N capsules at once.  Broadcast one side with Vec3Soa's single vector constructor
+     * to test one shape against many.
+     * @param[in] spherePos     Positions of the spheres.
+     * @param[in] sphereRadius  Radii of the spheres.
+     * @param[in] capsuleA      Starts of the capsules' inner segments.
+     * @param[in] capsuleB      Ends of the capsules' inner segments.
+     * @param[in] capsuleRadius Radii of the capsules.
+     * @return Bitmask with bit k set if lane k's sphere and capsule touch or overlap.
+     */
+    template<typename T, unsigned int N>
+    inline unsigned int sphereIntersectsCapsule( const Vec3Soa<T, N>& spherePos, const T* sphereRadius, const Vec3Soa<T, N>& capsuleA, const Vec3Soa<T, N>& capsuleB, const T* capsuleRadius ) {
+      static_assert(N <= 32, "Lane mask is 32 bits");
+      T dist2[N];
+      sqrDistanceToSegment(spherePos, capsuleA, capsuleB, dist2);
+      unsigned int mask = 0;
+      for( unsigned int k = 0; k < N; ++k ) {
+        const T radius = sphereRadius[k] + capsuleRadius[k];
+        mask |= (dist2[k] <= radius * radius) ? (1u << k) : 0u;
+      }
+      return mask;
+    }
+
+    /**
+     * Test N pairs of capsules at once.  Broadcast one side with Vec3Soa's single vector constructor
+     * to test one capsule against many.
+     * @param[in] a0      Starts of the first capsules' inner segments.
+     * @param[in] a1      Ends of the first capsules' inner segments.
+     * @param[in] aRadius Radii of the first capsules.
+     * @param[in] b0      Starts of the second capsules' inner segments.
+     * @param[in] b1      Ends of the second capsules' inner segments.
+     * @param[in] bRadius Radii of the second capsules.
+     * @return Bitmask with bit k set if lane k's capsules touch or overlap.
+     */
+    template<typename T, unsigned int N>
+    inline unsigned int capsuleIntersectsCapsule( const Vec3Soa<T, N>& a0, const Vec3Soa<T, N>& a1, const T* aRadius, const Vec3Soa<T, N>& b0, const Vec3Soa<T, N>& b1, const T* bRadius ) {
+      static_assert(N <= 32, "Lane mask is 32 bits");
+      T dist2[N];
+      closestPointsBetweenSegments(a0, a1, b0, b1, static_cast<T*>(nullptr), static_cast<T*>(nullptr), dist2);
+      unsigned int mask = 0;
+      for( unsigned int k = 0; k < N; ++k ) {
+        const T radius = aRadius[k] + bRadius[k];
+        mask |= (dist2[k] <= radius * radius) ? (1u << k) : 0u;
+      }
+      return mask;
+    }
+
+    namespace detail {
+      /**
+       * The 13 separating axes of a triangle and an axis-aligned box (three box faces, the triangle normal, and the nine
+       * edge cross products), with the triangle's extent and the box's projected radius on each.  Only the box center
+       * changes between boxes of the same size, so testing a box is one dot product and two compares per axis.
+       */
+      template<typename T>
+      struct TriangleAabbAxes {
+        enum { COUNT = 13 };
+
+        Vec3<T> axis[COUNT];
+        T       triMin[COUNT];
+        T       triMax[COUNT];
+        T       radius[COUNT];
+
+        inline TriangleAabbAxes( const Vec3<T>& t0, const Vec3<T>& t1, const Vec3<T>& t2, const Vec3<T>& boxHalfSize ) {
+          const Vec3<T> edges[3] = { t1 - t0, t2 - t1, t0 - t2 };
+          axis[0] = Vec3<T>(static_cast<T>(1), static_cast<T>(0), static_cast<T>(0));
+          axis[1] = Vec3<T>(static_cast<T>(0), static_cast<T>(1), static_cast<T>(0));
+          axis[2] = Vec3<T>(static_cast<T>(0), static_cast<T>(0), static_cast<T>(1));
+          axis[3] = edges[0].cross(edges[1]);
+          for( unsigned int i = 0; i < 3; ++i ) {
+            for( unsigned int e = 0; e < 3; ++e ) {
+              axis[4 + i * 3 + e] = axis[i].cross(edges[e]);
+            }
+          }
+          // A degenerate (zero) axis gives an empty interval at zero on both sides, so it can never separate.
+          for( unsigned int a = 0; a < COUNT; ++a ) {
+            const T p0 = axis[a].dot(t0);
+            const T p1 = axis[a].dot(t1);
+            const T p2 = axis[a].dot(t2);
+            triMin[a] = std::min(p0, std::min(p1, p2));
+            triMax[a] = std::max(p0, std::max(p1, p2));
+            radius[a] = boxHalfSize.x * std::abs(axis[a].x) + boxHalfSize.y * std::abs(axis[a].y) + boxHalfSize.z * std::abs(axis[a].z);
+          }
+        }
+
+        inline bool overlaps( const Vec3<T>& boxCenter ) const {
+          bool overlap = true;
+          for( unsigned int a = 0; a < COUNT; ++a ) {
+            const T c = axis[a].dot(boxCenter);
+            overlap &= (triMin[a] - c <= radius[a]) & (triMax[a] - c >= -radius[a]);
+          }
+          return overlap;
+        }
+
+        template<unsigned int N>
+        inline unsigned int overlaps( const Vec3Soa<T, N>& boxCenter ) const {
+          bool overlap[N];
+          for( unsigned int k = 0; k < N; ++k ) {
+            overlap[k] = true;
+          }
+          // Axis-major so each axis is one pass over the lanes.
+          for( unsigned int a = 0; a < COUNT; ++a ) {
+            for( unsigned int k = 0; k < N; ++k ) {
+              const T c = axis[a].x * boxCenter.x[k] + axis[a].y * boxCenter.y[k] + axis[a].z * boxCenter.z[k];
+              overlap[k] &= (triMin[a] - c <= radius[a]) & (triMax[a] - c >= -radius[a]);
+            }
+          }
+          unsigned int mask = 0;
+          for( unsigned int k = 0; k < N; ++k ) {
+            mask |= overlap[k] ? (1u << k) : 0u;
+          }
+          return mask;
+        }
+      };
+    } /* detail */
+
+    /**
+     * Test if a triangle and an axis-aligned box overlap, using the separating axis theorem.
+     * All 13 axes are evaluated without early outs.
+     * Real-Time Collision Detection - Section 5.2.9
+     * @param[in] t0          First vertex of the triangle.
+     * @param[in] t1          Second vertex of the triangle.
+     * @param[in] t2          Third vertex of the triangle.
+     * @param[in] boxCenter   Center of the box.
+     * @param[in] boxHalfSize Half of the box's size along each axis.
+     * @return True if the triangle and box touch or overlap; false otherwise.
+     */
+    template<typename T>
+    inline bool triangleIntersectsAabb( const Vec3<T>& t0, const Vec3<T>& t1, const Vec3<T>& t2, const Vec3<T>& boxCenter, const Vec3<T>& boxHalfSize ) {
+      return detail::TriangleAabbAxes<T>(t0, t1, t2, boxHalfSize).overlaps(boxCenter);
+    }
+
+    /**
+     * Test a triangle against N axis-aligned boxes of the same size at once, such as a row of grid cells.
+     * The axes are set up once and each is tested against all lanes in a branchless loop.
+     * @param[in] t0          First vertex of the triangle.
+     * @param[in] t1          Second vertex of the triangle.
+     * @param[in] t2          Third vertex of the triangle.
+     * @param[in] boxCenter   Centers of the boxes.
+     * @param[in] boxHalfSize Half of the boxes' size along each axis.
+     * @return Bitmask with bit k set if the triangle touches or overlaps lane k's box.
+     */
+    template<typename T, unsigned int N>
+    inline unsigned int triangleIntersectsAabb( const Vec3<T>& t0, const Vec3<T>& t1, const Vec3<T>& t2, const Vec3Soa<T, N>& boxCenter, const Vec3<T>& boxHalfSize ) {
+      static_assert(N <= 32, "Lane mask is 32 bits");
+      return detail::TriangleAabbAxes<T>(t0, t1, t2, boxHalfSize).overlaps(boxCenter);
+    }
+
+    namespace detail {
+      /**
+       * Earliest t in [0, 1] with a*t^2 + 2*b*t + c <= 0, where c <= 0 means already touching at t = 0.
+       * Returns a value above 1 if there is none.  Branchless, for use in lanes.
+       */
+      template<typename T>
+      inline T sweptSphereRoot( T a, T b, T c ) {
+        const T disc = b * b - a * c;
+        // Stable form of (-b - sqrt(disc)) / a for approaching motion (b < 0); also fine when a is tiny.
+        const T root = c / (std::sqrt(std::max(disc, static_cast<T>(0))) - b);
+        const bool hits = (b < static_cast<T>(0)) & (disc >= static_cast<T>(0));
+        return (c <= static_cast<T>(0)) ? static_cast<T>(0) : (hits ? root : static_cast<T>(2));
+      }
+    } /* detail */
+
+    /**
+     * Sweeps a sphere against N triangles at once, e.g. the triangles of a BVH leaf, and finds when it first touches each.
+     * Face, edge and vertex contacts are all found, as is a sphere already touching at the start of the sweep.
+     * Triangles are two-sided.  Every lane evaluates every feature with no data-dependent branches.
+     * Real-Time Collision Detection - Section 5.5.6
+     * @param[in]  center     Center of the sphere at the start of the sweep.
+     * @param[in]  radius     Radius of the sphere.
+     * @param[in]  motion     Movement of the center over the sweep; the sphere ends at center + motion.
+     * @param[in]  t0         First vertices of the triangles.
+     * @param[in]  t1         Second vertices of the triangles.
+     * @param[in]  t2         Third vertices of the triangles.
+     * @param[out] outT       Time of impact in each lane, as a fraction of motion; 0 if touching at the start.  Lanes that miss get a value above 1.  Optional; N entries.
+     * @param[out] outNormal  Unit contact normal in each lane, pointing from the triangle towards the sphere's center.  Optional.
+     * @param[out] outPoint   Contact point on each triangle.  Optional.
+     * @return Bitmask with bit k set if the sphere touches lane k's triangle during the sweep.
+     */
+    template<typename T, unsigned int N>
+    inline unsigned int sweptSphereIntersectsTriangle( const Vec3<T>& center, T radius, const Vec3<T>& motion, const Vec3Soa<T, N>& t0, const Vec3Soa<T, N>& t1, const Vec3Soa<T, N>& t2, T* outT, Vec3Soa<T, N>* outNormal, Vec3Soa<T, N>* outPoint ) {
+      static_assert(N <= 32, "Lane mask is 32 bits");
+      const T zero = static_cast<T>(0);
+      const T one = static_cast<T>(1);
+      const T rr = radius * radius;
+      const T mm = motion.dot(motion);
+      unsigned int mask = 0;
+      for( unsigned int k = 0; k < N; ++k ) {
+        const Vec3<T> v[3] = { t0.get(k), t1.get(k), t2.get(k) };
+
+        // Face: the plane's distance changes linearly, so touching is when it reaches the radius.
+        const Vec3<T> winding = (v[1] - v[0]).cross(v[2] - v[0]);
+        const T nLength = winding.magnitude();
+        Vec3<T> n = winding * ((nLength > zero) ? one / nLength : zero);
+        const T d0 = n.dot(center - v[0]);
+        n = (d0 < zero) ? -n : n; // Face the side the sphere starts on.
+        const T dist0 = std::abs(d0);
+        const T speed = n.dot(motion);
+        const T faceHit = (dist0 - radius) / ((speed < zero) ? -speed : one);
+        T tFace = (dist0 <= radius) ? zero : (((speed < zero) & (faceHit <= one)) ? faceHit : static_cast<T>(2));
+        const Vec3<T> onPlane = center + motion * tFace - n * ((dist0 <= radius) ? dist0 : radius);
+        bool inside = nLength > zero;
+        for( unsigned int e = 0; e < 3; ++e ) {
+          inside &= winding.dot((v[(e + 1) % 3] - v[e]).cross(onPlane - v[e])) >= zero;
+        }
+        tFace = inside ? tFace : static_cast<T>(2);
+        T best = tFace;
+        Vec3<T> contact = onPlane;
+
+        // Edges: the distance to the edge's line is a quadratic in t, valid where the closest point is on the segment.
+        for( unsigned int e = 0; e < 3; ++e ) {
+          const Vec3<T> edge = v[(e + 1) % 3] - v[e];
+          const Vec3<T> s0 = center - v[e];
+          const T ee = edge.dot(edge);
+          const T me = motion.dot(edge);
+          const T se = s0.dot(edge);
+          const T t = detail::sweptSphereRoot(ee * mm - me * me, ee * s0.dot(motion) - se * me, ee * s0.dot(s0) - se * se - rr * ee);
+          const T along = (se + me * t) / ((ee > zero) ? ee : one);
+          const bool valid = (ee > zero) & (along >= zero) & (along <= one) & (t < best);
+          best = valid ? t : best;
+          contact = valid ? v[e] + edge * along : contact;
+        }
+
+        // Vertices.
+        for( unsigned int i = 0; i < 3; ++i ) {
+          const Vec3<T> s0 = center - v[i];
+          const T t = detail::sweptSphereRoot(mm, s0.dot(motion), s0.dot(s0) - rr);
+          const bool valid = t < best;
+          best = valid ? t : best;
+          contact = valid ? v[i] : contact;
+        }
+
+        const bool hit = best <= one;
+        mask |= hit ? (1u << k) : 0u;
+        if( outT != nullptr ) {
+          outT[k] = best;
+        }
+        if( outNormal != nullptr ) {
+          // The face normal if the center is on the triangle itself.
+          const Vec3<T> away = center + motion * (hit ? best : zero) - contact;
+          const T awayLength = away.magnitude();
+          outNormal->set(k, (awayLength > zero) ? away * (one / awayLength) : n);
+        }
+        if( outPoint != nullptr ) {
+          outPoint->set(k, contact);
+        }
+      }
+      return mask;
+    }
+
+    /**
+     * Sweeps a sphere against a triangle and finds when it first touches it, so fast moving spheres cannot tunnel through.
+     * See the batched form for details.
+     * @param[in]  center    Center of the sphere at the start of the sweep.
+     * @param[in]  radius    Radius of the sphere.
+     * @param[in]  motion    Movement of the center over the sweep; the sphere ends at center + motion.
+     * @param[in]  t0        First vertex of the triangle.
+     * @param[in]  t1        Second vertex of the triangle.
+     * @param[in]  t2        Third vertex of the triangle.
+     * @param[out] outT      Time of impact as a fraction of motion; 0 if touching at the start.  Optional.
+     * @param[out] outNormal Unit contact normal, pointing from the triangle towards the sphere's center.  Optional.
+     * @param[out] outPoint  Contact point on the triangle.  Optional.
+     * @return True if the sphere touches the triangle during the sweep; false otherwise, and nothing is written.
+     */
+    template<typename T>
+    inline bool sweptSphereIntersectsTriangle( const Vec3<T>& center, T radius, const Vec3<T>& motion, const Vec3<T>& t0, const Vec3<T>& t1, const Vec3<T>& t2, T* outT, Vec3<T>* outNormal, Vec3<T>* outPoint ) {
+      T t;
+      Vec3Soa<T, 1> normal;
+      Vec3Soa<T, 1> point;
+      if( sweptSphereIntersectsTriangle(center, radius, motion, Vec3Soa<T, 1>(t0), Vec3Soa<T, 1>(t1), Vec3Soa<T, 1>(t2), &t, &normal, &point) == 0 ) {
+        return false;
+      }
+      if( outT != nullptr ) {
+        *outT = t;
+      }
+      if( outNormal != nullptr ) {
+        *outNormal = normal.get(0);
+      }
+      if( outPoint != nullptr ) {
+        *outPoint = point.get(0);
+      }
+      return true;
+    }
   } /* math */
 } /* cc */
 
 #endif	/* __CC_MATH_INTERSECTION__ */
-
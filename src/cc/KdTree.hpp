@@ -0,0 +1,126 @@
+#ifndef __CC_MATH_KDTREE__
+#define __CC_MATH_KDTREE__
+
+#include <utility>
+#include <vector>
+#include "Vec3.hpp"
+#include "StridedSpan.hpp"
+
+namespace cc {
+  namespace math {
+    /**
+     * k-d tree over a static point cloud, stored implicitly: the points are reordered so that every subtree is a
+     * contiguous range whose middle element is the splitting point, and only a split axis is kept per point.
+     * There are no node records or child pointers; the tree holds its own copy of the points plus five bytes per point
+     * (a 4-byte source index and a 1-byte split axis).
+     */
+    template<typename T>
+    class KdTree {
+    public:
+      inline KdTree();
+
+      /**
+       * Builds the tree by median partitioning along the longest axis of each subtree's bounds.
+       * Subtrees near the root are partitioned on separate threads.
+       * The points are copied, so the source may be freed afterwards.
+       * @param[in] points      Points to index; may be strided, e.g. inside an interleaved buffer.
+       * @param[in] maxLeafSize Ranges of up to this many points are scanned rather than split further.
+       */
+      inline void build( StridedSpan<const Vec3<T> > points, unsigned int maxLeafSize=8 );
+      inline void build( const std::vector<Vec3<T> >& points, unsigned int maxLeafSize=8 );
+      inline void clear();
+
+      /**
+       * Finds the point nearest to a position.
+       * @param[in]  point          Position to search from.
+       * @param[out] outIndex       Source index of the nearest point.  Optional.
+       * @param[out] outSqrDistance Squared distance to the nearest point.  Optional.
+       * @return True if the tree is not empty; false otherwise, and nothing is written.
+       */
+      inline bool nearest( const Vec3<T>& point, unsigned int* outIndex, T* outSqrDistance ) const;
+
+      /**
+       * Finds the k points nearest to a position.
+       * @param[in]  point           Position to search from.
+       * @param[in]  k               Number of points to find.
+       * @param[out] outIndices      Source indices of the points found, nearest first.  Cleared first.
+       * @param[out] outSqrDistances Squared distance to each point found.  Optional; cleared first.
+       * @return Number of points found; less than k only if the tree holds fewer than k points.
+       */
+      inline unsigned int nearest( const Vec3<T>& point, unsigned int k, std::vector<unsigned int>* outIndices, std::vector<T>* outSqrDistances ) const;
+
+      /**
+       * Finds all points within a radius of a position.
+       * @param[in]  center     Center of the query sphere.
+       * @param[in]  radius     Radius of the query sphere.  Points exactly on it are included.
+       * @param[out] outIndices Source indices of the points found, in no particular order.  Cleared first.
+       * @return Number of points found.
+       */
+      inline unsigned int queryRadius( const Vec3<T>& center, T radius, std::vector<unsigned int>* outIndices ) const;
+
+      /**
+       * Finds the nearest point for many positions at once, split across threads.
+       * @param[in]  points          Positions to search from; may be strided.
+       * @param[out] outIndices      Source index of the nearest point, one per position.  Optional.
+       * @param[out] outSqrDistances Squared distance to the nearest point, one per position.  Optional.
+       */
+      inline void nearestBatch( StridedSpan<const Vec3<T> > points, std::vector<unsigned int>* outIndices, std::vector<T>* outSqrDistances ) const;
+
+      /**
+       * Finds the k nearest points for many positions at once, split across threads.
+       * Results are stored flat: the neighbours of position i are at [i * count, (i + 1) * count), nearest first.
+       * @param[in]  points          Positions to search from; may be strided.
+       * @param[in]  k               Number of points to find per position.
+       * @param[out] outIndices      Source indices of the points found.
+       * @param[out] outSqrDistances Squared distance to each point found.  Optional.
+       * @return Number of neighbours stored per position (k, or the point count if smaller).
+       */
+      inline unsigned int nearestBatch( StridedSpan<const Vec3<T> > points, unsigned int k, std::vector<unsigned int>* outIndices, std::vector<T>* outSqrDistances ) const;
+
+      /**
+       * Finds all points within a radius of many positions at once, split across threads.
+       * Results are stored compressed: the points found for position i are outIndices[outOffsets[i], outOffsets[i + 1]).
+       * @param[in]  centers    Centers of the query spheres; may be strided.
+       * @param[in]  radius     Radius of every query sphere.
+       * @param[out] outOffsets Start of each position's results, plus one final entry for the end.
+       * @param[out] outIndices Source indices of the points found.
+       * @return Total number of points found.
+       */
+      inline unsigned int queryRadiusBatch( StridedSpan<const Vec3<T> > centers, T radius, std::vector<unsigned int>* outOffsets, std::vector<unsigned int>* outIndices ) const;
+
+      inline bool         empty       () const;
+      inline unsigned int size        () const;
+      inline unsigned int maxLeafSize () const;
+
+    private:
+      // A point and its source index, kept together so the build moves one record and a query reads one cache line.
+      struct Entry {
+        Vec3<T>      position;
+        unsigned int index;
+      };
+
+      typedef std::pair<T, unsigned int> Candidate;
+
+      inline void subdivide   ( unsigned int begin, unsigned int end, Vec3<T> boundsMin, Vec3<T> boundsMax, unsigned int depth, unsigned int spawnDepth );
+      inline void nearestInto ( const Vec3<T>& point, unsigned int k, std::vector<Candidate>& heap ) const;
+      inline void radiusInto  ( const Vec3<T>& center, T radius, std::vector<unsigned int>& indices ) const;
+
+      template<typename Func>
+      inline void search( const Vec3<T>& point, T& maxSqrDistance, Func visit ) const;
+
+    private:
+      std::vector<Entry>         _entries; // In tree order.
+      std::vector<unsigned char> _axes;    // Split axis of the subtree whose middle entry shares the index.
+      unsigned int               _maxLeafSize;
+    };
+  } /* math */
+
+  // Typedefs.
+  typedef cc::math::KdTree<float>  KdTreef;
+  typedef cc::math::KdTree<double> KdTreed;
+
+} /* cc */
+
+#include "KdTree.inl"
+
+#endif /* __CC_MATH_KDTREE__ */
@@ -0,0 +1,332 @@
+#include <algorithm>
+#include <limits>
+#include <thread>
+#include "KdTree.hpp"
+#include "Aabb.hpp"
+#include "Parallel.hpp"
+
+namespace cc {
+  namespace math {
+    template<typename T>
+    inline KdTree<T>::KdTree()
+      : _maxLeafSize(8) {
+    }
+
+    template<typename T>
+    inline void KdTree<T>::build( StridedSpan<const Vec3<T> > points, unsigned int maxLeafSize ) {
+      clear();
+      _maxLeafSize = (maxLeafSize == 0) ? 1 : maxLeafSize;
+      if( points.empty() ) {
+        return;
+      }
+
+      const unsigned int count = static_cast<unsigned int>(points.size());
+      _entries.resize(count);
+      _axes.resize(count);
+      parallelFor(count, 1 << 16, [&]( std::size_t begin, std::size_t end, unsigned int ) {
+        for( std::size_t i = begin; i < end; ++i ) {
+          _entries[i].position = points[i];
+          _entries[i].index = static_cast<unsigned int>(i);
+          _axes[i] = 0;
+        }
+      });
+
+      // Enough levels of task splitting to give every thread a subtree.
+      unsigned int spawnDepth = 0;
+      while( (1u << spawnDepth) < parallelThreadCount() ) {
+        ++spawnDepth;
+      }
+      const Aabb<T> bounds = computeAabb(points);
+      subdivide(0, count, bounds.boundsMin, bounds.boundsMax, 0, spawnDepth);
+    }
+
+    template<typename T>
+    inline void KdTree<T>::build( const std::vector<Vec3<T> >& points, unsigned int maxLeafSize ) {
+      build(StridedSpan<const Vec3<T> >(points), maxLeafSize);
+    }
+
+    template<typename T>
+    inline void KdTree<T>::clear() {
+      _entries.clear();
+      _axes.clear();
+    }
+
+    template<typename T>
+    inline bool KdTree<T>::nearest( const Vec3<T>& point, unsigned int* outIndex, T* outSqrDistance ) const {
+      if( _entries.empty() ) {
+        return false;
+      }
+
+      T bestSqrDist = std::numeric_limits<T>::max();
+      unsigned int best = 0;
+      search(point, bestSqrDist, [&]( const Entry& entry, T sqrDist ) {
+        if( sqrDist < bestSqrDist ) {
+          bestSqrDist = sqrDist;
+          best = entry.index;
+        }
+      });
+
+      if( outIndex != nullptr ) {
+        *outIndex = best;
+      }
+      if( outSqrDistance != nullptr ) {
+        *outSqrDistance = bestSqrDist;
+      }
+      return true;
+    }
+
+    template<typename T>
+    inline unsigned int KdTree<T>::nearest( const Vec3<T>& point, unsigned int k, std::vector<unsigned int>* outIndices, std::vector<T>* outSqrDistances ) const {
+      if( outIndices == nullptr ) {
+        return 0;
+      }
+      std::vector<Candidate> heap;
+      nearestInto(point, k, heap);
+
+      outIndices->resize(heap.size());
+      if( outSqrDistances != nullptr ) {
+        outSqrDistances->resize(heap.size());
+      }
+      for( std::size_t i = 0; i < heap.size(); ++i ) {
+        (*outIndices)[i] = heap[i].second;
+        if( outSqrDistances != nullptr ) {
+          (*outSqrDistances)[i] = heap[i].first;
+        }
+      }
+      return static_cast<unsigned int>(heap.size());
+    }
+
+    template<typename T>
+    inline unsigned int KdTree<T>::queryRadius( const Vec3<T>& center, T radius, std::vector<unsigned int>* outIndices ) const {
+      if( outIndices == nullptr ) {
+        return 0;
+      }
+      outIndices->clear();
+      radiusInto(center, radius, *outIndices);
+      return static_cast<unsigned int>(outIndices->size());
+    }
+
+    template<typename T>
+    inline void KdTree<T>::nearestBatch( StridedSpan<const Vec3<T> > points, std::vector<unsigned int>* outIndices, std::vector<T>* outSqrDistances ) const {
+      if( outIndices != nullptr ) {
+        outIndices->resize(points.size());
+      }
+      if( outSqrDistances != nullptr ) {
+        outSqrDistances->resize(points.size());
+      }
+      if( _entries.empty() ) {
+        return;
+      }
+
+      parallelFor(points.size(), 1024, [&]( std::size_t begin, std::size_t end, unsigned int ) {
+        for( std::size_t i = begin; i < end; ++i ) {
+          unsigned int index = 0;
+          T sqrDist = static_cast<T>(0);
+          nearest(points[i], &index, &sqrDist);
+          if( outIndices != nullptr ) {
+            (*outIndices)[i] = index;
+          }
+          if( outSqrDistances != nullptr ) {
+            (*outSqrDistances)[i] = sqrDist;
+          }
+        }
+      });
+    }
+
+    template<typename T>
+    inline unsigned int KdTree<T>::nearestBatch( StridedSpan<const Vec3<T> > points, unsigned int k, std::vector<unsigned int>* outIndices, std::vector<T>* outSqrDistances ) const {
+      if( outIndices == nullptr ) {
+        return 0;
+      }
+      k = std::min(k, size());
+      outIndices->resize(points.size() * k);
+      if( outSqrDistances != nullptr ) {
+        outSqrDistances->resize(points.size() * k);
+      }
+      if( k == 0 ) {
+        return 0;
+      }
+
+      parallelFor(points.size(), 1024, [&]( std::size_t begin, std::size_t end, unsigned int ) {
+        std::vector<Candidate> heap;
+        for( std::size_t i = begin; i < end; ++i ) {
+          nearestInto(points[i], k, heap);
+          for( unsigned int j = 0; j < k; ++j ) {
+            (*outIndices)[i * k + j] = heap[j].second;
+            if( outSqrDistances != nullptr ) {
+              (*outSqrDistances)[i * k + j] = heap[j].first;
+            }
+          }
+        }
+      });
+      return k;
+    }
+
+    template<typename T>
+    inline unsigned int KdTree<T>::queryRadiusBatch( StridedSpan<const Vec3<T> > centers, T radius, std::vector<unsigned int>* outOffsets, std::vector<unsigned int>* outIndices ) const {
+      if( outOffsets == nullptr || outIndices == nullptr ) {
+        return 0;
+      }
+      outOffsets->assign(centers.size() + 1, 0u);
+      outIndices->clear();
+
+      // Each chunk collects its results separately; chunks are contiguous and in order, so concatenating them keeps query order.
+      std::vector<std::vector<unsigned int> > chunkIndices(parallelThreadCount());
+      const unsigned int chunks = parallelFor(centers.size(), 1024, [&]( std::size_t begin, std::size_t end, unsigned int chunk ) {
+        std::vector<unsigned int>& indices = chunkIndices[chunk];
+        for( std::size_t i = begin; i < end; ++i ) {
+          const std::size_t before = indices.size();
+          radiusInto(centers[i], radius, indices);
+          (*outOffsets)[i + 1] = static_cast<unsigned int>(indices.size() - before);
+        }
+      });
+
+      for( std::size_t i = 0; i < centers.size(); ++i ) {
+        (*outOffsets)[i + 1] += (*outOffsets)[i];
+      }
+      outIndices->reserve(outOffsets->back());
+      for( unsigned int c = 0; c < chunks; ++c ) {
+        outIndices->insert(outIndices->end(), chunkIndices[c].begin(), chunkIndices[c].end());
+      }
+      return outOffsets->back();
+    }
+
+    template<typename T>
+    inline bool KdTree<T>::empty() const {
+      return _entries.empty();
+    }
+
+    template<typename T>
+    inline unsigned int KdTree<T>::size() const {
+      return static_cast<unsigned int>(_entries.size());
+    }
+
+    template<typename T>
+    inline unsigned int KdTree<T>::maxLeafSize() const {
+      return _maxLeafSize;
+    }
+
+    template<typename T>
+    inline void KdTree<T>::subdivide( unsigned int begin, unsigned int end, Vec3<T> boundsMin, Vec3<T> boundsMax, unsigned int depth, unsigned int spawnDepth ) {
+      const unsigned int PARALLEL_MIN_POINTS = 1 << 15;
+      if( end - begin <= _maxLeafSize ) {
+        return;
+      }
+
+      const Vec3<T> extent = boundsMax - boundsMin;
+      unsigned int axis = (extent.y > extent.x) ? 1 : 0;
+      axis = (extent.z > extent[axis]) ? 2 : axis;
+
+      const unsigned int mid = begin + (end - begin) / 2;
+      std::nth_element(_entries.begin() + begin, _entries.begin() + mid, _entries.begin() + end, [axis]( const Entry& lhs, const Entry& rhs ) {
+        return lhs.position[axis] < rhs.position[axis];
+      });
+      _axes[mid] = static_cast<unsigned char>(axis);
+
+      // Narrow the bounds at the split rather than re-measuring each half.
+      const T split = _entries[mid].position[axis];
+      Vec3<T> leftMax = boundsMax;
+      Vec3<T> rightMin = boundsMin;
+      leftMax[axis] = split;
+      rightMin[axis] = split;
+
+      if( depth < spawnDepth && end - begin >= PARALLEL_MIN_POINTS ) {
+        std::thread worker([this, begin, mid, boundsMin, leftMax, depth, spawnDepth]() { subdivide(begin, mid, boundsMin, leftMax, depth + 1, spawnDepth); });
+        subdivide(mid + 1, end, rightMin, boundsMax, depth + 1, spawnDepth);
+        worker.join();
+      } else {
+        subdivide(begin, mid, boundsMin, leftMax, depth + 1, spawnDepth);
+        subdivide(mid + 1, end, rightMin, boundsMax, depth + 1, spawnDepth);
+      }
+    }
+
+    template<typename T>
+    inline void KdTree<T>::nearestInto( const Vec3<T>& point, unsigned int k, std::vector<Candidate>& heap ) const {
+      heap.clear();
+      k = std::min(k, size());
+      if( k == 0 ) {
+        return;
+      }
+
+      // Max-heap of the best k candidates so far; the search radius shrinks to the worst of them once full.
+      T maxSqrDist = std::numeric_limits<T>::max();
+      search(point, maxSqrDist, [&]( const Entry& entry, T sqrDist ) {
+        if( heap.size() < k ) {
+          heap.push_back(Candidate(sqrDist, entry.index));
+          std::push_heap(heap.begin(), heap.end());
+        } else if( sqrDist < heap.front().first ) {
+          std::pop_heap(heap.begin(), heap.end());
+          heap.back() = Candidate(sqrDist, entry.index);
+          std::push_heap(heap.begin(), heap.end());
+        }
+        if( heap.size() == k ) {
+          maxSqrDist = heap.front().first;
+        }
+      });
+      std::sort_heap(heap.begin(), heap.end());
+    }
+
+    template<typename T>
+    inline void KdTree<T>::radiusInto( const Vec3<T>& center, T radius, std::vector<unsigned int>& indices ) const {
+      if( _entries.empty() ) {
+        return;
+      }
+      T sqrRadius = radius * radius;
+      search(center, sqrRadius, [&]( const Entry& entry, T sqrDist ) {
+        if( sqrDist <= sqrRadius ) {
+          indices.push_back(entry.index);
+        }
+      });
+    }
+
+    template<typename T>
+    template<typename Func>
+    inline void KdTree<T>::search( const Vec3<T>& point, T& maxSqrDistance, Func visit ) const {
+      // A subtree range waiting to be searched, with a lower bound on the squared distance to anything inside it.
+      struct Range {
+        unsigned int begin;
+        unsigned int end;
+        T            sqrDistance;
+      };
+      // Every split pushes at most one range and the tree is balanced, so 64 entries covers any 32-bit point count.
+      Range stack[64];
+      unsigned int top = 0;
+      const Range root = { 0, static_cast<unsigned int>(_entries.size()), static_cast<T>(0) };
+      stack[top++] = root;
+
+      while( top > 0 ) {
+        Range range = stack[--top];
+        if( range.sqrDistance > maxSqrDistance ) {
+          continue;
+        }
+
+        // Descend towards the point, deferring the far side of each split.
+        while( range.end - range.begin > _maxLeafSize ) {
+          const unsigned int mid = range.begin + (range.end - range.begin) / 2;
+          const Entry& entry = _entries[mid];
+          visit(entry, entry.position.sqrDistance(point));
+
+          const unsigned int axis = _axes[mid];
+          const T offset = point[axis] - entry.position[axis];
+          const T sqrOffset = std::max(range.sqrDistance, offset * offset);
+          Range nearRange = { range.begin, mid, range.sqrDistance };
+          Range farRange = { mid + 1, range.end, sqrOffset };
+          if( offset >= static_cast<T>(0) ) {
+            nearRange.begin = mid + 1;
+            nearRange.end = range.end;
+            farRange.begin = range.begin;
+            farRange.end = mid;
+          }
+          if( farRange.begin < farRange.end && sqrOffset <= maxSqrDistance ) {
+            stack[top++] = farRange;
+          }
+          range = nearRange;
+        }
+
+        for( unsigned int i = range.begin; i < range.end; ++i ) {
+          visit(_entries[i], _entries[i].position.sqrDistance(point));
+        }
+      }
+    }
+  } /* math */
+} /* cc */
@@ -0,0 +1,134 @@
+#ifndef __CC_MATH_LOWDISCREPANCY__
+#define __CC_MATH_LOWDISCREPANCY__
+
+#include <cstdint>
+#include <vector>
+#include "StridedSpan.hpp"
+
+namespace cc {
+  namespace math {
+    /**
+     * Sobol sequence in up to MAX_DIMENSIONS dimensions, optionally with hash-based Owen scrambling.  Any prefix of
+     * 2^m points is stratified in every dimension, so integration error falls close to O(1/N) rather than O(1/sqrt(N)).
+     * Samples are a pure function of (index, dimension), so workers can compute disjoint index ranges independently.
+     * Joe and Kuo - Constructing Sobol Sequences with Better Two-Dimensional Projections (2008)
+     * Burley - Practical Hash-based Owen Scrambling (2020)
+     */
+    template<typename T>
+    class Sobol {
+    public:
+      enum { MAX_DIMENSIONS = 16 };
+
+      // Unscrambled sequence; sample 0 is 0 in every dimension.
+      inline Sobol();
+      // Owen-scrambled sequence.  Each seed gives an independent randomization that keeps the stratification.
+      inline explicit Sobol( std::uint32_t seed );
+
+      /**
+       * Computes one coordinate of one sample.
+       * @param[in] index     Index of the sample.
+       * @param[in] dimension Coordinate of the sample; less than MAX_DIMENSIONS.
+       * @return Coordinate in [0, 1).
+       */
+      inline T sample( std::uint32_t index, unsigned int dimension ) const;
+
+      /**
+       * Computes one coordinate of consecutive samples, i.e. out[i] = sample(firstIndex + i, dimension).  Consecutive
+       * samples differ by a couple of direction numbers, so each costs a few XORs; large ranges are split across threads.
+       * @param[in]  firstIndex Index of the first sample.
+       * @param[in]  dimension  Coordinate of the samples; less than MAX_DIMENSIONS.
+       * @param[out] out        Coordinates, each in [0, 1); may be strided.
+       */
+      inline void fill( std::uint32_t firstIndex, unsigned int dimension, StridedSpan<T> out ) const;
+
+      inline bool isScrambled() const;
+
+    private:
+      inline std::uint32_t scramble( std::uint32_t bits, unsigned int dimension ) const;
+
+    private:
+      std::uint32_t _seeds[MAX_DIMENSIONS];
+      bool          _scrambled;
+    };
+
+    /**
+     * Halton sequence in up to MAX_DIMENSIONS dimensions: dimension d is the radical inverse of the index in the d-th
+     * prime base.  Low dimensions are well distributed; the highest ones show correlation between neighbouring bases
+     * for short runs, so put the important dimensions first.
+     */
+    template<typename T>
+    class Halton {
+    public:
+      enum { MAX_DIMENSIONS = 32 };
+
+      /**
+       * Computes one coordinate of one sample.
+       * @param[in] index     Index of the sample.
+       * @param[in] dimension Coordinate of the sample; less than MAX_DIMENSIONS.
+       * @return Coordinate in [0, 1).
+       */
+      inline T sample( std::uint32_t index, unsigned int dimension ) const;
+
+      /**
+       * Computes one coordinate of consecutive samples, i.e. out[i] = sample(firstIndex + i, dimension).  Large ranges
+       * are split across threads.
+       * @param[in]  firstIndex Index of the first sample.
+       * @param[in]  dimension  Coordinate of the samples; less than MAX_DIMENSIONS.
+       * @param[out] out        Coordinates, each in [0, 1); may be strided.
+       */
+      inline void fill( std::uint32_t firstIndex, unsigned int dimension, StridedSpan<T> out ) const;
+
+      static inline unsigned int base( unsigned int dimension );
+    };
+
+    /**
+     * Kronecker (additive recurrence) sequence: sample i is frac(offset + i * alpha) per dimension, with the alphas taken
+     * from the generalized golden ratio of the dimension count.  Two dimensions is the R2 sequence.  It works in any
+     * number of dimensions at the cost of one multiply per coordinate, and the fractions are kept in 64-bit fixed point
+     * so that sample i is exact for any index.
+     * Roberts - The Unreasonable Effectiveness of Quasirandom Sequences (2018)
+     */
+    template<typename T>
+    class Kronecker {
+    public:
+      // Defaults to the R2 sequence.
+      inline explicit Kronecker( unsigned int dimensions=2, T offset=static_cast<T>(0.5) );
+
+      /**
+       * Computes one coordinate of one sample.
+       * @param[in] index     Index of the sample.
+       * @param[in] dimension Coordinate of the sample; less than dimensions().
+       * @return Coordinate in [0, 1).
+       */
+      inline T sample( std::uint32_t index, unsigned int dimension ) const;
+
+      /**
+       * Computes one coordinate of consecutive samples, i.e. out[i] = sample(firstIndex + i, dimension).  Large ranges
+       * are split across threads.
+       * @param[in]  firstIndex Index of the first sample.
+       * @param[in]  dimension  Coordinate of the samples; less than dimensions().
+       * @param[out] out        Coordinates, each in [0, 1); may be strided.
+       */
+      inline void fill( std::uint32_t firstIndex, unsigned int dimension, StridedSpan<T> out ) const;
+
+      inline unsigned int dimensions() const;
+
+    private:
+      std::vector<std::uint64_t> _alphas; // Fractions of 2^64.
+      std::uint64_t              _offset; // Fraction of 2^64.
+    };
+  } /* math */
+
+  // Typedefs.
+  typedef cc::math::Sobol<float>      Sobolf;
+  typedef cc::math::Sobol<double>     Sobold;
+  typedef cc::math::Halton<float>     Haltonf;
+  typedef cc::math::Halton<double>    Haltond;
+  typedef cc::math::Kronecker<float>  Kroneckerf;
+  typedef cc::math::Kronecker<double> Kroneckerd;
+
+} /* cc */
+
+#include "LowDiscrepancy.inl"
+
+#endif /* __CC_MATH_LOWDISCREPANCY__ */
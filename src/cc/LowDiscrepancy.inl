@@ -0,0 +1,235 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include "LowDiscrepancy.hpp"
+#include "Parallel.hpp"
+
+namespace cc {
+  namespace math {
+    namespace detail {
+      // Direction numbers for the first Sobol::MAX_DIMENSIONS dimensions, one 32-bit number per index bit.
+      struct SobolDirections {
+        std::uint32_t v[16][32];
+
+        SobolDirections() {
+          // Degree, polynomial and initial direction numbers of dimensions 1 onwards, from Joe and Kuo's new-joe-kuo-6.21201.
+          static const unsigned int DEGREE[15] = { 1, 2, 3, 3, 4, 4, 5, 5, 5, 5, 5, 5, 6, 6, 6 };
+          static const unsigned int POLYNOMIAL[15] = { 0, 1, 1, 2, 1, 4, 2, 4, 7, 11, 13, 14, 1, 13, 16 };
+          static const unsigned int INITIAL[15][6] = {
+            { 1 }, { 1, 3 }, { 1, 3, 1 }, { 1, 1, 1 }, { 1, 1, 3, 3 }, { 1, 3, 5, 13 }, { 1, 1, 5, 5, 17 }, { 1, 1, 5, 5, 5 },
+            { 1, 1, 7, 11, 19 }, { 1, 1, 5, 1, 1 }, { 1, 1, 1, 3, 11 }, { 1, 3, 5, 5, 31 }, { 1, 3, 3, 9, 7, 49 },
+            { 1, 1, 1, 15, 21, 21 }, { 1, 3, 1, 13, 27, 49 }
+          };
+          // Dimension 0 is the van der Corput sequence.
+          for( unsigned int i = 0; i < 32; ++i ) {
+            v[0][i] = 1u << (31 - i);
+          }
+          for( unsigned int d = 0; d < 15; ++d ) {
+            const unsigned int s = DEGREE[d];
+            const unsigned int a = POLYNOMIAL[d];
+            std::uint32_t* u = v[d + 1];
+            for( unsigned int i = 0; i < 32; ++i ) {
+              if( i < s ) {
+                u[i] = static_cast<std::uint32_t>(INITIAL[d][i]) << (31 - i);
+                continue;
+              }
+              std::uint32_t x = u[i - s] ^ (u[i - s] >> s);
+              for( unsigned int k = 1; k < s; ++k ) {
+                x ^= ((a >> (s - 1 - k)) & 1) ? u[i - k] : 0u;
+              }
+              u[i] = x;
+            }
+          }
+        }
+      };
+
+      inline const SobolDirections& sobolDirections() {
+        static const SobolDirections table;
+        return table;
+      }
+
+      inline std::uint32_t hashUint32( std::uint32_t x ) {
+        x ^= x >> 16;
+        x *= 0x7FEB352Du;
+        x ^= x >> 15;
+        x *= 0x846CA68Bu;
+        x ^= x >> 16;
+        return x;
+      }
+
+      inline std::uint32_t reverseBits32( std::uint32_t x ) {
+        x = ((x >> 1) & 0x55555555u) | ((x & 0x55555555u) << 1);
+        x = ((x >> 2) & 0x33333333u) | ((x & 0x33333333u) << 2);
+        x = ((x >> 4) & 0x0F0F0F0Fu) | ((x & 0x0F0F0F0Fu) << 4);
+        x = ((x >> 8) & 0x00FF00FFu) | ((x & 0x00FF00FFu) << 8);
+        return (x >> 16) | (x << 16);
+      }
+
+      /**
+       * Owen scrambling: flips each bit of a coordinate based on a hash of the bits above it.  On the reversed bits the
+       * Laine-Karras hash makes every bit depend only on the bits below it, which is the same thing.
+       */
+      inline std::uint32_t owenScramble( std::uint32_t x, std::uint32_t seed ) {
+        x = reverseBits32(x);
+        x += seed;
+        x ^= x * 0x6C50B47Cu;
+        x ^= x * 0xB82F1E52u;
+        x ^= x * 0xC7AFE638u;
+        x ^= x * 0x8D22F6E6u;
+        return reverseBits32(x);
+      }
+
+      // Maps the top bits of a 32-bit fraction to [0, 1), keeping only as many as T can hold so it never rounds up to one.
+      template<typename T>
+      inline T unitFromBits32( std::uint32_t bits ) {
+        enum { DIGITS = (std::numeric_limits<T>::digits < 32) ? std::numeric_limits<T>::digits : 32 };
+        return static_cast<T>(bits >> (32 - DIGITS)) * (static_cast<T>(1) / static_cast<T>(1ull << DIGITS));
+      }
+
+      template<typename T>
+      inline T unitFromBits64( std::uint64_t bits ) {
+        enum { DIGITS = (std::numeric_limits<T>::digits < 63) ? std::numeric_limits<T>::digits : 63 };
+        return static_cast<T>(bits >> (64 - DIGITS)) * (static_cast<T>(1) / static_cast<T>(1ull << DIGITS));
+      }
+
+      inline std::uint32_t sobolBits( std::uint32_t index, unsigned int dimension ) {
+        const std::uint32_t* v = sobolDirections().v[dimension];
+        std::uint32_t bits = 0;
+        for( unsigned int b = 0; index != 0; ++b, index >>= 1 ) {
+          bits ^= v[b] & (0u - (index & 1u));
+        }
+        return bits;
+      }
+    } /* detail */
+
+    template<typename T>
+    inline Sobol<T>::Sobol()
+      : _scrambled(false) {
+      std::fill(_seeds, _seeds + MAX_DIMENSIONS, 0u);
+    }
+
+    template<typename T>
+    inline Sobol<T>::Sobol( std::uint32_t seed )
+      : _scrambled(true) {
+      for( unsigned int d = 0; d < MAX_DIMENSIONS; ++d ) {
+        _seeds[d] = detail::hashUint32(seed + 0x9E3779B9u * (d + 1));
+      }
+    }
+
+    template<typename T>
+    inline T Sobol<T>::sample( std::uint32_t index, unsigned int dimension ) const {
+      assert(dimension < MAX_DIMENSIONS);
+      return detail::unitFromBits32<T>(scramble(detail::sobolBits(index, dimension), dimension));
+    }
+
+    template<typename T>
+    inline void Sobol<T>::fill( std::uint32_t firstIndex, unsigned int dimension, StridedSpan<T> out ) const {
+      assert(dimension < MAX_DIMENSIONS);
+      const std::uint32_t* v = detail::sobolDirections().v[dimension];
+      parallelFor(out.size(), 1 << 14, [&]( std::size_t begin, std::size_t end, unsigned int ) {
+        std::uint32_t index = firstIndex + static_cast<std::uint32_t>(begin);
+        std::uint32_t bits = detail::sobolBits(index, dimension);
+        for( std::size_t i = begin; i < end; ++i ) {
+          out[i] = detail::unitFromBits32<T>(scramble(bits, dimension));
+          // Moving to the next index flips its trailing ones and the zero above them.
+          std::uint32_t changed = index ^ (index + 1);
+          for( unsigned int b = 0; changed != 0; ++b, changed >>= 1 ) {
+            bits ^= v[b] & (0u - (changed & 1u));
+          }
+          ++index;
+        }
+      });
+    }
+
+    template<typename T>
+    inline bool Sobol<T>::isScrambled() const {
+      return _scrambled;
+    }
+
+    template<typename T>
+    inline std::uint32_t Sobol<T>::scramble( std::uint32_t bits, unsigned int dimension ) const {
+      return _scrambled ? detail::owenScramble(bits, _seeds[dimension]) : bits;
+    }
+
+    template<typename T>
+    inline T Halton<T>::sample( std::uint32_t index, unsigned int dimension ) const {
+      assert(dimension < MAX_DIMENSIONS);
+      // Radical inverse: the base-b digits of the index mirrored about the radix point.
+      const std::uint32_t b = base(dimension);
+      const double invBase = 1.0 / static_cast<double>(b);
+      std::uint64_t reversed = 0;
+      double invBaseN = 1.0;
+      while( index != 0 ) {
+        const std::uint32_t next = index / b;
+        reversed = reversed * b + (index - next * b);
+        invBaseN *= invBase;
+        index = next;
+      }
+      const T oneMinusEpsilon = static_cast<T>(1) - std::numeric_limits<T>::epsilon() / static_cast<T>(2);
+      return std::min(static_cast<T>(static_cast<double>(reversed) * invBaseN), oneMinusEpsilon);
+    }
+
+    template<typename T>
+    inline void Halton<T>::fill( std::uint32_t firstIndex, unsigned int dimension, StridedSpan<T> out ) const {
+      assert(dimension < MAX_DIMENSIONS);
+      parallelFor(out.size(), 1 << 14, [&]( std::size_t begin, std::size_t end, unsigned int ) {
+        for( std::size_t i = begin; i < end; ++i ) {
+          out[i] = sample(firstIndex + static_cast<std::uint32_t>(i), dimension);
+        }
+      });
+    }
+
+    template<typename T>
+    inline unsigned int Halton<T>::base( unsigned int dimension ) {
+      static const unsigned int PRIMES[MAX_DIMENSIONS] = {
+        2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, 97, 101, 103, 107, 109, 113, 127, 131
+      };
+      assert(dimension < MAX_DIMENSIONS);
+      return PRIMES[dimension];
+    }
+
+    template<typename T>
+    inline Kronecker<T>::Kronecker( unsigned int dimensions, T offset ) {
+      // The generalized golden ratio is the positive root of x^(d+1) = x + 1; Newton's method from 2 converges quickly.
+      const double d = static_cast<double>(dimensions);
+      double phi = 2.0;
+      for( int i = 0; i < 32; ++i ) {
+        phi -= (std::pow(phi, d + 1.0) - phi - 1.0) / ((d + 1.0) * std::pow(phi, d) - 1.0);
+      }
+      _alphas.resize(dimensions);
+      double alpha = 1.0;
+      for( unsigned int j = 0; j < dimensions; ++j ) {
+        alpha /= phi;
+        _alphas[j] = static_cast<std::uint64_t>(std::ldexp(alpha, 64));
+      }
+      const double fraction = static_cast<double>(offset) - std::floor(static_cast<double>(offset));
+      _offset = static_cast<std::uint64_t>(std::ldexp(std::min(fraction, 1.0 - std::ldexp(1.0, -53)), 64));
+    }
+
+    template<typename T>
+    inline T Kronecker<T>::sample( std::uint32_t index, unsigned int dimension ) const {
+      assert(dimension < _alphas.size());
+      // Wrapping 64-bit arithmetic is the fractional part.
+      return detail::unitFromBits64<T>(_offset + static_cast<std::uint64_t>(index) * _alphas[dimension]);
+    }
+
+    template<typename T>
+    inline void Kronecker<T>::fill( std::uint32_t firstIndex, unsigned int dimension, StridedSpan<T> out ) const {
+      assert(dimension < _alphas.size());
+      const std::uint64_t alpha = _alphas[dimension];
+      parallelFor(out.size(), 1 << 14, [&]( std::size_t begin, std::size_t end, unsigned int ) {
+        std::uint64_t x = _offset + static_cast<std::uint64_t>(firstIndex + static_cast<std::uint32_t>(begin)) * alpha;
+        for( std::size_t i = begin; i < end; ++i ) {
+          out[i] = detail::unitFromBits64<T>(x);
+          x += alpha;
+        }
+      });
+    }
+
+    template<typename T>
+    inline unsigned int Kronecker<T>::dimensions() const {
+      return static_cast<unsigned int>(_alphas.size());
+    }
+  } /* math */
+} /* cc */
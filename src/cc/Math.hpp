@@ -4,21 +4,39 @@
 // Include common math and constants first, as other classes will be using things from them
 #include "Common.hpp"
 #include "Constants.hpp"
+#include "StridedSpan.hpp"
 // Include the base types.
 #include "Vec2.hpp"
 #include "Vec3.hpp"
+#include "Vec3Soa.hpp"
 #include "Vec4.hpp"
 #include "Mat4.hpp"
 #include "Quaternion.hpp"
 // Include extra functionality on the base types.
 #include "MatrixFunc.hpp"
+#include "SymmetricEigen.hpp"
 // Include various other helpful math headers.
 #include "ClosestPoint.hpp"
 #include "Distance.hpp"
+#include "Plane.hpp"
 #include "Intersection.hpp"
 #include "TriMath.hpp"
+#include "PreparedTriangle.hpp"
+#include "MeshSampler.hpp"
+#include "ConvexHull.hpp"
   // Onb.
 #include "Onb.hpp"
+#include "Sampling.hpp"
+#include "LowDiscrepancy.hpp"
+  // Bounding volumes and spatial acceleration structures.
+#include "Aabb.hpp"
+#include "Obb.hpp"
+#include "Bvh.hpp"
+#include "Gjk.hpp"
+#include "SweepAndPrune.hpp"
+#include "SpatialHashGrid.hpp"
+#include "KdTree.hpp"
+#include "Voxelizer.hpp"
 
 #endif	/* __CC_MATH_MATH__ */
 
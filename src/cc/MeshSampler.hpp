@@ -0,0 +1,102 @@
+#ifndef __CC_MATH_MESHSAMPLER__
+#define __CC_MATH_MESHSAMPLER__
+
+#include <vector>
+#include "Vec3.hpp"
+#include "StridedSpan.hpp"
+
+namespace cc {
+  namespace math {
+    /**
+     * Draws uniformly distributed points on the surface of a triangle mesh.
+     * Triangles are picked in proportion to their area with a Walker/Vose alias table, so each pick costs two random
+     * numbers and one table lookup regardless of the number of triangles.  The positions and indices are copied.
+     * Random number generators are passed to the sampling functions; any type with nextReal() returning a value in
+     * [0, 1), such as Random, will do.
+     */
+    template<typename T>
+    class MeshSampler {
+    public:
+      inline MeshSampler();
+
+      /**
+       * Builds the sampler for a mesh.  Triangle areas are computed in parallel.
+       * @param[in] positions Vertex positions; may be strided, e.g. inside an interleaved vertex buffer.
+       * @param[in] indices   Triangle list; three indices into positions per triangle.
+       */
+      inline void build( StridedSpan<const Vec3<T> > positions, const std::vector<unsigned int>& indices );
+      inline void build( const std::vector<Vec3<T> >& positions, const std::vector<unsigned int>& indices );
+
+      /**
+       * Replaces the positions of the mesh the sampler was built for, keeping its indices and reusing all of its storage.
+       * @param[in] positions    New vertex positions; as many as were passed to build.
+       * @param[in] rebuildTable If false, the alias table is kept as is.  Only correct if the triangles' areas kept their
+       *                         ratios, e.g. after a rigid transform or uniform scale; the total area is updated either way.
+       */
+      inline void update( StridedSpan<const Vec3<T> > positions, bool rebuildTable=true );
+      inline void update( const std::vector<Vec3<T> >& positions, bool rebuildTable=true );
+      inline void clear();
+
+      /**
+       * Picks a triangle with probability proportional to its area.
+       * @param[in] random Random number generator.
+       * @return Index of the triangle picked.  The sampler must not be empty.
+       */
+      template<typename Rng>
+      inline unsigned int pickTriangle( Rng& random ) const;
+
+      /**
+       * Draws one uniformly distributed point on the surface.
+       * @param[in]  random         Random number generator.
+       * @param[out] outPoint       Point drawn.  Optional.
+       * @param[out] outTriangle    Index of the triangle the point is on.  Optional.
+       * @param[out] outBarycentric Barycentric coordinates of the point within its triangle.  Optional.
+       * @return True if a point was drawn; false if the mesh has no area, and nothing is written.
+       */
+      template<typename Rng>
+      inline bool sample( Rng& random, Vec3<T>* outPoint, unsigned int* outTriangle, Vec3<T>* outBarycentric ) const;
+
+      /**
+       * Draws many uniformly distributed points on the surface.  The random numbers for eight points are drawn first,
+       * then the eight points are built in independent lanes.
+       * @param[in]  random          Random number generator.
+       * @param[in]  count           Number of points to draw.
+       * @param[out] outPoints       Points drawn.  Optional; resized to count.
+       * @param[out] outTriangles    Index of the triangle each point is on.  Optional; resized to count.
+       * @param[out] outBarycentrics Barycentric coordinates of each point within its triangle.  Optional; resized to count.
+       * @return Number of points drawn; count, or 0 if the mesh has no area.
+       */
+      template<typename Rng>
+      inline unsigned int sample( Rng& random, unsigned int count, std::vector<Vec3<T> >* outPoints, std::vector<unsigned int>* outTriangles, std::vector<Vec3<T> >* outBarycentrics ) const;
+
+      inline bool         empty        () const;
+      inline unsigned int triangleCount() const;
+      inline T            totalArea    () const;
+      inline T            triangleArea ( unsigned int triangle ) const;
+
+    private:
+      inline void computeAreas();
+      inline void buildTable();
+      inline void pointOnTriangle( unsigned int triangle, T r0, T r1, Vec3<T>* outPoint, Vec3<T>* outBarycentric ) const;
+
+    private:
+      std::vector<Vec3<T> > _positions;
+      std::vector<unsigned int> _indices;
+      std::vector<T> _areas;
+      std::vector<T> _probabilities; // Chance of keeping a column rather than taking its alias.
+      std::vector<unsigned int> _aliases;
+      std::vector<unsigned int> _small; // Vose work lists, kept so rebuilds do not allocate.
+      std::vector<unsigned int> _large;
+      T _totalArea;
+    };
+  } /* math */
+
+  // Typedefs.
+  typedef cc::math::MeshSampler<float>  MeshSamplerf;
+  typedef cc::math::MeshSampler<double> MeshSamplerd;
+
+} /* cc */
+
+#include "MeshSampler.inl"
+
+#endif /* __CC_MATH_MESHSAMPLER__ */
@@ -0,0 +1,217 @@
+#include <algorithm>
+#include <cmath>
+#include "MeshSampler.hpp"
+#include "TriMath.hpp"
+#include "Parallel.hpp"
+
+namespace cc {
+  namespace math {
+    template<typename T>
+    inline MeshSampler<T>::MeshSampler()
+      : _totalArea(static_cast<T>(0)) {
+    }
+
+    template<typename T>
+    inline void MeshSampler<T>::build( StridedSpan<const Vec3<T> > positions, const std::vector<unsigned int>& indices ) {
+      _indices.assign(indices.begin(), indices.begin() + (indices.size() / 3) * 3);
+      update(positions, true);
+    }
+
+    template<typename T>
+    inline void MeshSampler<T>::build( const std::vector<Vec3<T> >& positions, const std::vector<unsigned int>& indices ) {
+      build(StridedSpan<const Vec3<T> >(positions), indices);
+    }
+
+    template<typename T>
+    inline void MeshSampler<T>::update( StridedSpan<const Vec3<T> > positions, bool rebuildTable ) {
+      _positions.resize(positions.size());
+      for( std::size_t i = 0; i < positions.size(); ++i ) {
+        _positions[i] = positions[i];
+      }
+      computeAreas();
+      if( rebuildTable || _probabilities.size() != _areas.size() ) {
+        buildTable();
+      }
+    }
+
+    template<typename T>
+    inline void MeshSampler<T>::update( const std::vector<Vec3<T> >& positions, bool rebuildTable ) {
+      update(StridedSpan<const Vec3<T> >(positions), rebuildTable);
+    }
+
+    template<typename T>
+    inline void MeshSampler<T>::clear() {
+      _positions.clear();
+      _indices.clear();
+      _areas.clear();
+      _probabilities.clear();
+      _aliases.clear();
+      _totalArea = static_cast<T>(0);
+    }
+
+    template<typename T>
+    template<typename Rng>
+    inline unsigned int MeshSampler<T>::pickTriangle( Rng& random ) const {
+      const unsigned int count = static_cast<unsigned int>(_probabilities.size());
+      unsigned int column = static_cast<unsigned int>(static_cast<T>(random.nextReal()) * static_cast<T>(count));
+      column = (column < count) ? column : count - 1;
+      return (static_cast<T>(random.nextReal()) < _probabilities[column]) ? column : _aliases[column];
+    }
+
+    template<typename T>
+    template<typename Rng>
+    inline bool MeshSampler<T>::sample( Rng& random, Vec3<T>* outPoint, unsigned int* outTriangle, Vec3<T>* outBarycentric ) const {
+      if( empty() ) {
+        return false;
+      }
+      const unsigned int triangle = pickTriangle(random);
+      const T r0 = static_cast<T>(random.nextReal());
+      const T r1 = static_cast<T>(random.nextReal());
+      pointOnTriangle(triangle, r0, r1, outPoint, outBarycentric);
+      if( outTriangle != nullptr ) {
+        *outTriangle = triangle;
+      }
+      return true;
+    }
+
+    template<typename T>
+    template<typename Rng>
+    inline unsigned int MeshSampler<T>::sample( Rng& random, unsigned int count, std::vector<Vec3<T> >* outPoints, std::vector<unsigned int>* outTriangles, std::vector<Vec3<T> >* outBarycentrics ) const {
+      if( empty() ) {
+        return 0;
+      }
+      if( outPoints != nullptr ) {
+        outPoints->resize(count);
+      }
+      if( outTriangles != nullptr ) {
+        outTriangles->resize(count);
+      }
+      if( outBarycentrics != nullptr ) {
+        outBarycentrics->resize(count);
+      }
+
+      enum { LANES = 8 };
+      unsigned int triangle[LANES];
+      T r0[LANES], r1[LANES];
+      for( unsigned int first = 0; first < count; first += LANES ) {
+        const unsigned int lanes = (count - first < LANES) ? count - first : static_cast<unsigned int>(LANES);
+        // The generator is serial, so draw all of the block's numbers before building any points.
+        for( unsigned int k = 0; k < lanes; ++k ) {
+          triangle[k] = pickTriangle(random);
+          r0[k] = static_cast<T>(random.nextReal());
+          r1[k] = static_cast<T>(random.nextReal());
+        }
+        for( unsigned int k = 0; k < lanes; ++k ) {
+          pointOnTriangle(triangle[k], r0[k], r1[k], (outPoints != nullptr) ? &(*outPoints)[first + k] : nullptr, (outBarycentrics != nullptr) ? &(*outBarycentrics)[first + k] : nullptr);
+        }
+        if( outTriangles != nullptr ) {
+          std::copy(triangle, triangle + lanes, outTriangles->begin() + first);
+        }
+      }
+      return count;
+    }
+
+    template<typename T>
+    inline bool MeshSampler<T>::empty() const {
+      return !(_totalArea > static_cast<T>(0));
+    }
+
+    template<typename T>
+    inline unsigned int MeshSampler<T>::triangleCount() const {
+      return static_cast<unsigned int>(_areas.size());
+    }
+
+    template<typename T>
+    inline T MeshSampler<T>::totalArea() const {
+      return _totalArea;
+    }
+
+    template<typename T>
+    inline T MeshSampler<T>::triangleArea( unsigned int triangle ) const {
+      return _areas[triangle];
+    }
+
+    template<typename T>
+    inline void MeshSampler<T>::computeAreas() {
+      const std::size_t triCount = _indices.size() / 3;
+      _areas.resize(triCount);
+      std::vector<T> chunkTotals(parallelThreadCount(), static_cast<T>(0));
+      const unsigned int chunks = parallelFor(triCount, 1 << 14, [&]( std::size_t begin, std::size_t end, unsigned int chunk ) {
+        T total = static_cast<T>(0);
+        for( std::size_t i = begin; i < end; ++i ) {
+          _areas[i] = computeTriangleArea(_positions[_indices[i * 3 + 0]], _positions[_indices[i * 3 + 1]], _positions[_indices[i * 3 + 2]]);
+          total += _areas[i];
+        }
+        chunkTotals[chunk] = total;
+      });
+
+      _totalArea = static_cast<T>(0);
+      for( unsigned int c = 0; c < chunks; ++c ) {
+        _totalArea += chunkTotals[c];
+      }
+    }
+
+    template<typename T>
+    inline void MeshSampler<T>::buildTable() {
+      /* Vose, "A Linear Algorithm For Generating Random Numbers With a Given Distribution", 1991 */
+      const std::size_t count = _areas.size();
+      _probabilities.resize(count);
+      _aliases.resize(count);
+      if( empty() ) {
+        return;
+      }
+
+      // Scale so the average column is 1.
+      const T scale = static_cast<T>(count) / _totalArea;
+      parallelFor(count, 1 << 14, [&]( std::size_t begin, std::size_t end, unsigned int ) {
+        for( std::size_t i = begin; i < end; ++i ) {
+          _probabilities[i] = _areas[i] * scale;
+          _aliases[i] = static_cast<unsigned int>(i);
+        }
+      });
+
+      // Pairing is inherently serial but linear: each underfull column is topped up from one overfull column.
+      _small.clear();
+      _large.clear();
+      for( std::size_t i = 0; i < count; ++i ) {
+        (_probabilities[i] < static_cast<T>(1) ? _small : _large).push_back(static_cast<unsigned int>(i));
+      }
+      while( !_small.empty() && !_large.empty() ) {
+        const unsigned int less = _small.back();
+        _small.pop_back();
+        const unsigned int more = _large.back();
+        _aliases[less] = more;
+        _probabilities[more] = (_probabilities[more] + _probabilities[less]) - static_cast<T>(1);
+        if( _probabilities[more] < static_cast<T>(1) ) {
+          _large.pop_back();
+          _small.push_back(more);
+        }
+      }
+      // Whatever is left is 1 give or take rounding.
+      for( std::size_t i = 0; i < _large.size(); ++i ) {
+        _probabilities[_large[i]] = static_cast<T>(1);
+      }
+      for( std::size_t i = 0; i < _small.size(); ++i ) {
+        _probabilities[_small[i]] = static_cast<T>(1);
+      }
+    }
+
+    template<typename T>
+    inline void MeshSampler<T>::pointOnTriangle( unsigned int triangle, T r0, T r1, Vec3<T>* outPoint, Vec3<T>* outBarycentric ) const {
+      /* Osada et al., "Shape Distributions", 2002 - Section 4.2 */
+      const T s = std::sqrt(r0);
+      const T u = static_cast<T>(1) - s;
+      const T v = r1 * s;
+      const T w = static_cast<T>(1) - u - v;
+      if( outPoint != nullptr ) {
+        const Vec3<T>& p0 = _positions[_indices[triangle * 3 + 0]];
+        const Vec3<T>& p1 = _positions[_indices[triangle * 3 + 1]];
+        const Vec3<T>& p2 = _positions[_indices[triangle * 3 + 2]];
+        *outPoint = p0 * u + p1 * v + p2 * w;
+      }
+      if( outBarycentric != nullptr ) {
+        *outBarycentric = Vec3<T>(u, v, w);
+      }
+    }
+  } /* math */
+} /* cc */
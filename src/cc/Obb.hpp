@@ -0,0 +1,63 @@
+#ifndef __CC_MATH_OBB__
+#define __CC_MATH_OBB__
+
+#include <vector>
+#include "Vec3.hpp"
+#include "Onb.hpp"
+#include "StridedSpan.hpp"
+
+namespace cc {
+  namespace math {
+    // Oriented bounding box: a box with its own orthonormal axes.  A default constructed box is a point at the origin.
+    template<typename T>
+    class Obb {
+    public:
+      inline Obb();
+      inline Obb( const Vec3<T>& center, const Onb<T>& axes, const Vec3<T>& halfExtents );
+
+      inline bool    contains   ( const Vec3<T>& point ) const;
+      inline Vec3<T> toLocal    ( const Vec3<T>& point ) const;
+      inline Vec3<T> toWorld    ( const Vec3<T>& local ) const;
+      inline Vec3<T> corner     ( unsigned int index ) const;
+      inline T       volume     () const;
+      inline T       surfaceArea() const;
+
+    public:
+      Vec3<T> center;
+      Onb<T>  axes;        // Box axes u, v and w; u is the axis of greatest spread for a fitted box.
+      Vec3<T> halfExtents; // Half size along u, v and w.
+    };
+
+    /**
+     * Fits an oriented box to a set of points by principal component analysis: the axes are the eigenvectors of the
+     * points' covariance.  The covariance and the extents along the axes are both reduced in parallel.
+     * Tight for elongated point sets; for symmetric ones (such as a cube's corners) any axes may be chosen.
+     * @param[in] points Points to enclose; may be strided.
+     * @return Box enclosing the points, or a default box if there are none.
+     */
+    template<typename T>
+    inline Obb<T> fitObb( StridedSpan<const Vec3<T> > points );
+    template<typename T>
+    inline Obb<T> fitObb( const std::vector<Vec3<T> >& points );
+
+    /**
+     * Fits oriented boxes to many independent point sets, e.g. every mesh in a scene.  The inputs are split across
+     * threads, and each thread solves the eigen problems of eight inputs at a time in lanes.
+     * @param[in]  inputs  Point sets to enclose.
+     * @param[out] outObbs Box of each point set.  Resized to the number of inputs.
+     */
+    template<typename T>
+    inline void fitObbs( const std::vector<StridedSpan<const Vec3<T> > >& inputs, std::vector<Obb<T> >* outObbs );
+    template<typename T>
+    inline void fitObbs( const std::vector<std::vector<Vec3<T> > >& inputs, std::vector<Obb<T> >* outObbs );
+  } /* math */
+
+  // Typedefs.
+  typedef cc::math::Obb<float>  Obbf;
+  typedef cc::math::Obb<double> Obbd;
+
+} /* cc */
+
+#include "Obb.inl"
+
+#endif /* __CC_MATH_OBB__ */
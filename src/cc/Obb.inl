@@ -0,0 +1,196 @@
+#include <cmath>
+#include <limits>
+#include "Obb.hpp"
+#include "SymmetricEigen.hpp"
+#include "Parallel.hpp"
+
+namespace cc {
+  namespace math {
+    template<typename T>
+    inline Obb<T>::Obb()
+      : center(static_cast<T>(0)),
+        axes(Vec3<T>(static_cast<T>(1), static_cast<T>(0), static_cast<T>(0)), Vec3<T>(static_cast<T>(0), static_cast<T>(1), static_cast<T>(0)), Vec3<T>(static_cast<T>(0), static_cast<T>(0), static_cast<T>(1))),
+        halfExtents(static_cast<T>(0)) {
+    }
+
+    template<typename T>
+    inline Obb<T>::Obb( const Vec3<T>& center, const Onb<T>& axes, const Vec3<T>& halfExtents )
+      : center(center), axes(axes), halfExtents(halfExtents) {
+    }
+
+    template<typename T>
+    inline bool Obb<T>::contains( const Vec3<T>& point ) const {
+      const Vec3<T> local = toLocal(point);
+      return std::abs(local.x) <= halfExtents.x && std::abs(local.y) <= halfExtents.y && std::abs(local.z) <= halfExtents.z;
+    }
+
+    template<typename T>
+    inline Vec3<T> Obb<T>::toLocal( const Vec3<T>& point ) const {
+      const Vec3<T> d = point - center;
+      return Vec3<T>(d.dot(axes.u()), d.dot(axes.v()), d.dot(axes.w()));
+    }
+
+    template<typename T>
+    inline Vec3<T> Obb<T>::toWorld( const Vec3<T>& local ) const {
+      return center + axes.u() * local.x + axes.v() * local.y + axes.w() * local.z;
+    }
+
+    template<typename T>
+    inline Vec3<T> Obb<T>::corner( unsigned int index ) const {
+      return toWorld(Vec3<T>((index & 1) ? halfExtents.x : -halfExtents.x, (index & 2) ? halfExtents.y : -halfExtents.y, (index & 4) ? halfExtents.z : -halfExtents.z));
+    }
+
+    template<typename T>
+    inline T Obb<T>::volume() const {
+      return static_cast<T>(8) * halfExtents.x * halfExtents.y * halfExtents.z;
+    }
+
+    template<typename T>
+    inline T Obb<T>::surfaceArea() const {
+      return static_cast<T>(8) * (halfExtents.x * halfExtents.y + halfExtents.y * halfExtents.z + halfExtents.z * halfExtents.x);
+    }
+
+    namespace detail {
+      /**
+       * Extents of points along three axes, relative to an origin.  Eight points are projected per step into
+       * independent lanes for the min/max.
+       */
+      template<typename T>
+      struct ObbExtents {
+        T lo[3];
+        T hi[3];
+
+        inline ObbExtents() {
+          for( unsigned int i = 0; i < 3; ++i ) {
+            lo[i] = std::numeric_limits<T>::max();
+            hi[i] = std::numeric_limits<T>::lowest();
+          }
+        }
+
+        inline void scan( const StridedSpan<const Vec3<T> >& points, std::size_t begin, std::size_t end, const Vec3<T>& origin, const Onb<T>& axes ) {
+          enum { LANES = 8 };
+          const Vec3<T> axis[3] = { axes.u(), axes.v(), axes.w() };
+          T laneLo[3][LANES];
+          T laneHi[3][LANES];
+          for( unsigned int i = 0; i < 3; ++i ) {
+            for( unsigned int k = 0; k < LANES; ++k ) {
+              laneLo[i][k] = lo[i];
+              laneHi[i][k] = hi[i];
+            }
+          }
+          for( std::size_t first = begin; first < end; first += LANES ) {
+            const unsigned int count = (end - first < LANES) ? static_cast<unsigned int>(end - first) : static_cast<unsigned int>(LANES);
+            T x[LANES], y[LANES], z[LANES];
+            for( unsigned int k = 0; k < LANES; ++k ) {
+              // Short blocks repeat their first point, which cannot change the result.
+              const Vec3<T> d = points[first + ((k < count) ? k : 0)] - origin;
+              x[k] = d.x;
+              y[k] = d.y;
+              z[k] = d.z;
+            }
+            for( unsigned int i = 0; i < 3; ++i ) {
+              for( unsigned int k = 0; k < LANES; ++k ) {
+                const T p = x[k] * axis[i].x + y[k] * axis[i].y + z[k] * axis[i].z;
+                laneLo[i][k] = (p < laneLo[i][k]) ? p : laneLo[i][k];
+                laneHi[i][k] = (p > laneHi[i][k]) ? p : laneHi[i][k];
+              }
+            }
+          }
+          for( unsigned int i = 0; i < 3; ++i ) {
+            for( unsigned int k = 0; k < LANES; ++k ) {
+              lo[i] = (laneLo[i][k] < lo[i]) ? laneLo[i][k] : lo[i];
+              hi[i] = (laneHi[i][k] > hi[i]) ? laneHi[i][k] : hi[i];
+            }
+          }
+        }
+
+        inline void merge( const ObbExtents<T>& other ) {
+          for( unsigned int i = 0; i < 3; ++i ) {
+            lo[i] = (other.lo[i] < lo[i]) ? other.lo[i] : lo[i];
+            hi[i] = (other.hi[i] > hi[i]) ? other.hi[i] : hi[i];
+          }
+        }
+
+        // Box with these extents around the origin.
+        inline Obb<T> box( const Vec3<T>& origin, const Onb<T>& axes ) const {
+          const T half = static_cast<T>(0.5);
+          const Vec3<T> mid((lo[0] + hi[0]) * half, (lo[1] + hi[1]) * half, (lo[2] + hi[2]) * half);
+          const Vec3<T> center = origin + axes.u() * mid.x + axes.v() * mid.y + axes.w() * mid.z;
+          return Obb<T>(center, axes, Vec3<T>((hi[0] - lo[0]) * half, (hi[1] - lo[1]) * half, (hi[2] - lo[2]) * half));
+        }
+      };
+    } /* detail */
+
+    template<typename T>
+    inline Obb<T> fitObb( StridedSpan<const Vec3<T> > points ) {
+      if( points.empty() ) {
+        return Obb<T>();
+      }
+
+      Vec3<T> mean;
+      const SymMat3<T> covariance = computeCovariance(points, &mean);
+      Vec3<T> vectors[3];
+      symmetricEigen(covariance, static_cast<Vec3<T>*>(nullptr), vectors);
+      const Onb<T> axes(vectors[0], vectors[1], vectors[2]);
+
+      std::vector<detail::ObbExtents<T> > partial(parallelThreadCount());
+      const unsigned int chunks = parallelFor(points.size(), 1 << 16, [&]( std::size_t begin, std::size_t end, unsigned int chunk ) {
+        partial[chunk] = detail::ObbExtents<T>();
+        partial[chunk].scan(points, begin, end, mean, axes);
+      });
+      for( unsigned int c = 1; c < chunks; ++c ) {
+        partial[0].merge(partial[c]);
+      }
+      return partial[0].box(mean, axes);
+    }
+
+    template<typename T>
+    inline Obb<T> fitObb( const std::vector<Vec3<T> >& points ) {
+      return fitObb(StridedSpan<const Vec3<T> >(points));
+    }
+
+    template<typename T>
+    inline void fitObbs( const std::vector<StridedSpan<const Vec3<T> > >& inputs, std::vector<Obb<T> >* outObbs ) {
+      if( outObbs == nullptr ) {
+        return;
+      }
+      outObbs->resize(inputs.size());
+      parallelFor(inputs.size(), 8, [&]( std::size_t begin, std::size_t end, unsigned int ) {
+        enum { LANES = 8 };
+        for( std::size_t first = begin; first < end; first += LANES ) {
+          const unsigned int count = (end - first < LANES) ? static_cast<unsigned int>(end - first) : static_cast<unsigned int>(LANES);
+          // Covariances of up to eight inputs, then one batched solve.  Unused lanes solve a zero matrix.
+          Vec3<T> means[LANES];
+          SymMat3Soa<T, LANES> covariances;
+          for( unsigned int k = 0; k < LANES; ++k ) {
+            covariances.set(k, (k < count) ? computeCovariance(inputs[first + k], &means[k]) : SymMat3<T>());
+          }
+          Vec3Soa<T, LANES> vectors[3];
+          symmetricEigen(covariances, static_cast<Vec3Soa<T, LANES>*>(nullptr), vectors);
+
+          for( unsigned int k = 0; k < count; ++k ) {
+            const StridedSpan<const Vec3<T> >& points = inputs[first + k];
+            if( points.empty() ) {
+              (*outObbs)[first + k] = Obb<T>();
+              continue;
+            }
+            const Onb<T> axes(vectors[0].get(k), vectors[1].get(k), vectors[2].get(k));
+            detail::ObbExtents<T> extents;
+            extents.scan(points, 0, points.size(), means[k], axes);
+            (*outObbs)[first + k] = extents.box(means[k], axes);
+          }
+        }
+      });
+    }
+
+    template<typename T>
+    inline void fitObbs( const std::vector<std::vector<Vec3<T> > >& inputs, std::vector<Obb<T> >* outObbs ) {
+      std::vector<StridedSpan<const Vec3<T> > > spans;
+      spans.reserve(inputs.size());
+      for( std::size_t i = 0; i < inputs.size(); ++i ) {
+        spans.push_back(StridedSpan<const Vec3<T> >(inputs[i]));
+      }
+      fitObbs(spans, outObbs);
+    }
+  } /* math */
+} /* cc */
@@ -38,6 +38,7 @@ namespace cc {
       if( _v.magnitude() < EPSILON ) {
         _v = _u.cross(m);
       }
+      _v = _v.normalized();
       _w = _u.cross(_v);
     }
 
@@ -50,6 +51,7 @@ namespace cc {
       if( _u.sqrMagnitude() < EPSILON ) {
         _u = _v.cross(m);
       }
+      _u = _u.normalized();
       _w = _u.cross(_v);
     }
 
@@ -62,6 +64,7 @@ namespace cc {
       if( _u.magnitude() < EPSILON ) {
         _u = _w.cross(m);
       }
+      _u = _u.normalized();
       _v = _w.cross(_u);
     }
 
@@ -0,0 +1,69 @@
+#ifndef __CC_MATH_PARALLEL__
+#define __CC_MATH_PARALLEL__
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace cc {
+  namespace math {
+    /**
+     * Returns the number of worker threads the parallel helpers will use.
+     * @return Number of hardware threads, or 1 if it cannot be determined.
+     */
+    inline unsigned int parallelThreadCount() {
+      const unsigned int count = std::thread::hardware_concurrency();
+      return (count == 0) ? 1 : count;
+    }
+
+    /**
+     * Splits the range [0, count) into contiguous chunks and runs them across threads.
+     * The calling thread processes the last chunk itself.  Small ranges run inline.  If the calling thread's chunk
+     * throws, the other chunks are finished and joined before the exception propagates.
+     * @param[in] count    Number of items in the range.
+     * @param[in] minChunk Minimum number of items given to a single thread.
+     * @param[in] func     Callable as func(begin, end, chunkIndex).
+     * @return Number of chunks the range was split into.
+     */
+    template<typename Func>
+    inline unsigned int parallelFor( std::size_t count, std::size_t minChunk, Func func ) {
+      if( count == 0 ) {
+        return 0;
+      }
+      minChunk = (minChunk == 0) ? 1 : minChunk;
+
+      std::size_t chunks = (count + minChunk - 1) / minChunk;
+      const std::size_t threads = parallelThreadCount();
+      chunks = (chunks > threads) ? threads : chunks;
+      if( chunks <= 1 ) {
+        func(static_cast<std::size_t>(0), count, 0u);
+        return 1;
+      }
+
+      const std::size_t perChunk = (count + chunks - 1) / chunks;
+      chunks = (count + perChunk - 1) / perChunk;
+      std::vector<std::thread> workers;
+      workers.reserve(chunks - 1);
+      // Destroying a joinable thread terminates, so join the workers before letting an exception out.
+      try {
+        for( std::size_t i = 0; i < chunks - 1; ++i ) {
+          const std::size_t begin = i * perChunk;
+          const std::size_t end = (begin + perChunk < count) ? begin + perChunk : count;
+          workers.push_back(std::thread(func, begin, end, static_cast<unsigned int>(i)));
+        }
+        func((chunks - 1) * perChunk, count, static_cast<unsigned int>(chunks - 1));
+      } catch( ... ) {
+        for( std::size_t i = 0; i < workers.size(); ++i ) {
+          workers[i].join();
+        }
+        throw;
+      }
+      for( std::size_t i = 0; i < workers.size(); ++i ) {
+        workers[i].join();
+      }
+      return static_cast<unsigned int>(chunks);
+    }
+  } /* math */
+} /* cc */
+
+#endif /* __CC_MATH_PARALLEL__ */
@@ -0,0 +1,97 @@
+#ifndef __CC_MATH_PLANE__
+#define __CC_MATH_PLANE__
+
+#include <vector>
+#include "Vec3.hpp"
+#include "StridedSpan.hpp"
+
+namespace cc {
+  namespace math {
+    /**
+     * Side of a plane.  Values are bit flags, so the side of a polygon is the bitwise OR of the sides of its vertices.
+     */
+    enum PlaneSide {
+      ON_PLANE          = 0,
+      IN_FRONT_OF_PLANE = 1,
+      BEHIND_PLANE      = 2,
+      STRADDLING_PLANE  = IN_FRONT_OF_PLANE | BEHIND_PLANE
+    };
+
+    // Plane of points p where normal.dot(p) == d.  Signed distances are in multiples of the normal's length, so keep it unit length for true distances.
+    template<typename T>
+    class Plane {
+    public:
+      inline Plane();
+      inline Plane( const Vec3<T>& normal, T d );
+      inline Plane( const Vec3<T>& normal, const Vec3<T>& point );
+
+      /**
+       * Creates the plane through three points, facing the side from which they wind counter-clockwise.
+       * @param[in] a First point.
+       * @param[in] b Second point.
+       * @param[in] c Third point.
+       * @return Plane through the points with a unit normal.
+       */
+      static inline Plane<T> fromPoints( const Vec3<T>& a, const Vec3<T>& b, const Vec3<T>& c );
+
+      inline T         distance ( const Vec3<T>& point ) const;
+      inline Vec3<T>   project  ( const Vec3<T>& point ) const;
+      inline PlaneSide classify ( const Vec3<T>& point, T epsilon ) const;
+      inline void      normalize();
+      inline Plane<T>  flipped  () const;
+
+    public:
+      Vec3<T> normal;
+      T       d;
+    };
+
+    /**
+     * Computes the signed distance from a plane to many points.  Large inputs are split across threads, and each thread
+     * handles eight points per step in independent lanes.
+     * @param[in]  plane        Plane to measure from.
+     * @param[in]  points       Points to measure; may be strided.
+     * @param[out] outDistances Signed distance of each point, positive in front.  Resized to the number of points.
+     */
+    template<typename T>
+    inline void distancesToPlane( const Plane<T>& plane, StridedSpan<const Vec3<T> > points, std::vector<T>* outDistances );
+    template<typename T>
+    inline void distancesToPlane( const Plane<T>& plane, const std::vector<Vec3<T> >& points, std::vector<T>* outDistances );
+
+    /**
+     * Classifies many points against a plane, one PlaneSide byte per point.
+     * @param[in]  plane    Plane to classify against.
+     * @param[in]  points   Points to classify; may be strided.
+     * @param[in]  epsilon  Points closer to the plane than this are ON_PLANE.
+     * @param[out] outSides Side of each point.  Resized to the number of points.
+     * @return Bitwise OR of all sides; STRADDLING_PLANE if the points lie on both sides.
+     */
+    template<typename T>
+    inline unsigned char classifyPoints( const Plane<T>& plane, StridedSpan<const Vec3<T> > points, T epsilon, std::vector<unsigned char>* outSides );
+    template<typename T>
+    inline unsigned char classifyPoints( const Plane<T>& plane, const std::vector<Vec3<T> >& points, T epsilon, std::vector<unsigned char>* outSides );
+
+    /**
+     * Classifies the triangles of a mesh against a plane, one PlaneSide byte per triangle, e.g. to find the triangles
+     * a slicing plane cuts.  Each vertex is classified once, however many triangles share it.
+     * @param[in]  plane     Plane to classify against.
+     * @param[in]  positions Vertex positions; may be strided.
+     * @param[in]  indices   Triangle list; three indices into positions per triangle.
+     * @param[in]  epsilon   Vertices closer to the plane than this are ON_PLANE.
+     * @param[out] outSides  Side of each triangle: the OR of its vertices' sides.  Resized to the number of triangles.
+     * @return Number of triangles straddling the plane.
+     */
+    template<typename T>
+    inline unsigned int classifyTriangles( const Plane<T>& plane, StridedSpan<const Vec3<T> > positions, const std::vector<unsigned int>& indices, T epsilon, std::vector<unsigned char>* outSides );
+    template<typename T>
+    inline unsigned int classifyTriangles( const Plane<T>& plane, const std::vector<Vec3<T> >& positions, const std::vector<unsigned int>& indices, T epsilon, std::vector<unsigned char>* outSides );
+  } /* math */
+
+  // Typedefs.
+  typedef cc::math::Plane<float>  Planef;
+  typedef cc::math::Plane<double> Planed;
+
+} /* cc */
+
+#include "Plane.inl"
+
+#endif /* __CC_MATH_PLANE__ */
@@ -0,0 +1,170 @@
+#include <algorithm>
+#include "Plane.hpp"
+#include "Parallel.hpp"
+
+namespace cc {
+  namespace math {
+    template<typename T>
+    inline Plane<T>::Plane()
+      : normal(static_cast<T>(0), static_cast<T>(1), static_cast<T>(0)), d(static_cast<T>(0)) {
+    }
+
+    template<typename T>
+    inline Plane<T>::Plane( const Vec3<T>& normal, T d )
+      : normal(normal), d(d) {
+    }
+
+    template<typename T>
+    inline Plane<T>::Plane( const Vec3<T>& normal, const Vec3<T>& point )
+      : normal(normal), d(normal.dot(point)) {
+    }
+
+    template<typename T>
+    inline Plane<T> Plane<T>::fromPoints( const Vec3<T>& a, const Vec3<T>& b, const Vec3<T>& c ) {
+      return Plane<T>((b - a).cross(c - a).normalized(), a);
+    }
+
+    template<typename T>
+    inline T Plane<T>::distance( const Vec3<T>& point ) const {
+      return normal.dot(point) - d;
+    }
+
+    template<typename T>
+    inline Vec3<T> Plane<T>::project( const Vec3<T>& point ) const {
+      return point - normal * (distance(point) / normal.sqrMagnitude());
+    }
+
+    template<typename T>
+    inline PlaneSide Plane<T>::classify( const Vec3<T>& point, T epsilon ) const {
+      const T dist = distance(point);
+      return (dist > epsilon) ? IN_FRONT_OF_PLANE : ((dist < -epsilon) ? BEHIND_PLANE : ON_PLANE);
+    }
+
+    template<typename T>
+    inline void Plane<T>::normalize() {
+      const T invLength = static_cast<T>(1) / normal.magnitude();
+      normal = normal * invLength;
+      d *= invLength;
+    }
+
+    template<typename T>
+    inline Plane<T> Plane<T>::flipped() const {
+      return Plane<T>(-normal, -d);
+    }
+
+    namespace detail {
+      /**
+       * Runs func(first, dist, count) over blocks of up to eight consecutive points, with dist[k] the signed distance of
+       * point first + k.  Full blocks are measured in independent lanes with no branches.
+       */
+      template<typename T, typename Func>
+      inline void planeDistanceBlocks( const Plane<T>& plane, const StridedSpan<const Vec3<T> >& points, std::size_t begin, std::size_t end, Func func ) {
+        enum { LANES = 8 };
+        const T nx = plane.normal.x;
+        const T ny = plane.normal.y;
+        const T nz = plane.normal.z;
+        T dist[LANES];
+        std::size_t first = begin;
+        for( ; first + LANES <= end; first += LANES ) {
+          for( unsigned int k = 0; k < LANES; ++k ) {
+            const Vec3<T>& p = points[first + k];
+            dist[k] = nx * p.x + ny * p.y + nz * p.z - plane.d;
+          }
+          func(first, dist, static_cast<unsigned int>(LANES));
+        }
+        const unsigned int rest = static_cast<unsigned int>(end - first);
+        for( unsigned int k = 0; k < rest; ++k ) {
+          const Vec3<T>& p = points[first + k];
+          dist[k] = nx * p.x + ny * p.y + nz * p.z - plane.d;
+        }
+        if( rest > 0 ) {
+          func(first, dist, rest);
+        }
+      }
+    } /* detail */
+
+    template<typename T>
+    inline void distancesToPlane( const Plane<T>& plane, StridedSpan<const Vec3<T> > points, std::vector<T>* outDistances ) {
+      if( outDistances == nullptr ) {
+        return;
+      }
+      outDistances->resize(points.size());
+      parallelFor(points.size(), 1 << 16, [&]( std::size_t begin, std::size_t end, unsigned int ) {
+        detail::planeDistanceBlocks(plane, points, begin, end, [&]( std::size_t first, const T* dist, unsigned int count ) {
+          std::copy(dist, dist + count, outDistances->begin() + first);
+        });
+      });
+    }
+
+    template<typename T>
+    inline void distancesToPlane( const Plane<T>& plane, const std::vector<Vec3<T> >& points, std::vector<T>* outDistances ) {
+      distancesToPlane(plane, StridedSpan<const Vec3<T> >(points), outDistances);
+    }
+
+    template<typename T>
+    inline unsigned char classifyPoints( const Plane<T>& plane, StridedSpan<const Vec3<T> > points, T epsilon, std::vector<unsigned char>* outSides ) {
+      if( outSides == nullptr ) {
+        return ON_PLANE;
+      }
+      outSides->resize(points.size());
+
+      std::vector<unsigned char> chunkSides(parallelThreadCount(), static_cast<unsigned char>(ON_PLANE));
+      const unsigned int chunks = parallelFor(points.size(), 1 << 16, [&]( std::size_t begin, std::size_t end, unsigned int chunk ) {
+        unsigned char combined = ON_PLANE;
+        detail::planeDistanceBlocks(plane, points, begin, end, [&]( std::size_t first, const T* dist, unsigned int count ) {
+          for( unsigned int k = 0; k < count; ++k ) {
+            // The flags as arithmetic, so the lanes stay branchless.
+            const unsigned char side = static_cast<unsigned char>((dist[k] > epsilon) * IN_FRONT_OF_PLANE + (dist[k] < -epsilon) * BEHIND_PLANE);
+            (*outSides)[first + k] = side;
+            combined |= side;
+          }
+        });
+        chunkSides[chunk] = combined;
+      });
+
+      unsigned char result = ON_PLANE;
+      for( unsigned int c = 0; c < chunks; ++c ) {
+        result |= chunkSides[c];
+      }
+      return result;
+    }
+
+    template<typename T>
+    inline unsigned char classifyPoints( const Plane<T>& plane, const std::vector<Vec3<T> >& points, T epsilon, std::vector<unsigned char>* outSides ) {
+      return classifyPoints(plane, StridedSpan<const Vec3<T> >(points), epsilon, outSides);
+    }
+
+    template<typename T>
+    inline unsigned int classifyTriangles( const Plane<T>& plane, StridedSpan<const Vec3<T> > positions, const std::vector<unsigned int>& indices, T epsilon, std::vector<unsigned char>* outSides ) {
+      if( outSides == nullptr ) {
+        return 0;
+      }
+      std::vector<unsigned char> vertexSides;
+      classifyPoints(plane, positions, epsilon, &vertexSides);
+
+      const std::size_t triCount = indices.size() / 3;
+      outSides->resize(triCount);
+      std::vector<unsigned int> chunkStraddling(parallelThreadCount(), 0u);
+      const unsigned int chunks = parallelFor(triCount, 1 << 16, [&]( std::size_t begin, std::size_t end, unsigned int chunk ) {
+        unsigned int straddling = 0;
+        for( std::size_t i = begin; i < end; ++i ) {
+          const unsigned char side = vertexSides[indices[i * 3 + 0]] | vertexSides[indices[i * 3 + 1]] | vertexSides[indices[i * 3 + 2]];
+          (*outSides)[i] = side;
+          straddling += (side == STRADDLING_PLANE) ? 1 : 0;
+        }
+        chunkStraddling[chunk] = straddling;
+      });
+
+      unsigned int result = 0;
+      for( unsigned int c = 0; c < chunks; ++c ) {
+        result += chunkStraddling[c];
+      }
+      return result;
+    }
+
+    template<typename T>
+    inline unsigned int classifyTriangles( const Plane<T>& plane, const std::vector<Vec3<T> >& positions, const std::vector<unsigned int>& indices, T epsilon, std::vector<unsigned char>* outSides ) {
+      return classifyTriangles(plane, StridedSpan<const Vec3<T> >(positions), indices, epsilon, outSides);
+    }
+  } /* math */
+} /* cc */
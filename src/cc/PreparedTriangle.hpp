@@ -0,0 +1,86 @@
+#ifndef __CC_MATH_PREPAREDTRIANGLE__
+#define __CC_MATH_PREPAREDTRIANGLE__
+
+#include "Vec3.hpp"
+#include "Vec3Soa.hpp"
+
+namespace cc {
+  namespace math {
+    /**
+     * Triangle with everything needed for barycentric queries computed up front: the edges from the first vertex, their
+     * dot products and the inverse of the barycentric denominator, and the unit normal.  A query is then two dot
+     * products and a few multiplies, with no square root or division.
+     * Points are projected onto the triangle's plane; use signedDistance to also bound the distance from it.
+     * A degenerate (zero area) triangle contains no points.
+     */
+    template<typename T>
+    class PreparedTriangle {
+    public:
+      inline PreparedTriangle();
+      inline PreparedTriangle( const Vec3<T>& t0, const Vec3<T>& t1, const Vec3<T>& t2 );
+
+      inline void set( const Vec3<T>& t0, const Vec3<T>& t1, const Vec3<T>& t2 );
+
+      /**
+       * Computes the barycentric coordinates of a point projected onto the triangle's plane.
+       * @param[in]  point Point to compute the coordinates of.
+       * @param[out] outU  Weight of the first vertex.  Optional.
+       * @param[out] outV  Weight of the second vertex.  Optional.
+       * @param[out] outW  Weight of the third vertex.  Optional.
+       */
+      inline void barycentric( const Vec3<T>& point, T* outU, T* outV, T* outW ) const;
+
+      /**
+       * Tests if a point projected onto the triangle's plane is inside the triangle, including its edges.
+       * @param[in] point Point to test.
+       * @return True if the point is inside; false otherwise.
+       */
+      inline bool contains( const Vec3<T>& point ) const;
+
+      /**
+       * Computes the barycentric coordinates of N points at once, in branchless lanes.
+       * @param[in]  points Points to compute the coordinates of.
+       * @param[out] outU   Weights of the first vertex, one per lane.  Optional.
+       * @param[out] outV   Weights of the second vertex, one per lane.  Optional.
+       * @param[out] outW   Weights of the third vertex, one per lane.  Optional.
+       */
+      template<unsigned int N>
+      inline void barycentric( const Vec3Soa<T, N>& points, T* outU, T* outV, T* outW ) const;
+
+      /**
+       * Tests N points at once.
+       * @param[in] points Points to test.
+       * @return Bitmask with bit k set if lane k's point is inside.
+       */
+      template<unsigned int N>
+      inline unsigned int contains( const Vec3Soa<T, N>& points ) const;
+
+      // Signed distance from the triangle's plane, positive on the side the vertices wind counter-clockwise from.
+      inline T signedDistance( const Vec3<T>& point ) const;
+
+      inline const Vec3<T>& vertex( unsigned int index ) const;
+      inline const Vec3<T>& normal() const;
+
+    private:
+      Vec3<T> _t0;
+      Vec3<T> _t1;
+      Vec3<T> _t2;
+      Vec3<T> _edge0; // t1 - t0.
+      Vec3<T> _edge1; // t2 - t0.
+      Vec3<T> _normal;
+      T       _d00;   // edge0 . edge0
+      T       _d01;   // edge0 . edge1
+      T       _d11;   // edge1 . edge1
+      T       _invDenom;
+    };
+  } /* math */
+
+  // Typedefs.
+  typedef cc::math::PreparedTriangle<float>  PreparedTrianglef;
+  typedef cc::math::PreparedTriangle<double> PreparedTriangled;
+
+} /* cc */
+
+#include "PreparedTriangle.inl"
+
+#endif /* __CC_MATH_PREPAREDTRIANGLE__ */
@@ -0,0 +1,113 @@
+#include <limits>
+#include "PreparedTriangle.hpp"
+
+namespace cc {
+  namespace math {
+    template<typename T>
+    inline PreparedTriangle<T>::PreparedTriangle() {
+      set(Vec3<T>(static_cast<T>(0)), Vec3<T>(static_cast<T>(0)), Vec3<T>(static_cast<T>(0)));
+    }
+
+    template<typename T>
+    inline PreparedTriangle<T>::PreparedTriangle( const Vec3<T>& t0, const Vec3<T>& t1, const Vec3<T>& t2 ) {
+      set(t0, t1, t2);
+    }
+
+    template<typename T>
+    inline void PreparedTriangle<T>::set( const Vec3<T>& t0, const Vec3<T>& t1, const Vec3<T>& t2 ) {
+      /* Real-Time Collision Detection - Section 3.4 */
+      _t0 = t0;
+      _t1 = t1;
+      _t2 = t2;
+      _edge0 = t1 - t0;
+      _edge1 = t2 - t0;
+      _d00 = _edge0.dot(_edge0);
+      _d01 = _edge0.dot(_edge1);
+      _d11 = _edge1.dot(_edge1);
+      const T denom = _d00 * _d11 - _d01 * _d01;
+      // NaN weights fail every comparison, so a degenerate triangle contains nothing.
+      _invDenom = (denom != static_cast<T>(0)) ? static_cast<T>(1) / denom : std::numeric_limits<T>::quiet_NaN();
+
+      const Vec3<T> n = _edge0.cross(_edge1);
+      const T length = n.magnitude();
+      _normal = (length > static_cast<T>(0)) ? n * (static_cast<T>(1) / length) : Vec3<T>(static_cast<T>(0));
+    }
+
+    template<typename T>
+    inline void PreparedTriangle<T>::barycentric( const Vec3<T>& point, T* outU, T* outV, T* outW ) const {
+      const Vec3<T> q = point - _t0;
+      const T d20 = q.dot(_edge0);
+      const T d21 = q.dot(_edge1);
+      const T v = (_d11 * d20 - _d01 * d21) * _invDenom;
+      const T w = (_d00 * d21 - _d01 * d20) * _invDenom;
+      if( outU != nullptr ) {
+        *outU = static_cast<T>(1) - v - w;
+      }
+      if( outV != nullptr ) {
+        *outV = v;
+      }
+      if( outW != nullptr ) {
+        *outW = w;
+      }
+    }
+
+    template<typename T>
+    inline bool PreparedTriangle<T>::contains( const Vec3<T>& point ) const {
+      T v, w;
+      barycentric(point, static_cast<T*>(nullptr), &v, &w);
+      return v >= static_cast<T>(0) && w >= static_cast<T>(0) && v + w <= static_cast<T>(1);
+    }
+
+    template<typename T>
+    template<unsigned int N>
+    inline void PreparedTriangle<T>::barycentric( const Vec3Soa<T, N>& points, T* outU, T* outV, T* outW ) const {
+      for( unsigned int k = 0; k < N; ++k ) {
+        const T qx = points.x[k] - _t0.x;
+        const T qy = points.y[k] - _t0.y;
+        const T qz = points.z[k] - _t0.z;
+        const T d20 = qx * _edge0.x + qy * _edge0.y + qz * _edge0.z;
+        const T d21 = qx * _edge1.x + qy * _edge1.y + qz * _edge1.z;
+        const T v = (_d11 * d20 - _d01 * d21) * _invDenom;
+        const T w = (_d00 * d21 - _d01 * d20) * _invDenom;
+        if( outU != nullptr ) {
+          outU[k] = static_cast<T>(1) - v - w;
+        }
+        if( outV != nullptr ) {
+          outV[k] = v;
+        }
+        if( outW != nullptr ) {
+          outW[k] = w;
+        }
+      }
+    }
+
+    template<typename T>
+    template<unsigned int N>
+    inline unsigned int PreparedTriangle<T>::contains( const Vec3Soa<T, N>& points ) const {
+      static_assert(N <= 32, "Lane mask is 32 bits");
+      T v[N], w[N];
+      barycentric(points, static_cast<T*>(nullptr), v, w);
+      unsigned int mask = 0;
+      for( unsigned int k = 0; k < N; ++k ) {
+        const bool inside = (v[k] >= static_cast<T>(0)) & (w[k] >= static_cast<T>(0)) & (v[k] + w[k] <= static_cast<T>(1));
+        mask |= inside ? (1u << k) : 0u;
+      }
+      return mask;
+    }
+
+    template<typename T>
+    inline T PreparedTriangle<T>::signedDistance( const Vec3<T>& point ) const {
+      return (point - _t0).dot(_normal);
+    }
+
+    template<typename T>
+    inline const Vec3<T>& PreparedTriangle<T>::vertex( unsigned int index ) const {
+      return (index == 0) ? _t0 : ((index == 1) ? _t1 : _t2);
+    }
+
+    template<typename T>
+    inline const Vec3<T>& PreparedTriangle<T>::normal() const {
+      return _normal;
+    }
+  } /* math */
+} /* cc */
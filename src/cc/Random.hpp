@@ -1,19 +1,36 @@
 #ifndef __CC_MATH_RANDOM__
 #define __CC_MATH_RANDOM__
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
 #include <random>
+#include "Constants.hpp"
+#include "RandomEngine.hpp"
+#include "StridedSpan.hpp"
+#include "Vec3.hpp"
 
 namespace cc {
 	namespace math {
-		template <class RealType, class IntType>
+		/**
+		 * Uniform random numbers drawn from Engine.  Engine may be any standard random engine or one of the smaller,
+		 * faster ones in RandomEngine.hpp (Xoshiro256StarStar, Pcg32, SplitMix64, Philox4x32); it must be constructible from a seed.
+		 */
+		template <class RealType, class IntType, class Engine = std::mt19937>
 		class Random {
 		public:
-			Random() {
-				std::random_device dev;
-				_mt = std::mt19937(dev());
+			Random()
+				: _engine(std::random_device{}()) {
 			}
-			Random( unsigned int seed ) {
-				_mt = std::mt19937(seed);
+			Random( unsigned int seed )
+				: _engine(seed) {
+			}
+			/**
+			 * Draws from a copy of an already positioned engine, e.g. a substream taken with jump() or discard().
+			 */
+			explicit Random( const Engine& engine )
+				: _engine(engine) {
 			}
 			~Random() {
 			}
@@ -23,7 +40,7 @@ namespace cc {
 			 */
 			RealType nextReal() {
 				std::uniform_real_distribution<RealType> dist;
-				return dist(_mt);
+				return dist(_engine);
 			}
 
 			/**
@@ -35,7 +52,7 @@ namespace cc {
 			 */
 			RealType nextReal( const RealType min, const RealType max ) {
 				std::uniform_real_distribution<RealType> dist(min, max);
-				return dist(_mt);
+				return dist(_engine);
 			}
 
 			/**
@@ -43,7 +60,7 @@ namespace cc {
 			 */
 			IntType nextInt() {
 				std::uniform_int_distribution<IntType> dist;
-				return dist(_mt);
+				return dist(_engine);
 			}
 
 			/**
@@ -54,31 +71,183 @@ namespace cc {
 			 */
 			IntType nextInt( const IntType min, const IntType max ) {
 				std::uniform_int_distribution<IntType> dist(min, max);
-				return dist(_mt);
+				return dist(_engine);
+			}
+
+			/**
+			 * Fills a buffer with uniformly random ranged RealTypes.  Each engine word gives one or two values (two for
+			 * float) through a bit-level conversion, in blocks of independent lanes.  Follows a different sequence to nextReal.
+			 * @param[out] out Values to fill, each in the range [min, max); may be strided.
+			 * @param[in]  min Minimum possible RealType.
+			 * @param[in]  max Maximum possible RealType.
+			 */
+			void fillReal( StridedSpan<RealType> out, const RealType min, const RealType max ) {
+				enum { LANES = 8, BLOCK = LANES * detail::UnitReal<RealType>::VALUES_PER_WORD };
+				const RealType scale = max - min;
+				std::uint64_t words[LANES];
+				RealType unit[BLOCK];
+				for( std::size_t first = 0; first < out.size(); first += BLOCK ) {
+					detail::RandomWords<Engine>::fill(_engine, words, LANES);
+					detail::UnitReal<RealType>::convert(words, LANES, unit);
+					const std::size_t count = std::min(static_cast<std::size_t>(BLOCK), out.size() - first);
+					for( std::size_t k = 0; k < count; ++k ) {
+						out[first + k] = min + unit[k] * scale;
+					}
+				}
+			}
+
+			/**
+			 * Fills a buffer with uniformly random ranged IntTypes.  Each value scales one 64-bit engine word into the range
+			 * with a multiply instead of a division, so the bias is below (max - min + 1) / 2^64.
+			 * @param[out] out Values to fill, each in the range [min, max]; may be strided.
+			 * @param[in]  min Minimum possible IntType.
+			 * @param[in]  max Maximum possible IntType.
+			 */
+			void fillInt( StridedSpan<IntType> out, const IntType min, const IntType max ) {
+				enum { LANES = 8 };
+				// Zero when the range spans all 64 bits, in which case the word is used as-is.
+				const std::uint64_t range = static_cast<std::uint64_t>(max) - static_cast<std::uint64_t>(min) + 1;
+				std::uint64_t words[LANES];
+				for( std::size_t first = 0; first < out.size(); first += LANES ) {
+					detail::RandomWords<Engine>::fill(_engine, words, LANES);
+					const std::size_t count = std::min(static_cast<std::size_t>(LANES), out.size() - first);
+					for( std::size_t k = 0; k < count; ++k ) {
+						const std::uint64_t offset = (range != 0) ? detail::mulHi64(words[k], range) : words[k];
+						out[first + k] = static_cast<IntType>(static_cast<std::uint64_t>(min) + offset);
+					}
+				}
+			}
+
+			/**
+			 * Fills a buffer with uniformly random unit vectors, i.e. points on the unit sphere.  Uses the closed form
+			 * z = 1 - 2u, phi = 2 pi v, so there is no rejection loop.
+			 * @param[out] out Vectors to fill; may be strided.
+			 */
+			void fillUnitVec3( StridedSpan<Vec3<RealType> > out ) {
+				enum { LANES = 8 };
+				RealType u[LANES * 2];
+				const RealType twoPi = static_cast<RealType>(TWO_PI);
+				for( std::size_t first = 0; first < out.size(); first += LANES ) {
+					fillReal(StridedSpan<RealType>(u, LANES * 2), static_cast<RealType>(0), static_cast<RealType>(1));
+					const std::size_t count = std::min(static_cast<std::size_t>(LANES), out.size() - first);
+					for( std::size_t k = 0; k < count; ++k ) {
+						const RealType z = static_cast<RealType>(1) - static_cast<RealType>(2) * u[k];
+						const RealType r = std::sqrt(std::max(static_cast<RealType>(0), static_cast<RealType>(1) - z * z));
+						const RealType phi = twoPi * u[LANES + k];
+						out[first + k] = Vec3<RealType>(r * std::cos(phi), r * std::sin(phi), z);
+					}
+				}
 			}
 
 			/**
 			 * Same as Random::nextReal(min, max), but static.
+			 * Draws from a generator private to the calling thread, seeded on its first use.
 			 */
 			static RealType rangedReal( const RealType min, const RealType max ) {
-				std::random_device dev;
-				std::mt19937 mt(dev());
 				std::uniform_real_distribution<RealType> dist(min, max);
-				return dist(mt);
+				return dist(threadEngine());
 			}
 
 			/**
 			 * Same as Random::nextInt(min, max), but static.
+			 * Draws from a generator private to the calling thread, seeded on its first use.
 			 */
 			static IntType rangedInt( const IntType min, const IntType max ) {
-				std::random_device dev;
-				std::mt19937 mt(dev());
 				std::uniform_int_distribution<IntType> dist(min, max);
-				return dist(mt);
+				return dist(threadEngine());
+			}
+
+			/**
+			 * Makes the static generators deterministic.  Every thread's generator is reseeded on its next draw from seed
+			 * and the order in which threads draw after this call: the first gets the same sequence on every run, and so on.
+			 * Use seedThread instead when the threads themselves do not start in a fixed order.
+			 * @param[in] seed Base seed shared by all threads.
+			 */
+			static void seedThreadsDeterministic( std::uint64_t seed ) {
+				ThreadSeeding& seeding = threadSeeding();
+				seeding.seed.store(seed);
+				seeding.deterministic.store(true);
+				seeding.ordinal.store(0);
+				seeding.generation.fetch_add(1);
+			}
+
+			/**
+			 * Returns the static generators to the default: every thread's generator is reseeded from std::random_device
+			 * on its next draw.
+			 */
+			static void seedThreadsRandom() {
+				ThreadSeeding& seeding = threadSeeding();
+				seeding.deterministic.store(false);
+				seeding.generation.fetch_add(1);
+			}
+
+			/**
+			 * Seeds the calling thread's static generator directly, e.g. with a chunk index from parallelFor.
+			 * It keeps this seed until seedThreadsDeterministic or seedThreadsRandom is next called.
+			 * @param[in] seed Seed for the calling thread.
+			 */
+			static void seedThread( std::uint64_t seed ) {
+				ThreadState& state = threadState();
+				state.engine.seed(static_cast<typename Engine::result_type>(seed));
+				state.generation = threadSeeding().generation.load();
+			}
+
+			/**
+			 * The underlying engine, e.g. to pass to other std distributions.
+			 */
+			Engine& engine() {
+				return _engine;
+			}
+
+		private:
+			struct ThreadSeeding {
+				// Generation 1 so that every thread's first draw seeds it.
+				ThreadSeeding()
+					: generation(1), ordinal(0), seed(0), deterministic(false) {
+				}
+
+				std::atomic<unsigned int> generation;
+				std::atomic<std::uint64_t> ordinal;
+				std::atomic<std::uint64_t> seed;
+				std::atomic<bool> deterministic;
+			};
+
+			struct ThreadState {
+				Engine engine;
+				unsigned int generation;
+			};
+
+			static ThreadSeeding& threadSeeding() {
+				static ThreadSeeding seeding;
+				return seeding;
+			}
+
+			static ThreadState& threadState() {
+				static thread_local ThreadState state = { Engine(), 0u };
+				return state;
+			}
+
+			static Engine& threadEngine() {
+				ThreadState& state = threadState();
+				ThreadSeeding& seeding = threadSeeding();
+				const unsigned int generation = seeding.generation.load();
+				if( state.generation != generation ) {
+					std::uint64_t seed;
+					if( seeding.deterministic.load() ) {
+						// Mix the base seed and thread ordinal so neighbouring threads get unrelated sequences.
+						SplitMix64 mix(seeding.seed.load() + seeding.ordinal.fetch_add(1));
+						seed = mix();
+					} else {
+						seed = std::random_device{}();
+					}
+					state.engine.seed(static_cast<typename Engine::result_type>(seed));
+					state.generation = generation;
+				}
+				return state.engine;
 			}
 
 		private:
-			std::mt19937 _mt;
+			Engine _engine;
 		};
 	}
 }
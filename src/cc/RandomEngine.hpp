@@ -0,0 +1,369 @@
+#ifndef __CC_MATH_RANDOMENGINE__
+#define __CC_MATH_RANDOMENGINE__
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+
+namespace cc {
+  namespace math {
+    /**
+     * Small, fast random engines to plug into Random in place of std::mt19937.  Each one meets the standard's uniform
+     * random bit generator requirements, so it also works directly with the std::*_distribution classes.
+     * Sebastiano Vigna and David Blackman - Scrambled Linear Pseudorandom Number Generators (prng.di.unimi.it)
+     * Melissa O'Neill - PCG: A Family of Simple Fast Space-Efficient Statistically Good Algorithms (pcg-random.org)
+     */
+
+    // 64-bit generator with 8 bytes of state.  Passes BigCrush and is the recommended way to seed the larger engines.
+    class SplitMix64 {
+    public:
+      typedef std::uint64_t result_type;
+
+      explicit SplitMix64( std::uint64_t seed = 0 )
+        : _state(seed) {
+      }
+
+      void seed( std::uint64_t seed ) {
+        _state = seed;
+      }
+
+      result_type operator()() {
+        std::uint64_t z = (_state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+      }
+
+      // Skips ahead n outputs in constant time.
+      void discard( std::uint64_t n ) {
+        _state += n * 0x9E3779B97F4A7C15ull;
+      }
+
+      static constexpr result_type min() { return 0; }
+      static constexpr result_type max() { return ~static_cast<result_type>(0); }
+
+    private:
+      std::uint64_t _state;
+    };
+
+    // 64-bit generator with 32 bytes of state and a period of 2^256 - 1.  The default all-purpose choice.
+    class Xoshiro256StarStar {
+    public:
+      typedef std::uint64_t result_type;
+
+      explicit Xoshiro256StarStar( std::uint64_t seed = 0 ) {
+        this->seed(seed);
+      }
+
+      // Expands the seed through SplitMix64, which never yields the all-zero state.
+      void seed( std::uint64_t seed ) {
+        SplitMix64 sm(seed);
+        for( unsigned int i = 0; i < 4; ++i ) {
+          _s[i] = sm();
+        }
+      }
+
+      result_type operator()() {
+        const std::uint64_t result = rotl(_s[1] * 5, 7) * 9;
+        const std::uint64_t t = _s[1] << 17;
+        _s[2] ^= _s[0];
+        _s[3] ^= _s[1];
+        _s[1] ^= _s[2];
+        _s[0] ^= _s[3];
+        _s[2] ^= t;
+        _s[3] = rotl(_s[3], 45);
+        return result;
+      }
+
+      /**
+       * Skips ahead 2^128 outputs, e.g. to split one seed into up to 2^128 non-overlapping substreams:
+       * worker k copies the seeded engine and calls jump() k times.
+       */
+      void jump() {
+        static const std::uint64_t JUMP[4] = { 0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull };
+        jumpBy(JUMP);
+      }
+
+      // Skips ahead 2^192 outputs, e.g. to give each machine its own range of jump() substreams.
+      void longJump() {
+        static const std::uint64_t LONG_JUMP[4] = { 0x76E15D3EFEFDCBBFull, 0xC5004E441C522FB3ull, 0x77710069854EE241ull, 0x39109BB02ACBE635ull };
+        jumpBy(LONG_JUMP);
+      }
+
+      static constexpr result_type min() { return 0; }
+      static constexpr result_type max() { return ~static_cast<result_type>(0); }
+
+    private:
+      // Applies the jump polynomial in coefficients to the state.
+      void jumpBy( const std::uint64_t* coefficients ) {
+        std::uint64_t s[4] = { 0, 0, 0, 0 };
+        for( unsigned int i = 0; i < 4; ++i ) {
+          for( unsigned int b = 0; b < 64; ++b ) {
+            const std::uint64_t take = static_cast<std::uint64_t>(0) - ((coefficients[i] >> b) & 1);
+            for( unsigned int j = 0; j < 4; ++j ) {
+              s[j] ^= _s[j] & take;
+            }
+            (*this)();
+          }
+        }
+        for( unsigned int j = 0; j < 4; ++j ) {
+          _s[j] = s[j];
+        }
+      }
+
+      static std::uint64_t rotl( std::uint64_t x, int k ) {
+        return (x << k) | (x >> (64 - k));
+      }
+
+    private:
+      std::uint64_t _s[4];
+    };
+
+    // 32-bit generator with 16 bytes of state (PCG-XSH-RR).  Different stream ids give independent sequences from the same seed.
+    class Pcg32 {
+    public:
+      typedef std::uint32_t result_type;
+
+      explicit Pcg32( std::uint64_t seed = 0x853C49E6748FEA9Bull, std::uint64_t stream = 0xDA3E39CB94B95BDBull ) {
+        this->seed(seed, stream);
+      }
+
+      void seed( std::uint64_t seed, std::uint64_t stream = 0xDA3E39CB94B95BDBull ) {
+        _state = 0;
+        _inc = (stream << 1) | 1;
+        (*this)();
+        _state += seed;
+        (*this)();
+      }
+
+      result_type operator()() {
+        const std::uint64_t old = _state;
+        _state = old * 6364136223846793005ull + _inc;
+        const std::uint32_t xorShifted = static_cast<std::uint32_t>(((old >> 18) ^ old) >> 27);
+        const std::uint32_t rot = static_cast<std::uint32_t>(old >> 59);
+        return (xorShifted >> rot) | (xorShifted << ((32 - rot) & 31));
+      }
+
+      /**
+       * Skips ahead n outputs in O(log n) steps, e.g. so worker k of a parallel loop can start at output k * perWorker.
+       * Brown - Random Number Generation with Arbitrary Strides (1994)
+       */
+      void discard( std::uint64_t n ) {
+        std::uint64_t curMult = 6364136223846793005ull;
+        std::uint64_t curPlus = _inc;
+        std::uint64_t accMult = 1;
+        std::uint64_t accPlus = 0;
+        for( ; n > 0; n >>= 1 ) {
+          if( n & 1 ) {
+            accMult *= curMult;
+            accPlus = accPlus * curMult + curPlus;
+          }
+          curPlus = (curMult + 1) * curPlus;
+          curMult *= curMult;
+        }
+        _state = accMult * _state + accPlus;
+      }
+
+      static constexpr result_type min() { return 0; }
+      static constexpr result_type max() { return ~static_cast<result_type>(0); }
+
+    private:
+      std::uint64_t _state;
+      std::uint64_t _inc;
+    };
+
+    /**
+     * Counter-based generator (Philox4x32-10): output i of stream s under seed k is a pure function of (k, s, i), with
+     * no state carried between outputs.  Any worker can compute any range of any stream, so results do not depend on
+     * how work is split across threads.  Used as an engine it walks its stream's counter, four outputs per block.
+     * Salmon, Moraes, Dror and Shaw - Parallel Random Numbers: As Easy as 1, 2, 3 (2011)
+     */
+    class Philox4x32 {
+    public:
+      typedef std::uint32_t result_type;
+
+      explicit Philox4x32( std::uint64_t seed = 0, std::uint64_t stream = 0 ) {
+        this->seed(seed, stream);
+      }
+
+      // Starts the given stream from its first output.
+      void seed( std::uint64_t seed, std::uint64_t stream = 0 ) {
+        _seed = seed;
+        _stream = stream;
+        _index = 0;
+        refill();
+      }
+
+      result_type operator()() {
+        const result_type result = _block[_index & 3];
+        ++_index;
+        if( (_index & 3) == 0 ) {
+          refill();
+        }
+        return result;
+      }
+
+      // Skips ahead n outputs in constant time.
+      void discard( std::uint64_t n ) {
+        _index += n;
+        refill();
+      }
+
+      // Index of the next output within the stream.
+      std::uint64_t position() const {
+        return _index;
+      }
+
+      /**
+       * Computes one block of four outputs.
+       * @param[in]  seed    Key of the generator.
+       * @param[in]  stream  Stream id.
+       * @param[in]  counter Block index within the stream; covers outputs counter * 4 to counter * 4 + 3.
+       * @param[out] out     The four outputs.
+       */
+      static void block( std::uint64_t seed, std::uint64_t stream, std::uint64_t counter, std::uint32_t* out ) {
+        std::uint32_t ctr[4] = { lo(counter), hi(counter), lo(stream), hi(stream) };
+        std::uint32_t key[2] = { lo(seed), hi(seed) };
+        for( unsigned int round = 0; round < 10; ++round ) {
+          const std::uint64_t p0 = static_cast<std::uint64_t>(0xD2511F53u) * ctr[0];
+          const std::uint64_t p1 = static_cast<std::uint64_t>(0xCD9E8D57u) * ctr[2];
+          const std::uint32_t next[4] = { hi(p1) ^ ctr[1] ^ key[0], lo(p1), hi(p0) ^ ctr[3] ^ key[1], lo(p0) };
+          for( unsigned int i = 0; i < 4; ++i ) {
+            ctr[i] = next[i];
+          }
+          key[0] += 0x9E3779B9u;
+          key[1] += 0xBB67AE85u;
+        }
+        for( unsigned int i = 0; i < 4; ++i ) {
+          out[i] = ctr[i];
+        }
+      }
+
+      /**
+       * Computes a single output by its position, with no generator object.
+       * @param[in] seed   Key of the generator.
+       * @param[in] stream Stream id.
+       * @param[in] index  Position of the output within the stream.
+       * @return The output.
+       */
+      static std::uint32_t at( std::uint64_t seed, std::uint64_t stream, std::uint64_t index ) {
+        std::uint32_t out[4];
+        block(seed, stream, index >> 2, out);
+        return out[index & 3];
+      }
+
+      static constexpr result_type min() { return 0; }
+      static constexpr result_type max() { return ~static_cast<result_type>(0); }
+
+    private:
+      void refill() {
+        block(_seed, _stream, _index >> 2, _block);
+      }
+
+      static std::uint32_t lo( std::uint64_t x ) { return static_cast<std::uint32_t>(x); }
+      static std::uint32_t hi( std::uint64_t x ) { return static_cast<std::uint32_t>(x >> 32); }
+
+    private:
+      std::uint64_t _seed;
+      std::uint64_t _stream;
+      std::uint64_t _index;
+      std::uint32_t _block[4];
+    };
+
+    namespace detail {
+      /**
+       * Fills 64-bit words from any engine.  Engines with a full 64 or 32 bit range are read directly (two draws per word
+       * for 32 bits); anything else goes through std::uniform_int_distribution.
+       */
+      template<typename Engine, int Bits = (Engine::min() == 0 && Engine::max() == 0xFFFFFFFFFFFFFFFFull) ? 64 :
+                                           (Engine::min() == 0 && Engine::max() == 0xFFFFFFFFull) ? 32 : 0>
+      struct RandomWords {
+        static void fill( Engine& engine, std::uint64_t* out, unsigned int count ) {
+          std::uniform_int_distribution<std::uint64_t> dist;
+          for( unsigned int i = 0; i < count; ++i ) {
+            out[i] = dist(engine);
+          }
+        }
+      };
+
+      template<typename Engine>
+      struct RandomWords<Engine, 64> {
+        static void fill( Engine& engine, std::uint64_t* out, unsigned int count ) {
+          for( unsigned int i = 0; i < count; ++i ) {
+            out[i] = static_cast<std::uint64_t>(engine());
+          }
+        }
+      };
+
+      template<typename Engine>
+      struct RandomWords<Engine, 32> {
+        static void fill( Engine& engine, std::uint64_t* out, unsigned int count ) {
+          for( unsigned int i = 0; i < count; ++i ) {
+            const std::uint64_t hi = static_cast<std::uint64_t>(engine());
+            out[i] = (hi << 32) | static_cast<std::uint64_t>(engine());
+          }
+        }
+      };
+
+      /**
+       * Converts random words to reals in [0, 1) by writing the top bits into the mantissa of a number in [1, 2) and
+       * subtracting one, with no integer to float conversion or division.  Floats take two values per word.
+       */
+      template<typename T>
+      struct UnitReal {
+        enum { VALUES_PER_WORD = 1 };
+        static void convert( const std::uint64_t* words, unsigned int count, T* out ) {
+          for( unsigned int i = 0; i < count; ++i ) {
+            out[i] = static_cast<T>(std::ldexp(static_cast<double>(words[i] >> 11), -53));
+          }
+        }
+      };
+
+      template<>
+      struct UnitReal<float> {
+        enum { VALUES_PER_WORD = 2 };
+        static void convert( const std::uint64_t* words, unsigned int count, float* out ) {
+          for( unsigned int i = 0; i < count; ++i ) {
+            const std::uint32_t bits[2] = {
+              0x3F800000u | static_cast<std::uint32_t>(words[i] >> 41),
+              0x3F800000u | (static_cast<std::uint32_t>(words[i]) >> 9)
+            };
+            float f[2];
+            std::memcpy(f, bits, sizeof(f));
+            out[i * 2 + 0] = f[0] - 1.0f;
+            out[i * 2 + 1] = f[1] - 1.0f;
+          }
+        }
+      };
+
+      template<>
+      struct UnitReal<double> {
+        enum { VALUES_PER_WORD = 1 };
+        static void convert( const std::uint64_t* words, unsigned int count, double* out ) {
+          for( unsigned int i = 0; i < count; ++i ) {
+            const std::uint64_t bits = 0x3FF0000000000000ull | (words[i] >> 12);
+            double d;
+            std::memcpy(&d, &bits, sizeof(d));
+            out[i] = d - 1.0;
+          }
+        }
+      };
+
+      // High 64 bits of the 128-bit product a * b.
+      inline std::uint64_t mulHi64( std::uint64_t a, std::uint64_t b ) {
+        const std::uint64_t aLo = a & 0xFFFFFFFFull;
+        const std::uint64_t aHi = a >> 32;
+        const std::uint64_t bLo = b & 0xFFFFFFFFull;
+        const std::uint64_t bHi = b >> 32;
+        const std::uint64_t loLo = aLo * bLo;
+        const std::uint64_t hiLo = aHi * bLo;
+        const std::uint64_t loHi = aLo * bHi;
+        const std::uint64_t cross = (loLo >> 32) + (hiLo & 0xFFFFFFFFull) + loHi;
+        return aHi * bHi + (hiLo >> 32) + (cross >> 32);
+      }
+    } /* detail */
+  } /* math */
+} /* cc */
+
+#endif /* __CC_MATH_RANDOMENGINE__ */
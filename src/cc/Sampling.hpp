@@ -0,0 +1,206 @@
+#ifndef __CC_MATH_SAMPLING__
+#define __CC_MATH_SAMPLING__
+
+#include <algorithm>
+#include <cmath>
+#include "Constants.hpp"
+#include "Vec2.hpp"
+#include "Vec3.hpp"
+#include "Vec3Soa.hpp"
+#include "Onb.hpp"
+
+/**
+ * Warps uniform numbers in [0, 1) to uniformly (or cosine) distributed points on common shapes.  Every mapping is in
+ * closed form, so each sample costs the same fixed number of uniforms and there are no rejection loops.  Taking the
+ * uniforms as arguments rather than a generator lets the same mappings run on pseudo-random numbers (e.g. filled in
+ * bulk with Random::fillReal) or on low-discrepancy sequences.  The batched forms warp N samples in branchless lanes.
+ * Pharr, Jakob and Humphreys - Physically Based Rendering, 3rd Edition - Section 13.6
+ */
+
+namespace cc {
+  namespace math {
+    /**
+     * Maps two uniforms to a point on the unit sphere.
+     * @param[in] u0 Uniform in [0, 1); picks the height.
+     * @param[in] u1 Uniform in [0, 1); picks the angle around the z axis.
+     * @return Unit vector.
+     */
+    template<typename T>
+    inline Vec3<T> sampleSphere( T u0, T u1 ) {
+      const T z = static_cast<T>(1) - static_cast<T>(2) * u0;
+      const T r = std::sqrt(std::max(static_cast<T>(0), static_cast<T>(1) - z * z));
+      const T phi = static_cast<T>(TWO_PI) * u1;
+      return Vec3<T>(r * std::cos(phi), r * std::sin(phi), z);
+    }
+
+    /**
+     * Maps three uniforms to a point in the unit ball.
+     * @param[in] u0 Uniform in [0, 1); picks the height of the direction.
+     * @param[in] u1 Uniform in [0, 1); picks the angle of the direction around the z axis.
+     * @param[in] u2 Uniform in [0, 1); picks the distance from the center.
+     * @return Point with a magnitude of at most one.
+     */
+    template<typename T>
+    inline Vec3<T> sampleBall( T u0, T u1, T u2 ) {
+      return sampleSphere(u0, u1) * std::cbrt(u2);
+    }
+
+    /**
+     * Maps two uniforms to a point in the unit disc.
+     * @param[in] u0 Uniform in [0, 1); picks the distance from the center.
+     * @param[in] u1 Uniform in [0, 1); picks the angle.
+     * @return Point with a magnitude of at most one.
+     */
+    template<typename T>
+    inline Vec2<T> sampleDisc( T u0, T u1 ) {
+      const T r = std::sqrt(u0);
+      const T phi = static_cast<T>(TWO_PI) * u1;
+      return Vec2<T>(r * std::cos(phi), r * std::sin(phi));
+    }
+
+    /**
+     * Maps two uniforms to a point on a triangle.
+     * Osada et al. - Shape Distributions - Section 4.2
+     * @param[in] t0 First vertex of the triangle.
+     * @param[in] t1 Second vertex of the triangle.
+     * @param[in] t2 Third vertex of the triangle.
+     * @param[in] u0 Uniform in [0, 1).
+     * @param[in] u1 Uniform in [0, 1).
+     * @return Point on the triangle.
+     */
+    template<typename T>
+    inline Vec3<T> sampleTriangle( const Vec3<T>& t0, const Vec3<T>& t1, const Vec3<T>& t2, T u0, T u1 ) {
+      const T s = std::sqrt(u0);
+      return t0 * (static_cast<T>(1) - s) + t1 * (s * (static_cast<T>(1) - u1)) + t2 * (s * u1);
+    }
+
+    /**
+     * Maps two uniforms to a cosine-weighted direction in the hemisphere around +z, by projecting a disc sample up
+     * onto it (Malley's method).  The density is z / pi.
+     * @param[in] u0 Uniform in [0, 1).
+     * @param[in] u1 Uniform in [0, 1).
+     * @return Unit vector with a non-negative z.
+     */
+    template<typename T>
+    inline Vec3<T> sampleCosineHemisphere( T u0, T u1 ) {
+      const Vec2<T> d = sampleDisc(u0, u1);
+      return Vec3<T>(d.x, d.y, std::sqrt(std::max(static_cast<T>(0), static_cast<T>(1) - u0)));
+    }
+
+    /**
+     * Maps two uniforms to a cosine-weighted direction in the hemisphere around a frame's w axis, e.g. a shading
+     * normal passed to Onb::initFromW.
+     * @param[in] frame Frame to orient the hemisphere by.
+     * @param[in] u0    Uniform in [0, 1).
+     * @param[in] u1    Uniform in [0, 1).
+     * @return Unit vector on the w side of the frame.
+     */
+    template<typename T>
+    inline Vec3<T> sampleCosineHemisphere( const Onb<T>& frame, T u0, T u1 ) {
+      const Vec3<T> local = sampleCosineHemisphere(u0, u1);
+      return frame.u() * local.x + frame.v() * local.y + frame.w() * local.z;
+    }
+
+    /**
+     * Maps N pairs of uniforms to points on the unit sphere.
+     * @param[in]  u0  Uniforms picking the height; N entries.
+     * @param[in]  u1  Uniforms picking the angle; N entries.
+     * @param[out] out Unit vectors, one per lane.
+     */
+    template<typename T, unsigned int N>
+    inline void sampleSphere( const T* u0, const T* u1, Vec3Soa<T, N>* out ) {
+      for( unsigned int k = 0; k < N; ++k ) {
+        const T z = static_cast<T>(1) - static_cast<T>(2) * u0[k];
+        const T r = std::sqrt(std::max(static_cast<T>(0), static_cast<T>(1) - z * z));
+        const T phi = static_cast<T>(TWO_PI) * u1[k];
+        out->x[k] = r * std::cos(phi);
+        out->y[k] = r * std::sin(phi);
+        out->z[k] = z;
+      }
+    }
+
+    /**
+     * Maps N triples of uniforms to points in the unit ball.
+     * @param[in]  u0  Uniforms picking the height of each direction; N entries.
+     * @param[in]  u1  Uniforms picking the angle of each direction; N entries.
+     * @param[in]  u2  Uniforms picking the distance from the center; N entries.
+     * @param[out] out Points, one per lane.
+     */
+    template<typename T, unsigned int N>
+    inline void sampleBall( const T* u0, const T* u1, const T* u2, Vec3Soa<T, N>* out ) {
+      sampleSphere(u0, u1, out);
+      for( unsigned int k = 0; k < N; ++k ) {
+        const T r = std::cbrt(u2[k]);
+        out->x[k] *= r;
+        out->y[k] *= r;
+        out->z[k] *= r;
+      }
+    }
+
+    /**
+     * Maps N pairs of uniforms to points in the unit disc.
+     * @param[in]  u0   Uniforms picking the distance from the center; N entries.
+     * @param[in]  u1   Uniforms picking the angle; N entries.
+     * @param[out] outX X coordinates of the points, one per lane.
+     * @param[out] outY Y coordinates of the points, one per lane.
+     */
+    template<typename T, unsigned int N>
+    inline void sampleDisc( const T* u0, const T* u1, T (&outX)[N], T (&outY)[N] ) {
+      for( unsigned int k = 0; k < N; ++k ) {
+        const T r = std::sqrt(u0[k]);
+        const T phi = static_cast<T>(TWO_PI) * u1[k];
+        outX[k] = r * std::cos(phi);
+        outY[k] = r * std::sin(phi);
+      }
+    }
+
+    /**
+     * Maps N pairs of uniforms to points on one triangle.
+     * @param[in]  t0  First vertex of the triangle.
+     * @param[in]  t1  Second vertex of the triangle.
+     * @param[in]  t2  Third vertex of the triangle.
+     * @param[in]  u0  First uniform of each point; N entries.
+     * @param[in]  u1  Second uniform of each point; N entries.
+     * @param[out] out Points, one per lane.
+     */
+    template<typename T, unsigned int N>
+    inline void sampleTriangle( const Vec3<T>& t0, const Vec3<T>& t1, const Vec3<T>& t2, const T* u0, const T* u1, Vec3Soa<T, N>* out ) {
+      for( unsigned int k = 0; k < N; ++k ) {
+        const T s = std::sqrt(u0[k]);
+        const T b0 = static_cast<T>(1) - s;
+        const T b1 = s * (static_cast<T>(1) - u1[k]);
+        const T b2 = s * u1[k];
+        out->x[k] = t0.x * b0 + t1.x * b1 + t2.x * b2;
+        out->y[k] = t0.y * b0 + t1.y * b1 + t2.y * b2;
+        out->z[k] = t0.z * b0 + t1.z * b1 + t2.z * b2;
+      }
+    }
+
+    /**
+     * Maps N pairs of uniforms to cosine-weighted directions around a frame's w axis.  The local directions are built
+     * first, then all N are rotated into the frame together.
+     * @param[in]  frame Frame to orient the hemisphere by.
+     * @param[in]  u0    First uniform of each direction; N entries.
+     * @param[in]  u1    Second uniform of each direction; N entries.
+     * @param[out] out   Unit vectors, one per lane.
+     */
+    template<typename T, unsigned int N>
+    inline void sampleCosineHemisphere( const Onb<T>& frame, const T* u0, const T* u1, Vec3Soa<T, N>* out ) {
+      T x[N], y[N], z[N];
+      sampleDisc(u0, u1, x, y);
+      for( unsigned int k = 0; k < N; ++k ) {
+        z[k] = std::sqrt(std::max(static_cast<T>(0), static_cast<T>(1) - u0[k]));
+      }
+      const Vec3<T>& u = frame.u();
+      const Vec3<T>& v = frame.v();
+      const Vec3<T>& w = frame.w();
+      for( unsigned int k = 0; k < N; ++k ) {
+        out->x[k] = u.x * x[k] + v.x * y[k] + w.x * z[k];
+        out->y[k] = u.y * x[k] + v.y * y[k] + w.y * z[k];
+        out->z[k] = u.z * x[k] + v.z * y[k] + w.z * z[k];
+      }
+    }
+  } /* math */
+} /* cc */
+
+#endif /* __CC_MATH_SAMPLING__ */
@@ -0,0 +1,90 @@
+#ifndef __CC_MATH_SPATIALHASHGRID__
+#define __CC_MATH_SPATIALHASHGRID__
+
+#include <vector>
+#include "Vec3.hpp"
+#include "StridedSpan.hpp"
+
+namespace cc {
+  namespace math {
+    /**
+     * Uniform grid over a point set for neighbour searches, with cells hashed into a table so the grid is unbounded.
+     * Points are stored sorted by bucket (a parallel counting sort), so the points of a cell are contiguous in memory
+     * and a query touches only a handful of short runs.  Queries are exact; hash collisions only cost extra distance tests.
+     * Choose a cell size close to the typical query radius.
+     */
+    template<typename T>
+    class SpatialHashGrid {
+    public:
+      // The cell size must be positive.
+      inline explicit SpatialHashGrid( T cellSize=static_cast<T>(1) );
+
+      /**
+       * Rebuilds the grid from a set of points.  Large inputs are hashed and scattered across all hardware threads.
+       * The points are copied, so the source may be freed afterwards.  Buffers are reused between rebuilds.
+       * @param[in] points Points to store; may be strided, e.g. inside an interleaved particle buffer.
+       */
+      inline void build( StridedSpan<const Vec3<T> > points );
+      inline void build( const std::vector<Vec3<T> >& points );
+      inline void clear();
+
+      /**
+       * Finds all points within a radius of a position.
+       * @param[in]  center     Center of the query sphere.
+       * @param[in]  radius     Radius of the query sphere.  Points exactly on it are included.
+       * @param[out] outIndices Source indices of the points found, in no particular order.  Cleared first.
+       * @return Number of points found.
+       */
+      inline unsigned int queryRadius( const Vec3<T>& center, T radius, std::vector<unsigned int>* outIndices ) const;
+
+      /**
+       * Finds the k points nearest to a position.
+       * @param[in]  point           Position to search from.
+       * @param[in]  k               Number of points to find.
+       * @param[out] outIndices      Source indices of the points found, nearest first.  Cleared first.
+       * @param[out] outSqrDistances Squared distance to each point found.  Optional; cleared first.
+       * @return Number of points found; less than k only if the grid holds fewer than k points.
+       */
+      inline unsigned int nearest( const Vec3<T>& point, unsigned int k, std::vector<unsigned int>* outIndices, std::vector<T>* outSqrDistances ) const;
+
+      inline T            cellSize  () const;
+      inline unsigned int pointCount() const;
+      inline unsigned int tableSize () const;
+
+    private:
+      struct Cell {
+        int x;
+        int y;
+        int z;
+      };
+
+      inline Cell         cellOf   ( const Vec3<T>& point ) const;
+      inline unsigned int hashCell ( int x, int y, int z ) const;
+      inline bool         inCell   ( const Vec3<T>& point, int x, int y, int z ) const;
+      template<typename Func>
+      inline void         visitCell( int x, int y, int z, Func func ) const;
+
+    private:
+      T                         _cellSize;
+      T                         _invCellSize;
+      unsigned int              _tableMask;
+      std::vector<unsigned int> _cellStart;  // First sorted point of each bucket; one extra entry marks the end.
+      std::vector<Vec3<T> >     _points;     // Sorted by bucket.
+      std::vector<unsigned int> _indices;    // Sorted order to source index.
+      std::vector<unsigned int> _buckets;    // Build scratch: bucket of each source point.
+      std::vector<unsigned int> _staged;     // Build scratch: source indices grouped by bucket range.
+      std::vector<unsigned int> _cursors;    // Build scratch: next write slot of each bucket.
+      Cell                      _boundsMin;  // Range of occupied cells.
+      Cell                      _boundsMax;
+    };
+  } /* math */
+
+  // Typedefs.
+  typedef cc::math::SpatialHashGrid<float>  SpatialHashGridf;
+  typedef cc::math::SpatialHashGrid<double> SpatialHashGridd;
+
+} /* cc */
+
+#include "SpatialHashGrid.inl"
+
+#endif /* __CC_MATH_SPATIALHASHGRID__ */
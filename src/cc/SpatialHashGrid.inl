@@ -0,0 +1,327 @@
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <cstdlib>
+#include <utility>
+#include "SpatialHashGrid.hpp"
+#include "Parallel.hpp"
+
+namespace cc {
+  namespace math {
+    template<typename T>
+    inline SpatialHashGrid<T>::SpatialHashGrid( T cellSize )
+      : _cellSize(cellSize), _invCellSize(static_cast<T>(1) / cellSize), _tableMask(0) {
+      assert(cellSize > static_cast<T>(0));
+      clear();
+    }
+
+    template<typename T>
+    inline void SpatialHashGrid<T>::build( StridedSpan<const Vec3<T> > points ) {
+      const std::size_t count = points.size();
+      if( count == 0 ) {
+        clear();
+        return;
+      }
+
+      // About one bucket per point keeps collisions rare.
+      unsigned int table = 1;
+      while( table < count ) {
+        table <<= 1;
+      }
+      _tableMask = table - 1;
+      _cellStart.resize(table + 1);
+      _points.resize(count);
+      _indices.resize(count);
+      _buckets.resize(count);
+      _staged.resize(count);
+      _cursors.resize(table);
+      unsigned int tableBits = 0;
+      while( (1u << tableBits) < table ) {
+        ++tableBits;
+      }
+
+      // The table is split into contiguous bucket ranges, one per thread of the final pass.
+      const std::size_t minChunk = 1 << 15;
+      const unsigned int maxChunks = parallelThreadCount();
+      const unsigned int ranges = static_cast<unsigned int>(std::min<std::size_t>(maxChunks, (count + minChunk - 1) / minChunk));
+      std::vector<Cell> chunkMin(maxChunks);
+      std::vector<Cell> chunkMax(maxChunks);
+      std::vector<unsigned int> chunkRanges(maxChunks * ranges, 0u);
+
+      // Hash every point, counting how many of each chunk's points fall in each bucket range.
+      const unsigned int chunks = parallelFor(count, minChunk, [&]( std::size_t begin, std::size_t end, unsigned int chunk ) {
+        Cell cellMin = { INT_MAX, INT_MAX, INT_MAX };
+        Cell cellMax = { INT_MIN, INT_MIN, INT_MIN };
+        unsigned int* rangeCounts = &chunkRanges[chunk * ranges];
+        for( std::size_t i = begin; i < end; ++i ) {
+          const Cell c = cellOf(points[i]);
+          cellMin.x = std::min(cellMin.x, c.x); cellMax.x = std::max(cellMax.x, c.x);
+          cellMin.y = std::min(cellMin.y, c.y); cellMax.y = std::max(cellMax.y, c.y);
+          cellMin.z = std::min(cellMin.z, c.z); cellMax.z = std::max(cellMax.z, c.z);
+          _buckets[i] = hashCell(c.x, c.y, c.z);
+          ++rangeCounts[(static_cast<unsigned long long>(_buckets[i]) * ranges) >> tableBits];
+        }
+        chunkMin[chunk] = cellMin;
+        chunkMax[chunk] = cellMax;
+      });
+
+      _boundsMin = chunkMin[0];
+      _boundsMax = chunkMax[0];
+      for( unsigned int c = 1; c < chunks; ++c ) {
+        _boundsMin.x = std::min(_boundsMin.x, chunkMin[c].x); _boundsMax.x = std::max(_boundsMax.x, chunkMax[c].x);
+        _boundsMin.y = std::min(_boundsMin.y, chunkMin[c].y); _boundsMax.y = std::max(_boundsMax.y, chunkMax[c].y);
+        _boundsMin.z = std::min(_boundsMin.z, chunkMin[c].z); _boundsMax.z = std::max(_boundsMax.z, chunkMax[c].z);
+      }
+
+      // Turn the counts into each chunk's first slot in each range; ranges are laid out in bucket order, and chunks in
+      // source order within a range.
+      std::vector<unsigned int> rangeStart(ranges + 1);
+      unsigned int running = 0;
+      for( unsigned int r = 0; r < ranges; ++r ) {
+        rangeStart[r] = running;
+        for( unsigned int c = 0; c < chunks; ++c ) {
+          const unsigned int n = chunkRanges[c * ranges + r];
+          chunkRanges[c * ranges + r] = running;
+          running += n;
+        }
+      }
+      rangeStart[ranges] = running;
+
+      // Stage each chunk's points by range, so every range's points are contiguous and still in source order.
+      parallelFor(count, minChunk, [&]( std::size_t begin, std::size_t end, unsigned int chunk ) {
+        unsigned int* rangeSlots = &chunkRanges[chunk * ranges];
+        for( std::size_t i = begin; i < end; ++i ) {
+          _staged[rangeSlots[(static_cast<unsigned long long>(_buckets[i]) * ranges) >> tableBits]++] = static_cast<unsigned int>(i);
+        }
+      });
+
+      // Each thread counting-sorts the points of its own ranges into its own buckets; as the ranges are in bucket order,
+      // a range's first slot is also the first slot of its first bucket.
+      parallelFor(ranges, 1, [&]( std::size_t begin, std::size_t end, unsigned int ) {
+        for( std::size_t r = begin; r < end; ++r ) {
+          const unsigned int firstBucket = static_cast<unsigned int>(((static_cast<unsigned long long>(r) << tableBits) + ranges - 1) / ranges);
+          const unsigned int endBucket = static_cast<unsigned int>(((static_cast<unsigned long long>(r + 1) << tableBits) + ranges - 1) / ranges);
+          std::fill(_cellStart.begin() + firstBucket, _cellStart.begin() + endBucket, 0u);
+          for( unsigned int k = rangeStart[r]; k < rangeStart[r + 1]; ++k ) {
+            ++_cellStart[_buckets[_staged[k]]];
+          }
+          unsigned int slot = rangeStart[r];
+          for( unsigned int bucket = firstBucket; bucket < endBucket; ++bucket ) {
+            const unsigned int n = _cellStart[bucket];
+            _cellStart[bucket] = slot;
+            _cursors[bucket] = slot;
+            slot += n;
+          }
+          for( unsigned int k = rangeStart[r]; k < rangeStart[r + 1]; ++k ) {
+            const unsigned int i = _staged[k];
+            const unsigned int dst = _cursors[_buckets[i]]++;
+            _points[dst] = points[i];
+            _indices[dst] = i;
+          }
+        }
+      });
+      _cellStart[table] = static_cast<unsigned int>(count);
+    }
+
+    template<typename T>
+    inline void SpatialHashGrid<T>::build( const std::vector<Vec3<T> >& points ) {
+      build(StridedSpan<const Vec3<T> >(points));
+    }
+
+    template<typename T>
+    inline void SpatialHashGrid<T>::clear() {
+      _tableMask = 0;
+      _cellStart.assign(2, 0u);
+      _points.clear();
+      _indices.clear();
+      _buckets.clear();
+      _staged.clear();
+      _cursors.clear();
+      _boundsMin.x = _boundsMin.y = _boundsMin.z = 0;
+      _boundsMax.x = _boundsMax.y = _boundsMax.z = -1;
+    }
+
+    template<typename T>
+    inline unsigned int SpatialHashGrid<T>::queryRadius( const Vec3<T>& center, T radius, std::vector<unsigned int>* outIndices ) const {
+      if( outIndices == nullptr ) {
+        return 0;
+      }
+      outIndices->clear();
+      if( _points.empty() ) {
+        return 0;
+      }
+
+      const T sqrRadius = radius * radius;
+      const Cell lo = cellOf(center - Vec3<T>(radius));
+      const Cell hi = cellOf(center + Vec3<T>(radius));
+      const int x0 = std::max(lo.x, _boundsMin.x), x1 = std::min(hi.x, _boundsMax.x);
+      const int y0 = std::max(lo.y, _boundsMin.y), y1 = std::min(hi.y, _boundsMax.y);
+      const int z0 = std::max(lo.z, _boundsMin.z), z1 = std::min(hi.z, _boundsMax.z);
+      if( x0 > x1 || y0 > y1 || z0 > z1 ) {
+        return 0;
+      }
+
+      // A query spanning more cells than there are points is cheaper as a plain scan.
+      const double cells = static_cast<double>(x1 - x0 + 1) * static_cast<double>(y1 - y0 + 1) * static_cast<double>(z1 - z0 + 1);
+      if( cells > static_cast<double>(_points.size()) ) {
+        for( std::size_t i = 0; i < _points.size(); ++i ) {
+          if( _points[i].sqrDistance(center) <= sqrRadius ) {
+            outIndices->push_back(_indices[i]);
+          }
+        }
+        return static_cast<unsigned int>(outIndices->size());
+      }
+
+      for( int z = z0; z <= z1; ++z ) {
+        for( int y = y0; y <= y1; ++y ) {
+          for( int x = x0; x <= x1; ++x ) {
+            visitCell(x, y, z, [&]( unsigned int slot ) {
+              if( _points[slot].sqrDistance(center) <= sqrRadius ) {
+                outIndices->push_back(_indices[slot]);
+              }
+            });
+          }
+        }
+      }
+      return static_cast<unsigned int>(outIndices->size());
+    }
+
+    template<typename T>
+    inline unsigned int SpatialHashGrid<T>::nearest( const Vec3<T>& point, unsigned int k, std::vector<unsigned int>* outIndices, std::vector<T>* outSqrDistances ) const {
+      if( outIndices == nullptr ) {
+        return 0;
+      }
+      outIndices->clear();
+      if( outSqrDistances != nullptr ) {
+        outSqrDistances->clear();
+      }
+      k = std::min(k, static_cast<unsigned int>(_points.size()));
+      if( k == 0 ) {
+        return 0;
+      }
+
+      // Max-heap of the best k candidates so far, keyed on squared distance.
+      typedef std::pair<T, unsigned int> Candidate;
+      std::vector<Candidate> heap;
+      heap.reserve(k);
+      const auto consider = [&]( unsigned int slot ) {
+        const T sqrDist = _points[slot].sqrDistance(point);
+        if( heap.size() < k ) {
+          heap.push_back(Candidate(sqrDist, _indices[slot]));
+          std::push_heap(heap.begin(), heap.end());
+        } else if( sqrDist < heap.front().first ) {
+          std::pop_heap(heap.begin(), heap.end());
+          heap.back() = Candidate(sqrDist, _indices[slot]);
+          std::push_heap(heap.begin(), heap.end());
+        }
+      };
+
+      // Search rings of cells at increasing Chebyshev distance from the point's cell, starting at the occupied range.
+      const Cell c = cellOf(point);
+      int ring = 0;
+      ring = std::max(ring, std::max(_boundsMin.x - c.x, c.x - _boundsMax.x));
+      ring = std::max(ring, std::max(_boundsMin.y - c.y, c.y - _boundsMax.y));
+      ring = std::max(ring, std::max(_boundsMin.z - c.z, c.z - _boundsMax.z));
+      for( ;; ++ring ) {
+        const int x0 = std::max(c.x - ring, _boundsMin.x), x1 = std::min(c.x + ring, _boundsMax.x);
+        const int y0 = std::max(c.y - ring, _boundsMin.y), y1 = std::min(c.y + ring, _boundsMax.y);
+        const int z0 = std::max(c.z - ring, _boundsMin.z), z1 = std::min(c.z + ring, _boundsMax.z);
+        for( int z = z0; z <= z1; ++z ) {
+          for( int y = y0; y <= y1; ++y ) {
+            if( std::abs(z - c.z) == ring || std::abs(y - c.y) == ring ) {
+              for( int x = x0; x <= x1; ++x ) {
+                visitCell(x, y, z, consider);
+              }
+            } else {
+              if( c.x - ring >= _boundsMin.x ) {
+                visitCell(c.x - ring, y, z, consider);
+              }
+              if( ring > 0 && c.x + ring <= _boundsMax.x ) {
+                visitCell(c.x + ring, y, z, consider);
+              }
+            }
+          }
+        }
+
+        // Every unvisited cell is at least ring cells away, so nothing left can beat the current kth distance.
+        if( heap.size() == k ) {
+          const T reach = static_cast<T>(ring) * _cellSize;
+          if( heap.front().first <= reach * reach ) {
+            break;
+          }
+        }
+        if( c.x - ring <= _boundsMin.x && c.x + ring >= _boundsMax.x &&
+            c.y - ring <= _boundsMin.y && c.y + ring >= _boundsMax.y &&
+            c.z - ring <= _boundsMin.z && c.z + ring >= _boundsMax.z ) {
+          break;
+        }
+      }
+
+      std::sort_heap(heap.begin(), heap.end());
+      for( std::size_t i = 0; i < heap.size(); ++i ) {
+        outIndices->push_back(heap[i].second);
+        if( outSqrDistances != nullptr ) {
+          outSqrDistances->push_back(heap[i].first);
+        }
+      }
+      return static_cast<unsigned int>(heap.size());
+    }
+
+    template<typename T>
+    inline T SpatialHashGrid<T>::cellSize() const {
+      return _cellSize;
+    }
+
+    template<typename T>
+    inline unsigned int SpatialHashGrid<T>::pointCount() const {
+      return static_cast<unsigned int>(_points.size());
+    }
+
+    template<typename T>
+    inline unsigned int SpatialHashGrid<T>::tableSize() const {
+      return _tableMask + 1;
+    }
+
+    template<typename T>
+    inline typename SpatialHashGrid<T>::Cell SpatialHashGrid<T>::cellOf( const Vec3<T>& point ) const {
+      // Truncate and correct negative values rather than calling floor, which is not always inlined.
+      const T x = point.x * _invCellSize;
+      const T y = point.y * _invCellSize;
+      const T z = point.z * _invCellSize;
+      Cell c;
+      c.x = static_cast<int>(x);
+      c.y = static_cast<int>(y);
+      c.z = static_cast<int>(z);
+      c.x -= (x < static_cast<T>(c.x)) ? 1 : 0;
+      c.y -= (y < static_cast<T>(c.y)) ? 1 : 0;
+      c.z -= (z < static_cast<T>(c.z)) ? 1 : 0;
+      return c;
+    }
+
+    template<typename T>
+    inline unsigned int SpatialHashGrid<T>::hashCell( int x, int y, int z ) const {
+      /* Optimized Spatial Hashing for Collision Detection of Deformable Objects - Teschner et al. */
+      const unsigned int h = (static_cast<unsigned int>(x) * 73856093u) ^ (static_cast<unsigned int>(y) * 19349663u) ^ (static_cast<unsigned int>(z) * 83492791u);
+      return h & _tableMask;
+    }
+
+    template<typename T>
+    inline bool SpatialHashGrid<T>::inCell( const Vec3<T>& point, int x, int y, int z ) const {
+      const Cell c = cellOf(point);
+      return c.x == x && c.y == y && c.z == z;
+    }
+
+    template<typename T>
+    template<typename Func>
+    inline void SpatialHashGrid<T>::visitCell( int x, int y, int z, Func func ) const {
+      // Other cells may share the bucket; skipping their points stops a query from seeing any point twice.
+      const unsigned int bucket = hashCell(x, y, z);
+      const unsigned int end = _cellStart[bucket + 1];
+      for( unsigned int slot = _cellStart[bucket]; slot < end; ++slot ) {
+        if( inCell(_points[slot], x, y, z) ) {
+          func(slot);
+        }
+      }
+    }
+  } /* math */
+} /* cc */
@@ -0,0 +1,74 @@
+#ifndef __CC_MATH_STRIDEDSPAN__
+#define __CC_MATH_STRIDEDSPAN__
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace cc {
+  namespace math {
+    /**
+     * Non-owning view of elements spaced a fixed number of bytes apart.  Lets bulk functions read positions
+     * in place from interleaved vertex buffers, e.g. for a position/normal/uv layout of 32 bytes per vertex:
+     *   StridedSpan<const Vec3f> positions(reinterpret_cast<const Vec3f*>(vertexData), vertexCount, 32);
+     * Contiguous storage (a std::vector or plain array) is the special case where the stride equals sizeof(T).
+     */
+    template<typename T>
+    class StridedSpan {
+    public:
+      typedef typename std::remove_const<T>::type value_type;
+
+      inline StridedSpan()
+        : _data(nullptr), _count(0), _stride(sizeof(T)) {
+      }
+      inline StridedSpan( T* data, std::size_t count, std::size_t byteStride=sizeof(T) )
+        : _data(data), _count(count), _stride(byteStride) {
+      }
+      inline StridedSpan( std::vector<value_type>& vec )
+        : _data(vec.empty() ? nullptr : &vec[0]), _count(vec.size()), _stride(sizeof(T)) {
+      }
+      // Only available when T is const.
+      template<typename U>
+      inline StridedSpan( const std::vector<U>& vec, typename std::enable_if<std::is_const<T>::value && std::is_same<U, value_type>::value>::type* = nullptr )
+        : _data(vec.empty() ? nullptr : &vec[0]), _count(vec.size()), _stride(sizeof(T)) {
+      }
+      // Allows a mutable span to be passed where a const one is expected.
+      inline StridedSpan( const StridedSpan<value_type>& rhs )
+        : _data(rhs.data()), _count(rhs.size()), _stride(rhs.stride()) {
+      }
+
+      // Accessors.
+      inline T& operator[]( std::size_t index ) const {
+        assert(index < _count);
+        return *reinterpret_cast<T*>(reinterpret_cast<BytePtr>(_data) + index * _stride);
+      }
+
+      inline T*          data        () const { return _data; }
+      inline std::size_t size        () const { return _count; }
+      inline bool        empty       () const { return _count == 0; }
+      inline std::size_t stride      () const { return _stride; }
+      inline bool        isContiguous() const { return _stride == sizeof(T); }
+
+      /**
+       * Returns a view of a sub-range of this span.
+       * @param[in] offset Index of the first element of the sub-range.
+       * @param[in] count  Number of elements in the sub-range.
+       * @return View of the sub-range with the same stride.
+       */
+      inline StridedSpan<T> subspan( std::size_t offset, std::size_t count ) const {
+        assert(offset + count <= _count);
+        return StridedSpan<T>((count == 0) ? _data : &(*this)[offset], count, _stride);
+      }
+
+    private:
+      typedef typename std::conditional<std::is_const<T>::value, const char*, char*>::type BytePtr;
+
+      T*          _data;
+      std::size_t _count;
+      std::size_t _stride;
+    };
+  } /* math */
+} /* cc */
+
+#endif /* __CC_MATH_STRIDEDSPAN__ */
@@ -0,0 +1,90 @@
+#ifndef __CC_MATH_SWEEPANDPRUNE__
+#define __CC_MATH_SWEEPANDPRUNE__
+
+#include <vector>
+#include "Vec3.hpp"
+#include "Aabb.hpp"
+#include "StridedSpan.hpp"
+
+namespace cc {
+  namespace math {
+    /**
+     * A pair of overlapping objects reported by a broadphase.  Indices refer to the input arrays, with first < second.
+     */
+    struct BroadphasePair {
+      unsigned int first;
+      unsigned int second;
+    };
+
+    /**
+     * Incremental sweep-and-prune broadphase over a set of boxes or spheres that is updated every frame.
+     * Objects are kept sorted by their lower bound on the axis along which their centers are most spread out.
+     * Between updates objects move only a little, so the order from the previous frame is nearly sorted and an
+     * insertion sort restores it in close to linear time.  A sweep over the sorted bounds then only tests
+     * objects whose intervals overlap on that axis.
+     * All buffers are kept between updates, so once the object and pair counts settle an update never allocates.
+     */
+    template<typename T>
+    class SweepAndPrune {
+    public:
+      inline SweepAndPrune();
+
+      /**
+       * Updates the objects as boxes and finds all overlapping pairs.
+       * @param[in] boxes Bounds of every object; may be strided.  Touching boxes count as overlapping.
+       * @return Number of overlapping pairs.
+       */
+      inline unsigned int update( StridedSpan<const Aabb<T> > boxes );
+      inline unsigned int update( const std::vector<Aabb<T> >& boxes );
+
+      /**
+       * Updates the objects as spheres and finds all overlapping pairs.
+       * Pairs whose bounds overlap are confirmed with an exact sphere test before being reported.
+       * @param[in] centers Center of every sphere; may be strided.
+       * @param[in] radii   Radius of every sphere; may be strided.  Must be the same size as centers.
+       * @return Number of overlapping pairs.
+       */
+      inline unsigned int update( StridedSpan<const Vec3<T> > centers, StridedSpan<const T> radii );
+      inline unsigned int update( const std::vector<Vec3<T> >& centers, const std::vector<T>& radii );
+
+      // Releases all buffers.  The next update sorts from scratch.
+      inline void clear();
+
+      // Overlapping pairs found by the last update, in sweep order.
+      inline const std::vector<BroadphasePair>& pairs() const;
+
+      // Axis (0, 1 or 2) the objects are currently sorted along.
+      inline int axis() const;
+
+    private:
+      // Interval of an object on the sort axis, stored next to its index so the sweep reads memory in order.
+      struct Endpoints {
+        T            lower;
+        T            upper;
+        unsigned int index;
+      };
+
+      inline void chooseAxis   ();
+      inline void sortEndpoints( bool resort );
+      inline void sweep        ();
+
+    private:
+      std::vector<Aabb<T> >        _boxes;
+      std::vector<Vec3<T> >        _centers; // Only used for spheres.
+      std::vector<T>               _radii;   // Only used for spheres.
+      std::vector<Endpoints>       _endpoints;
+      std::vector<BroadphasePair>  _pairs;
+      int                          _axis;
+      bool                         _spheres;
+    };
+  } /* math */
+
+  // Typedefs.
+  typedef cc::math::SweepAndPrune<float>  SweepAndPrunef;
+  typedef cc::math::SweepAndPrune<double> SweepAndPruned;
+
+} /* cc */
+
+#include "SweepAndPrune.inl"
+
+#endif /* __CC_MATH_SWEEPANDPRUNE__ */
@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <cassert>
+#include "SweepAndPrune.hpp"
+
+namespace cc {
+  namespace math {
+    template<typename T>
+    inline SweepAndPrune<T>::SweepAndPrune()
+      : _axis(0), _spheres(false) {
+    }
+
+    template<typename T>
+    inline unsigned int SweepAndPrune<T>::update( StridedSpan<const Aabb<T> > boxes ) {
+      // A change in count means objects were added or removed, so the previous order is no longer useful.
+      const bool resort = (boxes.size() != _boxes.size()) || _spheres;
+      _boxes.resize(boxes.size());
+      for( std::size_t i = 0; i < boxes.size(); ++i ) {
+        _boxes[i] = boxes[i];
+      }
+      _spheres = false;
+
+      const int oldAxis = _axis;
+      chooseAxis();
+      sortEndpoints(resort || (_axis != oldAxis));
+      sweep();
+      return static_cast<unsigned int>(_pairs.size());
+    }
+
+    template<typename T>
+    inline unsigned int SweepAndPrune<T>::update( const std::vector<Aabb<T> >& boxes ) {
+      return update(StridedSpan<const Aabb<T> >(boxes));
+    }
+
+    template<typename T>
+    inline unsigned int SweepAndPrune<T>::update( StridedSpan<const Vec3<T> > centers, StridedSpan<const T> radii ) {
+      assert(centers.size() == radii.size());
+      const bool resort = (centers.size() != _boxes.size()) || !_spheres;
+      _boxes.resize(centers.size());
+      _centers.resize(centers.size());
+      _radii.resize(centers.size());
+      for( std::size_t i = 0; i < centers.size(); ++i ) {
+        const Vec3<T> extent(radii[i]);
+        _centers[i] = centers[i];
+        _radii[i] = radii[i];
+        _boxes[i].boundsMin = centers[i] - extent;
+        _boxes[i].boundsMax = centers[i] + extent;
+      }
+      _spheres = true;
+
+      const int oldAxis = _axis;
+      chooseAxis();
+      sortEndpoints(resort || (_axis != oldAxis));
+      sweep();
+      return static_cast<unsigned int>(_pairs.size());
+    }
+
+    template<typename T>
+    inline unsigned int SweepAndPrune<T>::update( const std::vector<Vec3<T> >& centers, const std::vector<T>& radii ) {
+      return update(StridedSpan<const Vec3<T> >(centers), StridedSpan<const T>(radii));
+    }
+
+    template<typename T>
+    inline void SweepAndPrune<T>::clear() {
+      std::vector<Aabb<T> >().swap(_boxes);
+      std::vector<Vec3<T> >().swap(_centers);
+      std::vector<T>().swap(_radii);
+      std::vector<Endpoints>().swap(_endpoints);
+      std::vector<BroadphasePair>().swap(_pairs);
+      _axis = 0;
+      _spheres = false;
+    }
+
+    template<typename T>
+    inline const std::vector<BroadphasePair>& SweepAndPrune<T>::pairs() const {
+      return _pairs;
+    }
+
+    template<typename T>
+    inline int SweepAndPrune<T>::axis() const {
+      return _axis;
+    }
+
+    template<typename T>
+    inline void SweepAndPrune<T>::chooseAxis() {
+      if( _boxes.empty() ) {
+        return;
+      }
+
+      // Sweep along the axis of greatest center variance, as that separates the most intervals.
+      Vec3<T> sum(static_cast<T>(0));
+      Vec3<T> sumSqr(static_cast<T>(0));
+      for( std::size_t i = 0; i < _boxes.size(); ++i ) {
+        const Vec3<T> c = _boxes[i].boundsMin + _boxes[i].boundsMax;
+        sum += c;
+        sumSqr += Vec3<T>(c.x * c.x, c.y * c.y, c.z * c.z);
+      }
+      const T invCount = static_cast<T>(1) / static_cast<T>(_boxes.size());
+      Vec3<T> variance;
+      for( int i = 0; i < 3; ++i ) {
+        const T mean = sum[i] * invCount;
+        variance[i] = sumSqr[i] * invCount - mean * mean;
+      }
+
+      // Only switch axis on a clear win; each switch costs a full sort.
+      int best = _axis;
+      for( int i = 0; i < 3; ++i ) {
+        if( variance[i] > variance[best] * static_cast<T>(1.25) ) {
+          best = i;
+        }
+      }
+      _axis = best;
+    }
+
+    template<typename T>
+    inline void SweepAndPrune<T>::sortEndpoints( bool resort ) {
+      const std::size_t count = _boxes.size();
+      if( resort ) {
+        _endpoints.resize(count);
+        for( std::size_t i = 0; i < count; ++i ) {
+          _endpoints[i].index = static_cast<unsigned int>(i);
+        }
+      }
+
+      // Refresh the intervals in their existing order.
+      for( std::size_t i = 0; i < count; ++i ) {
+        Endpoints& ep = _endpoints[i];
+        ep.lower = _boxes[ep.index].boundsMin[_axis];
+        ep.upper = _boxes[ep.index].boundsMax[_axis];
+      }
+
+      if( resort ) {
+        std::sort(_endpoints.begin(), _endpoints.end(), []( const Endpoints& lhs, const Endpoints& rhs ) {
+          return lhs.lower < rhs.lower;
+        });
+        return;
+      }
+
+      // Insertion sort; nearly linear when the objects moved little since the last update.
+      for( std::size_t i = 1; i < count; ++i ) {
+        const Endpoints ep = _endpoints[i];
+        std::size_t j = i;
+        while( j > 0 && _endpoints[j - 1].lower > ep.lower ) {
+          _endpoints[j] = _endpoints[j - 1];
+          --j;
+        }
+        _endpoints[j] = ep;
+      }
+    }
+
+    template<typename T>
+    inline void SweepAndPrune<T>::sweep() {
+      _pairs.clear();
+      const std::size_t count = _endpoints.size();
+      const int axis1 = (_axis + 1) % 3;
+      const int axis2 = (_axis + 2) % 3;
+      for( std::size_t i = 0; i < count; ++i ) {
+        const Endpoints& ep = _endpoints[i];
+        const Aabb<T>& box = _boxes[ep.index];
+        // Every later interval starts at or after this one, so stop at the first that starts beyond its end.
+        for( std::size_t j = i + 1; j < count && _endpoints[j].lower <= ep.upper; ++j ) {
+          const unsigned int other = _endpoints[j].index;
+          const Aabb<T>& otherBox = _boxes[other];
+          if( box.boundsMin[axis1] > otherBox.boundsMax[axis1] || box.boundsMax[axis1] < otherBox.boundsMin[axis1] ||
+              box.boundsMin[axis2] > otherBox.boundsMax[axis2] || box.boundsMax[axis2] < otherBox.boundsMin[axis2] ) {
+            continue;
+          }
+          if( _spheres ) {
+            const T radius = _radii[ep.index] + _radii[other];
+            if( _centers[ep.index].sqrDistance(_centers[other]) > radius * radius ) {
+              continue;
+            }
+          }
+          BroadphasePair pair;
+          pair.first = std::min(ep.index, other);
+          pair.second = std::max(ep.index, other);
+          _pairs.push_back(pair);
+        }
+      }
+    }
+  } /* math */
+} /* cc */
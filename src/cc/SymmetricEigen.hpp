@@ -0,0 +1,244 @@
+#ifndef __CC_MATH_SYMMETRICEIGEN__
+#define __CC_MATH_SYMMETRICEIGEN__
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include "Vec3.hpp"
+#include "Vec3Soa.hpp"
+#include "StridedSpan.hpp"
+#include "Parallel.hpp"
+
+namespace cc {
+  namespace math {
+    // Symmetric 3x3 matrix, such as a covariance or inertia tensor, stored as its upper triangle.
+    template<typename T>
+    struct SymMat3 {
+      T xx, xy, xz;
+      T     yy, yz;
+      T         zz;
+
+      inline SymMat3() : xx(0), xy(0), xz(0), yy(0), yz(0), zz(0) {}
+      inline SymMat3( T xx, T xy, T xz, T yy, T yz, T zz ) : xx(xx), xy(xy), xz(xz), yy(yy), yz(yz), zz(zz) {}
+
+      inline Vec3<T> operator*( const Vec3<T>& vec ) const {
+        return Vec3<T>(xx * vec.x + xy * vec.y + xz * vec.z, xy * vec.x + yy * vec.y + yz * vec.z, xz * vec.x + yz * vec.y + zz * vec.z);
+      }
+    };
+
+    // N symmetric 3x3 matrices stored as structure-of-arrays, for solving several at once in lanes.
+    template<typename T, unsigned int N>
+    struct SymMat3Soa {
+      T xx[N], xy[N], xz[N];
+      T        yy[N], yz[N];
+      T               zz[N];
+
+      inline void set( unsigned int lane, const SymMat3<T>& m ) {
+        xx[lane] = m.xx; xy[lane] = m.xy; xz[lane] = m.xz;
+        yy[lane] = m.yy; yz[lane] = m.yz;
+        zz[lane] = m.zz;
+      }
+
+      inline SymMat3<T> get( unsigned int lane ) const {
+        return SymMat3<T>(xx[lane], xy[lane], xz[lane], yy[lane], yz[lane], zz[lane]);
+      }
+    };
+
+    /**
+     * Computes the mean and covariance of a set of points.  Large inputs are split across threads; each sums its points
+     * relative to the first point, which keeps the sums small for points far from the origin.
+     * @param[in]  points  Points to measure; may be strided.
+     * @param[out] outMean Mean of the points.  Optional.
+     * @return Covariance of the points (divided by the number of points), or zero if there are none.
+     */
+    template<typename T>
+    inline SymMat3<T> computeCovariance( StridedSpan<const Vec3<T> > points, Vec3<T>* outMean ) {
+      struct Sums {
+        Vec3<T>    sum;
+        SymMat3<T> products;
+      };
+
+      if( points.empty() ) {
+        if( outMean != nullptr ) {
+          *outMean = Vec3<T>(static_cast<T>(0));
+        }
+        return SymMat3<T>();
+      }
+
+      const Vec3<T> shift = points[0];
+      std::vector<Sums> partial(parallelThreadCount());
+      const unsigned int chunks = parallelFor(points.size(), 1 << 16, [&]( std::size_t begin, std::size_t end, unsigned int chunk ) {
+        Sums s;
+        s.sum = Vec3<T>(static_cast<T>(0));
+        for( std::size_t i = begin; i < end; ++i ) {
+          const Vec3<T> d = points[i] - shift;
+          s.sum += d;
+          s.products.xx += d.x * d.x; s.products.xy += d.x * d.y; s.products.xz += d.x * d.z;
+          s.products.yy += d.y * d.y; s.products.yz += d.y * d.z;
+          s.products.zz += d.z * d.z;
+        }
+        partial[chunk] = s;
+      });
+
+      Vec3<T> sum(static_cast<T>(0));
+      SymMat3<T> products;
+      for( unsigned int c = 0; c < chunks; ++c ) {
+        sum += partial[c].sum;
+        products.xx += partial[c].products.xx; products.xy += partial[c].products.xy; products.xz += partial[c].products.xz;
+        products.yy += partial[c].products.yy; products.yz += partial[c].products.yz;
+        products.zz += partial[c].products.zz;
+      }
+
+      const T invCount = static_cast<T>(1) / static_cast<T>(points.size());
+      const Vec3<T> m = sum * invCount;
+      if( outMean != nullptr ) {
+        *outMean = shift + m;
+      }
+      return SymMat3<T>(products.xx * invCount - m.x * m.x, products.xy * invCount - m.x * m.y, products.xz * invCount - m.x * m.z,
+                        products.yy * invCount - m.y * m.y, products.yz * invCount - m.y * m.z,
+                        products.zz * invCount - m.z * m.z);
+    }
+
+    template<typename T>
+    inline SymMat3<T> computeCovariance( const std::vector<Vec3<T> >& points, Vec3<T>* outMean ) {
+      return computeCovariance(StridedSpan<const Vec3<T> >(points), outMean);
+    }
+
+    namespace detail {
+      enum { JACOBI_SWEEPS = 6 }; // Cyclic Jacobi converges quadratically; six sweeps settle any 3x3 matrix in double precision.
+
+      // Zeroes a[p][q] in every lane with a Jacobi rotation, accumulating the rotation into the columns of v.
+      template<typename T, unsigned int N>
+      inline void jacobiRotate( T (&a)[3][3][N], T (&v)[3][3][N], unsigned int p, unsigned int q ) {
+        /* Numerical Recipes, 3rd edition - Section 11.1 */
+        const unsigned int r = 3 - p - q;
+        for( unsigned int k = 0; k < N; ++k ) {
+          const T apq = a[p][q][k];
+          // An exact zero is already done; select it out rather than branch, so the lanes stay independent.
+          const bool done = (apq == static_cast<T>(0));
+          const T theta = (a[q][q][k] - a[p][p][k]) / (static_cast<T>(2) * (done ? static_cast<T>(1) : apq));
+          const T t0 = static_cast<T>(1) / (std::abs(theta) + std::sqrt(theta * theta + static_cast<T>(1)));
+          const T t = done ? static_cast<T>(0) : ((theta < static_cast<T>(0)) ? -t0 : t0);
+          const T c = static_cast<T>(1) / std::sqrt(t * t + static_cast<T>(1));
+          const T s = t * c;
+
+          a[p][p][k] -= t * apq;
+          a[q][q][k] += t * apq;
+          a[p][q][k] = a[q][p][k] = static_cast<T>(0);
+          const T arp = a[r][p][k];
+          const T arq = a[r][q][k];
+          a[r][p][k] = a[p][r][k] = c * arp - s * arq;
+          a[r][q][k] = a[q][r][k] = s * arp + c * arq;
+          for( unsigned int i = 0; i < 3; ++i ) {
+            const T vip = v[i][p][k];
+            const T viq = v[i][q][k];
+            v[i][p][k] = c * vip - s * viq;
+            v[i][q][k] = s * vip + c * viq;
+          }
+        }
+      }
+
+      // Swaps eigenpairs i and j in the lanes where value j is larger.
+      template<typename T, unsigned int N>
+      inline void eigenSortPair( T (&a)[3][3][N], T (&v)[3][3][N], unsigned int i, unsigned int j ) {
+        for( unsigned int k = 0; k < N; ++k ) {
+          const bool swap = a[j][j][k] > a[i][i][k];
+          const T ai = a[i][i][k];
+          const T aj = a[j][j][k];
+          a[i][i][k] = swap ? aj : ai;
+          a[j][j][k] = swap ? ai : aj;
+          for( unsigned int row = 0; row < 3; ++row ) {
+            const T vi = v[row][i][k];
+            const T vj = v[row][j][k];
+            v[row][i][k] = swap ? vj : vi;
+            v[row][j][k] = swap ? vi : vj;
+          }
+        }
+      }
+    } /* detail */
+
+    /**
+     * Computes the eigenvalues and eigenvectors of N symmetric 3x3 matrices at once with cyclic Jacobi rotations.
+     * Every lane runs the same fixed number of sweeps with no data-dependent branches, so 4 or 8 matrices are solved for
+     * about the cost of one.
+     * @param[in]  matrices   Matrices to decompose.
+     * @param[out] outValues  Eigenvalues of each lane, largest in x and smallest in z.  Optional.
+     * @param[out] outVectors Unit eigenvectors matching x, y and z of outValues, forming a right-handed basis.  Optional; three entries.
+     */
+    template<typename T, unsigned int N>
+    inline void symmetricEigen( const SymMat3Soa<T, N>& matrices, Vec3Soa<T, N>* outValues, Vec3Soa<T, N>* outVectors ) {
+      T a[3][3][N];
+      T v[3][3][N];
+      for( unsigned int k = 0; k < N; ++k ) {
+        a[0][0][k] = matrices.xx[k]; a[0][1][k] = matrices.xy[k]; a[0][2][k] = matrices.xz[k];
+        a[1][0][k] = matrices.xy[k]; a[1][1][k] = matrices.yy[k]; a[1][2][k] = matrices.yz[k];
+        a[2][0][k] = matrices.xz[k]; a[2][1][k] = matrices.yz[k]; a[2][2][k] = matrices.zz[k];
+        for( unsigned int i = 0; i < 3; ++i ) {
+          for( unsigned int j = 0; j < 3; ++j ) {
+            v[i][j][k] = (i == j) ? static_cast<T>(1) : static_cast<T>(0);
+          }
+        }
+      }
+
+      for( unsigned int sweep = 0; sweep < detail::JACOBI_SWEEPS; ++sweep ) {
+        detail::jacobiRotate(a, v, 0, 1);
+        detail::jacobiRotate(a, v, 0, 2);
+        detail::jacobiRotate(a, v, 1, 2);
+      }
+      detail::eigenSortPair(a, v, 0, 1);
+      detail::eigenSortPair(a, v, 1, 2);
+      detail::eigenSortPair(a, v, 0, 1);
+
+      if( outValues != nullptr ) {
+        for( unsigned int k = 0; k < N; ++k ) {
+          outValues->x[k] = a[0][0][k];
+          outValues->y[k] = a[1][1][k];
+          outValues->z[k] = a[2][2][k];
+        }
+      }
+      if( outVectors != nullptr ) {
+        for( unsigned int k = 0; k < N; ++k ) {
+          for( unsigned int j = 0; j < 2; ++j ) {
+            outVectors[j].x[k] = v[0][j][k];
+            outVectors[j].y[k] = v[1][j][k];
+            outVectors[j].z[k] = v[2][j][k];
+          }
+          // The rotations keep the basis orthonormal but sorting may flip its handedness; the cross product fixes both.
+          outVectors[2].x[k] = v[1][0][k] * v[2][1][k] - v[2][0][k] * v[1][1][k];
+          outVectors[2].y[k] = v[2][0][k] * v[0][1][k] - v[0][0][k] * v[2][1][k];
+          outVectors[2].z[k] = v[0][0][k] * v[1][1][k] - v[1][0][k] * v[0][1][k];
+        }
+      }
+    }
+
+    /**
+     * Computes the eigenvalues and eigenvectors of a symmetric 3x3 matrix with cyclic Jacobi rotations.
+     * @param[in]  matrix     Matrix to decompose.
+     * @param[out] outValues  Eigenvalues, largest in x and smallest in z.  Optional.
+     * @param[out] outVectors Unit eigenvectors matching x, y and z of outValues, forming a right-handed basis.  Optional; three entries.
+     */
+    template<typename T>
+    inline void symmetricEigen( const SymMat3<T>& matrix, Vec3<T>* outValues, Vec3<T>* outVectors ) {
+      SymMat3Soa<T, 1> lane;
+      lane.set(0, matrix);
+      Vec3Soa<T, 1> values;
+      Vec3Soa<T, 1> vectors[3];
+      symmetricEigen(lane, &values, vectors);
+      if( outValues != nullptr ) {
+        *outValues = values.get(0);
+      }
+      if( outVectors != nullptr ) {
+        for( unsigned int i = 0; i < 3; ++i ) {
+          outVectors[i] = vectors[i].get(0);
+        }
+      }
+    }
+  } /* math */
+
+  // Typedefs.
+  typedef cc::math::SymMat3<float>  SymMat3f;
+  typedef cc::math::SymMat3<double> SymMat3d;
+
+} /* cc */
+
+#endif /* __CC_MATH_SYMMETRICEIGEN__ */
@@ -1,7 +1,12 @@
 #ifndef __CC_MATH_TRIMATH__
 #define	__CC_MATH_TRIMATH__
 
+#include <cmath>
+#include <cstddef>
+#include <vector>
 #include "Vec3.hpp"
+#include "Parallel.hpp"
+#include "StridedSpan.hpp"
 
 namespace cc {
   namespace math {
@@ -29,6 +34,144 @@ namespace cc {
       // Won't work w/ ints because of 0.5, but fuck it, who uses integer triangles?
       return computeTriangleNormal<T>(p0, p1, p2).magnitude() * static_cast<T>(0.5);
     }
+
+    /**
+     * How face normals are weighted when averaged into vertex normals.
+     */
+    enum VertexNormalWeighting {
+      WEIGHT_BY_AREA,  /**< Larger faces count for more.  Cheapest; no square roots in the face pass. */
+      WEIGHT_BY_ANGLE  /**< Each face counts by its angle at the vertex, so the result does not depend on how faces are split. */
+    };
+
+    /**
+     * Faces around each vertex of an indexed triangle mesh, stored compressed: the corners touching vertex v are
+     * corners[offsets[v], offsets[v + 1]), where corner c is position c % 3 of triangle c / 3.
+     * Depends only on the indices, so a deforming mesh builds it once and reuses it every frame.
+     */
+    struct VertexFaceAdjacency {
+      std::vector<unsigned int> offsets;
+      std::vector<unsigned int> corners;
+
+      /**
+       * Builds the adjacency with a counting sort over the corners.
+       * @param[in] vertexCount Number of vertices; every index must be less than this.
+       * @param[in] indices     Triangle list; three indices per triangle.
+       */
+      inline void build( std::size_t vertexCount, const std::vector<unsigned int>& indices ) {
+        const std::size_t cornerCount = (indices.size() / 3) * 3;
+        offsets.assign(vertexCount + 1, 0u);
+        for( std::size_t c = 0; c < cornerCount; ++c ) {
+          ++offsets[indices[c] + 1];
+        }
+        for( std::size_t v = 0; v < vertexCount; ++v ) {
+          offsets[v + 1] += offsets[v];
+        }
+        corners.resize(cornerCount);
+        std::vector<unsigned int> cursor(offsets.begin(), offsets.end() - 1);
+        for( std::size_t c = 0; c < cornerCount; ++c ) {
+          corners[cursor[indices[c]]++] = static_cast<unsigned int>(c);
+        }
+      }
+    };
+
+    /**
+     * Computes smooth per-vertex normals of an indexed triangle mesh.
+     * Runs in two parallel passes with no atomics: face normals (and corner angles) are computed per face, then each
+     * vertex gathers from its own faces through the adjacency and is normalized, eight vertices per step in
+     * independent lanes.  Vertices used by no face, or only by degenerate faces, get a zero normal.
+     * @param[in]  positions  Vertex positions; may be strided, e.g. inside an interleaved vertex buffer.
+     * @param[in]  indices    Triangle list; three indices into positions per triangle.
+     * @param[in]  adjacency  Faces around each vertex, built from the same indices.
+     * @param[out] outNormals Unit normal of each vertex, facing the side from which faces wind counter-clockwise.  Resized to the number of positions.
+     * @param[in]  weighting  How each face's normal is weighted.
+     */
+    template<typename T>
+    inline void computeVertexNormals( StridedSpan<const Vec3<T> > positions, const std::vector<unsigned int>& indices, const VertexFaceAdjacency& adjacency, std::vector<Vec3<T> >* outNormals, VertexNormalWeighting weighting=WEIGHT_BY_AREA ) {
+      if( outNormals == nullptr ) {
+        return;
+      }
+      const std::size_t vertexCount = positions.size();
+      const std::size_t triCount = indices.size() / 3;
+      outNormals->resize(vertexCount);
+      const bool byAngle = (weighting == WEIGHT_BY_ANGLE);
+
+      // Face pass.  By area, the raw cross product already has length twice the area.  By angle, the unit normal and
+      // the angle at each corner.
+      std::vector<Vec3<T> > faceNormals(triCount);
+      std::vector<T> cornerAngles(byAngle ? triCount * 3 : 0);
+      parallelFor(triCount, 1 << 14, [&]( std::size_t begin, std::size_t end, unsigned int ) {
+        for( std::size_t f = begin; f < end; ++f ) {
+          const Vec3<T> p[3] = { positions[indices[f * 3 + 0]], positions[indices[f * 3 + 1]], positions[indices[f * 3 + 2]] };
+          const Vec3<T> n = (p[1] - p[0]).cross(p[2] - p[0]);
+          if( !byAngle ) {
+            faceNormals[f] = n;
+            continue;
+          }
+          const T length = n.magnitude();
+          faceNormals[f] = (length > static_cast<T>(0)) ? n * (static_cast<T>(1) / length) : Vec3<T>(static_cast<T>(0));
+          for( unsigned int k = 0; k < 3; ++k ) {
+            const Vec3<T> e0 = p[(k + 1) % 3] - p[k];
+            const Vec3<T> e1 = p[(k + 2) % 3] - p[k];
+            cornerAngles[f * 3 + k] = std::atan2(e0.cross(e1).magnitude(), e0.dot(e1));
+          }
+        }
+      });
+
+      // Vertex pass.  Each vertex only reads its own faces, so threads never write the same normal.
+      parallelFor(vertexCount, 1 << 14, [&]( std::size_t begin, std::size_t end, unsigned int ) {
+        enum { LANES = 8 };
+        for( std::size_t first = begin; first < end; first += LANES ) {
+          const unsigned int count = static_cast<unsigned int>((end - first < LANES) ? end - first : static_cast<std::size_t>(LANES));
+          T x[LANES], y[LANES], z[LANES];
+          for( unsigned int k = 0; k < LANES; ++k ) {
+            Vec3<T> sum(static_cast<T>(0));
+            if( k < count ) {
+              const std::size_t v = first + k;
+              for( unsigned int i = adjacency.offsets[v]; i < adjacency.offsets[v + 1]; ++i ) {
+                const unsigned int corner = adjacency.corners[i];
+                sum += byAngle ? faceNormals[corner / 3] * cornerAngles[corner] : faceNormals[corner / 3];
+              }
+            }
+            x[k] = sum.x;
+            y[k] = sum.y;
+            z[k] = sum.z;
+          }
+          for( unsigned int k = 0; k < LANES; ++k ) {
+            const T sqrLength = x[k] * x[k] + y[k] * y[k] + z[k] * z[k];
+            const T scale = (sqrLength > static_cast<T>(0)) ? static_cast<T>(1) / std::sqrt(sqrLength) : static_cast<T>(0);
+            x[k] *= scale;
+            y[k] *= scale;
+            z[k] *= scale;
+          }
+          for( unsigned int k = 0; k < count; ++k ) {
+            (*outNormals)[first + k] = Vec3<T>(x[k], y[k], z[k]);
+          }
+        }
+      });
+    }
+
+    /**
+     * Computes smooth per-vertex normals of an indexed triangle mesh, building the vertex-to-face adjacency on the way.
+     * To re-normal a deforming mesh every frame, build a VertexFaceAdjacency once and use the overload taking it.
+     * @param[in]  positions  Vertex positions; may be strided.
+     * @param[in]  indices    Triangle list; three indices into positions per triangle.
+     * @param[out] outNormals Unit normal of each vertex.  Resized to the number of positions.
+     * @param[in]  weighting  How each face's normal is weighted.
+     */
+    template<typename T>
+    inline void computeVertexNormals( StridedSpan<const Vec3<T> > positions, const std::vector<unsigned int>& indices, std::vector<Vec3<T> >* outNormals, VertexNormalWeighting weighting=WEIGHT_BY_AREA ) {
+      VertexFaceAdjacency adjacency;
+      adjacency.build(positions.size(), indices);
+      computeVertexNormals(positions, indices, adjacency, outNormals, weighting);
+    }
+    template<typename T>
+    inline void computeVertexNormals( const std::vector<Vec3<T> >& positions, const std::vector<unsigned int>& indices, std::vector<Vec3<T> >* outNormals, VertexNormalWeighting weighting=WEIGHT_BY_AREA ) {
+      computeVertexNormals(StridedSpan<const Vec3<T> >(positions), indices, outNormals, weighting);
+    }
+    template<typename T>
+    inline void computeVertexNormals( const std::vector<Vec3<T> >& positions, const std::vector<unsigned int>& indices, const VertexFaceAdjacency& adjacency, std::vector<Vec3<T> >* outNormals, VertexNormalWeighting weighting=WEIGHT_BY_AREA ) {
+      computeVertexNormals(StridedSpan<const Vec3<T> >(positions), indices, adjacency, outNormals, weighting);
+    }
   }
 }
 
@@ -0,0 +1,49 @@
+#ifndef __CC_MATH_VEC3SOA__
+#define __CC_MATH_VEC3SOA__
+
+#include "Vec3.hpp"
+
+namespace cc {
+  namespace math {
+    /**
+     * N three-component vectors stored as structure-of-arrays.  Batched queries loop over the lanes with
+     * no data-dependent branches, so each component array is processed as one packed register (4 or 8 wide).
+     */
+    template<typename T, unsigned int N>
+    struct Vec3Soa {
+      T x[N];
+      T y[N];
+      T z[N];
+
+      inline Vec3Soa() {
+      }
+
+      // Broadcasts a single vector to every lane.
+      inline explicit Vec3Soa( const Vec3<T>& v ) {
+        for( unsigned int k = 0; k < N; ++k ) {
+          x[k] = v.x;
+          y[k] = v.y;
+          z[k] = v.z;
+        }
+      }
+
+      inline void set( unsigned int lane, const Vec3<T>& v ) {
+        x[lane] = v.x;
+        y[lane] = v.y;
+        z[lane] = v.z;
+      }
+
+      inline Vec3<T> get( unsigned int lane ) const {
+        return Vec3<T>(x[lane], y[lane], z[lane]);
+      }
+    };
+  } /* math */
+
+  // Typedefs.
+  typedef cc::math::Vec3Soa<float, 4>  Vec3Soa4f;
+  typedef cc::math::Vec3Soa<float, 8>  Vec3Soa8f;
+  typedef cc::math::Vec3Soa<double, 4> Vec3Soa4d;
+
+} /* cc */
+
+#endif /* __CC_MATH_VEC3SOA__ */
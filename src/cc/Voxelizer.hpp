@@ -0,0 +1,93 @@
+#ifndef __CC_MATH_VOXELIZER__
+#define __CC_MATH_VOXELIZER__
+
+#include <cstdint>
+#include <vector>
+#include "Vec3.hpp"
+#include "Aabb.hpp"
+#include "StridedSpan.hpp"
+
+namespace cc {
+  namespace math {
+    /**
+     * Bit-packed occupancy grid of cubic voxels.  Voxel (x, y, z) covers origin + [x, x+1) * voxelSize (and so on per axis).
+     * Bits run along x, and every row of x starts on a new 64-bit word, so rows (and z slices) never share a word.
+     */
+    template<typename T>
+    class VoxelGrid {
+    public:
+      inline VoxelGrid();
+      inline VoxelGrid( const Vec3<T>& origin, T voxelSize, unsigned int sizeX, unsigned int sizeY, unsigned int sizeZ );
+      // Covers the bounds with whole voxels, starting at their minimum corner.
+      inline VoxelGrid( const Aabb<T>& bounds, T voxelSize );
+
+      // Resizes the grid and empties it.
+      inline void reset( const Vec3<T>& origin, T voxelSize, unsigned int sizeX, unsigned int sizeY, unsigned int sizeZ );
+      // Empties every voxel.
+      inline void clear();
+
+      inline bool get( unsigned int x, unsigned int y, unsigned int z ) const;
+      inline void set( unsigned int x, unsigned int y, unsigned int z, bool occupied );
+
+      // Number of occupied voxels.
+      inline std::size_t count() const;
+
+      inline Vec3<T>      voxelCenter( unsigned int x, unsigned int y, unsigned int z ) const;
+      inline Vec3<T>      origin     () const;
+      inline T            voxelSize  () const;
+      inline unsigned int sizeX      () const;
+      inline unsigned int sizeY      () const;
+      inline unsigned int sizeZ      () const;
+
+      // Raw storage; row (y, z) starts at word (z * sizeY + y) * wordsPerRow(), and bit x % 64 of word x / 64 is voxel x.
+      inline unsigned int                      wordsPerRow() const;
+      inline std::vector<std::uint64_t>&       words      ();
+      inline const std::vector<std::uint64_t>& words      () const;
+
+    private:
+      Vec3<T>                    _origin;
+      T                          _voxelSize;
+      unsigned int               _size[3];
+      unsigned int               _wordsPerRow;
+      std::vector<std::uint64_t> _words;
+    };
+
+    /**
+     * Marks every voxel that a mesh's surface touches, using the triangle-box separating axis test.
+     * Each triangle only visits the cells of its own bounds, testing eight cells of a row per call.
+     * The grid is split into z slabs across threads, so no two threads write the same word.
+     * Existing contents of the grid are replaced.
+     * @param[in]     positions Vertex positions; may be strided, e.g. inside an interleaved vertex buffer.
+     * @param[in]     indices   Triangle list; three indices into positions per triangle.
+     * @param[in,out] grid      Grid to fill.  Its origin, voxel size and resolution are used as they are.
+     */
+    template<typename T>
+    inline void voxelizeSurface( StridedSpan<const Vec3<T> > positions, const std::vector<unsigned int>& indices, VoxelGrid<T>* grid );
+    template<typename T>
+    inline void voxelizeSurface( const std::vector<Vec3<T> >& positions, const std::vector<unsigned int>& indices, VoxelGrid<T>* grid );
+
+    /**
+     * Marks every voxel whose center is inside a closed mesh.
+     * A ray along +x through every row of voxel centers counts the triangles it crosses, and the parity of the count
+     * fills the row.  Crossings exactly on shared edges and vertices are assigned to a single triangle (as in
+     * rasterization), so watertight meshes give exact results.  Rows are split into z slabs across threads.
+     * Existing contents of the grid are replaced.
+     * @param[in]     positions Vertex positions of a closed (watertight) mesh; may be strided.
+     * @param[in]     indices   Triangle list; three indices into positions per triangle.  Winding does not matter.
+     * @param[in,out] grid      Grid to fill.  Its origin, voxel size and resolution are used as they are.
+     */
+    template<typename T>
+    inline void voxelizeSolid( StridedSpan<const Vec3<T> > positions, const std::vector<unsigned int>& indices, VoxelGrid<T>* grid );
+    template<typename T>
+    inline void voxelizeSolid( const std::vector<Vec3<T> >& positions, const std::vector<unsigned int>& indices, VoxelGrid<T>* grid );
+  } /* math */
+
+  // Typedefs.
+  typedef cc::math::VoxelGrid<float>  VoxelGridf;
+  typedef cc::math::VoxelGrid<double> VoxelGridd;
+
+} /* cc */
+
+#include "Voxelizer.inl"
+
+#endif /* __CC_MATH_VOXELIZER__ */
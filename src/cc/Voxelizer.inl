@@ -0,0 +1,330 @@
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+#include <limits>
+#include "Voxelizer.hpp"
+#include "Intersection.hpp"
+#include "Parallel.hpp"
+#include "Vec3Soa.hpp"
+
+namespace cc {
+  namespace math {
+    template<typename T>
+    inline VoxelGrid<T>::VoxelGrid()
+      : _origin(static_cast<T>(0)), _voxelSize(static_cast<T>(1)), _wordsPerRow(0) {
+      _size[0] = _size[1] = _size[2] = 0;
+    }
+
+    template<typename T>
+    inline VoxelGrid<T>::VoxelGrid( const Vec3<T>& origin, T voxelSize, unsigned int sizeX, unsigned int sizeY, unsigned int sizeZ ) {
+      reset(origin, voxelSize, sizeX, sizeY, sizeZ);
+    }
+
+    template<typename T>
+    inline VoxelGrid<T>::VoxelGrid( const Aabb<T>& bounds, T voxelSize ) {
+      const Vec3<T> extent = bounds.size() / voxelSize;
+      unsigned int size[3];
+      for( unsigned int i = 0; i < 3; ++i ) {
+        size[i] = std::max(1u, static_cast<unsigned int>(std::ceil(extent[i])));
+      }
+      reset(bounds.boundsMin, voxelSize, size[0], size[1], size[2]);
+    }
+
+    template<typename T>
+    inline void VoxelGrid<T>::reset( const Vec3<T>& origin, T voxelSize, unsigned int sizeX, unsigned int sizeY, unsigned int sizeZ ) {
+      _origin = origin;
+      _voxelSize = voxelSize;
+      _size[0] = sizeX;
+      _size[1] = sizeY;
+      _size[2] = sizeZ;
+      _wordsPerRow = (sizeX + 63) / 64;
+      _words.assign(static_cast<std::size_t>(_wordsPerRow) * sizeY * sizeZ, 0);
+    }
+
+    template<typename T>
+    inline void VoxelGrid<T>::clear() {
+      std::fill(_words.begin(), _words.end(), static_cast<std::uint64_t>(0));
+    }
+
+    template<typename T>
+    inline bool VoxelGrid<T>::get( unsigned int x, unsigned int y, unsigned int z ) const {
+      const std::size_t word = (static_cast<std::size_t>(z) * _size[1] + y) * _wordsPerRow + x / 64;
+      return ((_words[word] >> (x % 64)) & 1) != 0;
+    }
+
+    template<typename T>
+    inline void VoxelGrid<T>::set( unsigned int x, unsigned int y, unsigned int z, bool occupied ) {
+      const std::size_t word = (static_cast<std::size_t>(z) * _size[1] + y) * _wordsPerRow + x / 64;
+      const std::uint64_t bit = static_cast<std::uint64_t>(1) << (x % 64);
+      _words[word] = occupied ? (_words[word] | bit) : (_words[word] & ~bit);
+    }
+
+    template<typename T>
+    inline std::size_t VoxelGrid<T>::count() const {
+      std::size_t result = 0;
+      for( std::size_t i = 0; i < _words.size(); ++i ) {
+        result += std::bitset<64>(_words[i]).count();
+      }
+      return result;
+    }
+
+    template<typename T>
+    inline Vec3<T> VoxelGrid<T>::voxelCenter( unsigned int x, unsigned int y, unsigned int z ) const {
+      const T half = static_cast<T>(0.5);
+      return _origin + Vec3<T>(static_cast<T>(x) + half, static_cast<T>(y) + half, static_cast<T>(z) + half) * _voxelSize;
+    }
+
+    template<typename T>
+    inline Vec3<T> VoxelGrid<T>::origin() const {
+      return _origin;
+    }
+
+    template<typename T>
+    inline T VoxelGrid<T>::voxelSize() const {
+      return _voxelSize;
+    }
+
+    template<typename T>
+    inline unsigned int VoxelGrid<T>::sizeX() const {
+      return _size[0];
+    }
+
+    template<typename T>
+    inline unsigned int VoxelGrid<T>::sizeY() const {
+      return _size[1];
+    }
+
+    template<typename T>
+    inline unsigned int VoxelGrid<T>::sizeZ() const {
+      return _size[2];
+    }
+
+    template<typename T>
+    inline unsigned int VoxelGrid<T>::wordsPerRow() const {
+      return _wordsPerRow;
+    }
+
+    template<typename T>
+    inline std::vector<std::uint64_t>& VoxelGrid<T>::words() {
+      return _words;
+    }
+
+    template<typename T>
+    inline const std::vector<std::uint64_t>& VoxelGrid<T>::words() const {
+      return _words;
+    }
+
+    namespace detail {
+      // Range of grid indices a triangle can affect, inclusive.  Empty (lo > hi on some axis) if it misses the grid.
+      struct VoxelRange {
+        int lo[3];
+        int hi[3];
+
+        inline bool empty() const {
+          return lo[0] > hi[0] || lo[1] > hi[1] || lo[2] > hi[2];
+        }
+      };
+
+      // Gathers each triangle's vertices into grid space (voxel units from the origin) and the range of cells its bounds cover.
+      // With centers set, the range is instead of the cells whose centers lie within the bounds.
+      template<typename T>
+      inline void voxelTriangles( StridedSpan<const Vec3<T> > positions, const std::vector<unsigned int>& indices, const VoxelGrid<T>& grid, bool centers, std::vector<Vec3<T> >* outVertices, std::vector<VoxelRange>* outRanges ) {
+        const std::size_t triCount = indices.size() / 3;
+        outVertices->resize(triCount * 3);
+        outRanges->resize(triCount);
+        const int size[3] = { static_cast<int>(grid.sizeX()), static_cast<int>(grid.sizeY()), static_cast<int>(grid.sizeZ()) };
+        const T invVoxelSize = static_cast<T>(1) / grid.voxelSize();
+        const T offset = centers ? static_cast<T>(0.5) : static_cast<T>(0);
+        const Vec3<T> origin = grid.origin();
+
+        parallelFor(triCount, 4096, [&]( std::size_t begin, std::size_t end, unsigned int ) {
+          for( std::size_t i = begin; i < end; ++i ) {
+            Vec3<T> boundsMin(std::numeric_limits<T>::max());
+            Vec3<T> boundsMax(-std::numeric_limits<T>::max());
+            for( unsigned int v = 0; v < 3; ++v ) {
+              const Vec3<T> p = (positions[indices[i * 3 + v]] - origin) * invVoxelSize;
+              (*outVertices)[i * 3 + v] = p;
+              boundsMin = boundsMin.minimum(p);
+              boundsMax = boundsMax.maximum(p);
+            }
+            VoxelRange& range = (*outRanges)[i];
+            for( unsigned int a = 0; a < 3; ++a ) {
+              // Cell i covers [i, i+1) and has its center at i + 0.5.
+              const T lo = centers ? std::ceil(boundsMin[a] - offset) : std::floor(boundsMin[a]);
+              const T hi = std::floor(boundsMax[a] - offset);
+              range.lo[a] = (lo < static_cast<T>(0)) ? 0 : ((lo > static_cast<T>(size[a])) ? size[a] : static_cast<int>(lo));
+              range.hi[a] = (hi >= static_cast<T>(size[a])) ? size[a] - 1 : ((hi < static_cast<T>(-1)) ? -1 : static_cast<int>(hi));
+            }
+          }
+        });
+      }
+
+      // Signed area of the (y, z) projection of a, b, p.  Evaluated with the edge's endpoints in a fixed order, so
+      // a shared edge gives exactly opposite values in its two triangles and a point on it lands in exactly one.
+      template<typename T>
+      inline T voxelEdgeFunction( const Vec3<T>& a, const Vec3<T>& b, T py, T pz ) {
+        const bool swap = (b.y < a.y) || (b.y == a.y && b.z < a.z);
+        const Vec3<T>& p = swap ? b : a;
+        const Vec3<T>& q = swap ? a : b;
+        const T area = (q.y - p.y) * (pz - p.z) - (q.z - p.z) * (py - p.y);
+        return swap ? -area : area;
+      }
+
+      // Tie-break for points exactly on an edge of a counter-clockwise triangle (in y, z); antisymmetric, so one of the
+      // two triangles sharing an edge owns it.
+      template<typename T>
+      inline bool voxelEdgeOwned( const Vec3<T>& a, const Vec3<T>& b ) {
+        const T dy = b.y - a.y;
+        const T dz = b.z - a.z;
+        return (dz < static_cast<T>(0)) || (dz == static_cast<T>(0) && dy > static_cast<T>(0));
+      }
+    } /* detail */
+
+    template<typename T>
+    inline void voxelizeSurface( StridedSpan<const Vec3<T> > positions, const std::vector<unsigned int>& indices, VoxelGrid<T>* grid ) {
+      typedef Vec3Soa<T, 8> Lanes;
+      if( grid == nullptr ) {
+        return;
+      }
+      grid->clear();
+
+      std::vector<Vec3<T> > vertices;
+      std::vector<detail::VoxelRange> ranges;
+      detail::voxelTriangles(positions, indices, *grid, false, &vertices, &ranges);
+
+      // Tests are done in grid space, where every cell is a unit box.
+      const T half = static_cast<T>(0.5);
+      const Vec3<T> halfSize(half);
+      parallelFor(grid->sizeZ(), 1, [&]( std::size_t zBegin, std::size_t zEnd, unsigned int ) {
+        for( std::size_t i = 0; i < ranges.size(); ++i ) {
+          const detail::VoxelRange& range = ranges[i];
+          const int z0 = std::max(range.lo[2], static_cast<int>(zBegin));
+          const int z1 = std::min(range.hi[2], static_cast<int>(zEnd) - 1);
+          if( range.empty() || z0 > z1 ) {
+            continue;
+          }
+
+          const detail::TriangleAabbAxes<T> axes(vertices[i * 3 + 0], vertices[i * 3 + 1], vertices[i * 3 + 2], halfSize);
+          for( int z = z0; z <= z1; ++z ) {
+            for( int y = range.lo[1]; y <= range.hi[1]; ++y ) {
+              for( int x = range.lo[0]; x <= range.hi[0]; x += 8 ) {
+                Lanes centers;
+                for( unsigned int k = 0; k < 8; ++k ) {
+                  centers.x[k] = static_cast<T>(x + static_cast<int>(k)) + half;
+                  centers.y[k] = static_cast<T>(y) + half;
+                  centers.z[k] = static_cast<T>(z) + half;
+                }
+                unsigned int mask = axes.overlaps(centers);
+                // Drop lanes past the end of the range.
+                const int lanes = std::min(8, range.hi[0] - x + 1);
+                mask &= (1u << lanes) - 1;
+                for( int k = 0; k < lanes; ++k ) {
+                  if( (mask >> k) & 1 ) {
+                    grid->set(static_cast<unsigned int>(x + k), static_cast<unsigned int>(y), static_cast<unsigned int>(z), true);
+                  }
+                }
+              }
+            }
+          }
+        }
+      });
+    }
+
+    template<typename T>
+    inline void voxelizeSurface( const std::vector<Vec3<T> >& positions, const std::vector<unsigned int>& indices, VoxelGrid<T>* grid ) {
+      voxelizeSurface(StridedSpan<const Vec3<T> >(positions), indices, grid);
+    }
+
+    template<typename T>
+    inline void voxelizeSolid( StridedSpan<const Vec3<T> > positions, const std::vector<unsigned int>& indices, VoxelGrid<T>* grid ) {
+      if( grid == nullptr ) {
+        return;
+      }
+      grid->clear();
+
+      std::vector<Vec3<T> > vertices;
+      std::vector<detail::VoxelRange> ranges;
+      detail::voxelTriangles(positions, indices, *grid, true, &vertices, &ranges);
+
+      const T half = static_cast<T>(0.5);
+      const int sizeX = static_cast<int>(grid->sizeX());
+      const unsigned int sizeY = grid->sizeY();
+      const unsigned int wordsPerRow = grid->wordsPerRow();
+      std::vector<std::uint64_t>& words = grid->words();
+      parallelFor(grid->sizeZ(), 1, [&]( std::size_t zBegin, std::size_t zEnd, unsigned int ) {
+        // Flip the bit of the first voxel center past each crossing...
+        for( std::size_t i = 0; i < ranges.size(); ++i ) {
+          const detail::VoxelRange& range = ranges[i];
+          const int z0 = std::max(range.lo[2], static_cast<int>(zBegin));
+          const int z1 = std::min(range.hi[2], static_cast<int>(zEnd) - 1);
+          if( range.lo[1] > range.hi[1] || z0 > z1 ) {
+            continue;
+          }
+
+          Vec3<T> a = vertices[i * 3 + 0];
+          Vec3<T> b = vertices[i * 3 + 1];
+          Vec3<T> c = vertices[i * 3 + 2];
+          T area = detail::voxelEdgeFunction(a, b, c.y, c.z);
+          if( area == static_cast<T>(0) ) {
+            continue; // Parallel to the rays.
+          }
+          if( area < static_cast<T>(0) ) {
+            std::swap(b, c);
+            area = -area;
+          }
+          const bool ownBC = detail::voxelEdgeOwned(b, c);
+          const bool ownCA = detail::voxelEdgeOwned(c, a);
+          const bool ownAB = detail::voxelEdgeOwned(a, b);
+          const T invArea = static_cast<T>(1) / area;
+
+          for( int z = z0; z <= z1; ++z ) {
+            const T pz = static_cast<T>(z) + half;
+            for( int y = range.lo[1]; y <= range.hi[1]; ++y ) {
+              const T py = static_cast<T>(y) + half;
+              const T wa = detail::voxelEdgeFunction(b, c, py, pz);
+              const T wb = detail::voxelEdgeFunction(c, a, py, pz);
+              const T wc = detail::voxelEdgeFunction(a, b, py, pz);
+              const bool inside = (wa > static_cast<T>(0) || (wa == static_cast<T>(0) && ownBC)) &&
+                                  (wb > static_cast<T>(0) || (wb == static_cast<T>(0) && ownCA)) &&
+                                  (wc > static_cast<T>(0) || (wc == static_cast<T>(0) && ownAB));
+              if( !inside ) {
+                continue;
+              }
+              const T hitX = (wa * a.x + wb * b.x + wc * c.x) * invArea;
+              const T first = std::floor(hitX + half); // First voxel whose center lies past the crossing.
+              if( first >= static_cast<T>(sizeX) ) {
+                continue;
+              }
+              const int x = (first < static_cast<T>(0)) ? 0 : static_cast<int>(first);
+              const std::size_t word = (static_cast<std::size_t>(z) * sizeY + static_cast<unsigned int>(y)) * wordsPerRow + static_cast<unsigned int>(x) / 64;
+              words[word] ^= static_cast<std::uint64_t>(1) << (x % 64);
+            }
+          }
+        }
+
+        // ...then a prefix XOR along each row turns the flips into inside/outside parity.
+        const std::uint64_t lastMask = (sizeX % 64 == 0) ? ~static_cast<std::uint64_t>(0) : ((static_cast<std::uint64_t>(1) << (sizeX % 64)) - 1);
+        for( std::size_t row = zBegin * sizeY; row < zEnd * sizeY; ++row ) {
+          std::uint64_t carry = 0;
+          for( unsigned int w = 0; w < wordsPerRow; ++w ) {
+            std::uint64_t bits = words[row * wordsPerRow + w];
+            bits ^= bits << 1;
+            bits ^= bits << 2;
+            bits ^= bits << 4;
+            bits ^= bits << 8;
+            bits ^= bits << 16;
+            bits ^= bits << 32;
+            bits ^= static_cast<std::uint64_t>(0) - carry;
+            carry = bits >> 63;
+            words[row * wordsPerRow + w] = (w + 1 == wordsPerRow) ? (bits & lastMask) : bits;
+          }
+        }
+      });
+    }
+
+    template<typename T>
+    inline void voxelizeSolid( const std::vector<Vec3<T> >& positions, const std::vector<unsigned int>& indices, VoxelGrid<T>* grid ) {
+      voxelizeSolid(StridedSpan<const Vec3<T> >(positions), indices, grid);
+    }
+  } /* math */
+} /* cc */
@@ -0,0 +1,112 @@
+#include "CppUnitTest.h"
+#include <cc/Aabb.hpp>
+#include <cc/MatrixFunc.hpp>
+#include "Common.hpp"
+#include <cc/Random.hpp>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+TEST_CLASS(AabbTest) {
+private:
+	cc::math::Random<float, int> rnd;
+
+	cc::Vec3f randomVector( float min, float max ) {
+		return cc::Vec3f(rnd.nextReal(min, max), rnd.nextReal(min, max), rnd.nextReal(min, max));
+	}
+
+public:
+	TEST_METHOD(Empty) {
+		cc::Aabbf box;
+		Assert::IsTrue(box.isEmpty());
+		Assert::AreEqual(0.0f, box.surfaceArea(), TOLERANCE);
+		Assert::AreEqual(0.0f, box.volume(), TOLERANCE);
+
+		box.expand(cc::Vec3f(1.0f, 2.0f, 3.0f));
+		Assert::IsFalse(box.isEmpty());
+		Assert::IsTrue(box.contains(cc::Vec3f(1.0f, 2.0f, 3.0f)));
+
+		box.reset();
+		Assert::IsTrue(box.isEmpty());
+	}
+
+	TEST_METHOD(Operations) {
+		const cc::Aabbf a(cc::Vec3f(0.0f), cc::Vec3f(2.0f));
+		const cc::Aabbf b(cc::Vec3f(1.0f), cc::Vec3f(3.0f, 4.0f, 5.0f));
+		const cc::Aabbf c(cc::Vec3f(10.0f), cc::Vec3f(11.0f));
+
+		Assert::IsTrue(a.overlaps(b));
+		Assert::IsTrue(b.overlaps(a));
+		Assert::IsFalse(a.overlaps(c));
+
+		const cc::Aabbf u = a.merged(b);
+		Assert::IsTrue(u.contains(a));
+		Assert::IsTrue(u.contains(b));
+		Assert::IsFalse(a.contains(b));
+		Assert::IsTrue(u == cc::Aabbf(cc::Vec3f(0.0f), cc::Vec3f(3.0f, 4.0f, 5.0f)));
+
+		const cc::Aabbf i = a.clipped(b);
+		Assert::IsTrue(i == cc::Aabbf(cc::Vec3f(1.0f), cc::Vec3f(2.0f)));
+		Assert::IsTrue(a.clipped(c).isEmpty());
+
+		Assert::AreEqual(24.0f, a.surfaceArea(), TOLERANCE);
+		Assert::AreEqual(8.0f, a.volume(), TOLERANCE);
+		Assert::IsTrue(a.center().equalTo(cc::Vec3f(1.0f)));
+		Assert::IsTrue(b.size().equalTo(cc::Vec3f(2.0f, 3.0f, 4.0f)));
+		Assert::AreEqual(2, b.longestAxis());
+	}
+
+	TEST_METHOD(Transform) {
+		const cc::Aabbf box(cc::Vec3f(-1.0f, -2.0f, -3.0f), cc::Vec3f(4.0f, 5.0f, 6.0f));
+		const cc::Mat4f mat = cc::math::translate(cc::Vec3f(1.0f, 2.0f, 3.0f)) * cc::math::rotate(0.7f, cc::Vec3f(0.3f, 1.0f, 0.2f).normalized()) * cc::math::scale(cc::Vec3f(2.0f, 1.0f, 0.5f));
+
+		// Reference: transform all eight corners.
+		cc::Aabbf expected;
+		for( int i = 0; i < 8; ++i ) {
+			const cc::Vec3f corner((i & 1) ? box.boundsMax.x : box.boundsMin.x, (i & 2) ? box.boundsMax.y : box.boundsMin.y, (i & 4) ? box.boundsMax.z : box.boundsMin.z);
+			const cc::math::Vec4<float> p = mat * cc::math::Vec4<float>(corner);
+			expected.expand(cc::Vec3f(p.x, p.y, p.z));
+		}
+
+		const cc::Aabbf result = box.transformed(mat);
+		Assert::AreEqual(expected.boundsMin.x, result.boundsMin.x, TOLERANCE);
+		Assert::AreEqual(expected.boundsMin.y, result.boundsMin.y, TOLERANCE);
+		Assert::AreEqual(expected.boundsMin.z, result.boundsMin.z, TOLERANCE);
+		Assert::AreEqual(expected.boundsMax.x, result.boundsMax.x, TOLERANCE);
+		Assert::AreEqual(expected.boundsMax.y, result.boundsMax.y, TOLERANCE);
+		Assert::AreEqual(expected.boundsMax.z, result.boundsMax.z, TOLERANCE);
+	}
+
+	TEST_METHOD(FromPoints) {
+		Assert::IsTrue(cc::math::computeAabb(std::vector<cc::Vec3f>()).isEmpty());
+
+		// Odd count so the tail after the four-wide blocks is exercised.
+		std::vector<cc::Vec3f> points;
+		cc::Aabbf expected;
+		for( int i = 0; i < 100003; ++i ) {
+			points.push_back(randomVector(-50.0f, 50.0f));
+			expected.expand(points.back());
+		}
+		const cc::Aabbf box = cc::math::computeAabb(points);
+		Assert::IsTrue(box == expected);
+	}
+
+	TEST_METHOD(FromInterleavedPoints) {
+		struct Vertex {
+			cc::Vec3f position;
+			cc::Vec3f normal;
+			float u, v;
+		};
+		std::vector<Vertex> vertices(50001);
+		cc::Aabbf expected;
+		for( unsigned int i = 0; i < vertices.size(); ++i ) {
+			vertices[i].position = randomVector(-50.0f, 50.0f);
+			vertices[i].normal = randomVector(-100.0f, 100.0f); // Outside the positions; must be skipped.
+			expected.expand(vertices[i].position);
+		}
+		const cc::math::StridedSpan<const cc::Vec3f> positions(&vertices[0].position, vertices.size(), sizeof(Vertex));
+		Assert::IsFalse(positions.isContiguous());
+		Assert::IsTrue(cc::math::computeAabb(positions) == expected);
+		Assert::IsTrue(cc::math::computeAabb(positions.subspan(0, 0)).isEmpty());
+	}
+};
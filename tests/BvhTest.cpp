@@ -0,0 +1,177 @@
+#include "CppUnitTest.h"
+#include <cc/Bvh.hpp>
+#include <cc/ClosestPoint.hpp>
+#include <cc/Intersection.hpp>
+#include "Common.hpp"
+#include <cc/Random.hpp>
+#include <cc/Vec4.hpp>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+TEST_CLASS(BvhTest) {
+private:
+	cc::math::Random<float, int> rnd;
+	std::vector<cc::Vec3f> positions;
+	std::vector<unsigned int> indices;
+
+	cc::Vec3f randomVector( float min, float max ) {
+		return cc::Vec3f(rnd.nextReal(min, max), rnd.nextReal(min, max), rnd.nextReal(min, max));
+	}
+
+	// Random soup of small triangles inside a 20 unit cube.
+	void buildSoup( unsigned int triangles ) {
+		positions.clear();
+		indices.clear();
+		for( unsigned int i = 0; i < triangles; ++i ) {
+			const cc::Vec3f center = randomVector(-10.0f, 10.0f);
+			for( unsigned int j = 0; j < 3; ++j ) {
+				indices.push_back(static_cast<unsigned int>(positions.size()));
+				positions.push_back(center + randomVector(-0.5f, 0.5f));
+			}
+		}
+	}
+
+public:
+	BvhTest()
+		: rnd(1234) {
+	}
+
+	TEST_METHOD(Build) {
+		cc::Bvhf bvh;
+		Assert::IsTrue(bvh.empty());
+
+		buildSoup(5000);
+		bvh.build(positions, indices);
+		Assert::IsFalse(bvh.empty());
+		Assert::AreEqual(5000u, bvh.triangleCount());
+		Assert::IsTrue(bvh.nodeCount() < 2 * 5000u);
+
+		// Every triangle must be referenced by exactly one leaf and every node must enclose its children.
+		unsigned int leafTriangles = 0;
+		const std::vector<cc::math::BvhNode<float> >& nodes = bvh.nodes();
+		for( unsigned int i = 0; i < nodes.size(); ++i ) {
+			if( nodes[i].isLeaf() ) {
+				leafTriangles += nodes[i].triCount;
+				continue;
+			}
+			for( unsigned int c = nodes[i].leftFirst; c < nodes[i].leftFirst + 2; ++c ) {
+				Assert::IsTrue(nodes[c].boundsMin.x >= nodes[i].boundsMin.x && nodes[c].boundsMax.x <= nodes[i].boundsMax.x);
+				Assert::IsTrue(nodes[c].boundsMin.y >= nodes[i].boundsMin.y && nodes[c].boundsMax.y <= nodes[i].boundsMax.y);
+				Assert::IsTrue(nodes[c].boundsMin.z >= nodes[i].boundsMin.z && nodes[c].boundsMax.z <= nodes[i].boundsMax.z);
+			}
+		}
+		Assert::AreEqual(5000u, leafTriangles);
+
+		bvh.clear();
+		Assert::IsTrue(bvh.empty());
+	}
+
+	TEST_METHOD(Ray) {
+		buildSoup(5000);
+		cc::Bvhf bvh;
+		bvh.build(positions, indices);
+
+		for( int i = 0; i < 200; ++i ) {
+			const cc::Vec3f origin = randomVector(-12.0f, 12.0f);
+			const cc::Vec3f direction = randomVector(-1.0f, 1.0f);
+
+			// Brute force reference.
+			bool expectHit = false;
+			float expectT = 1000.0f;
+			for( unsigned int t = 0; t < indices.size() / 3; ++t ) {
+				float hitT;
+				if( cc::math::rayIntersectsTriangle(origin, direction, positions[indices[t*3]], positions[indices[t*3+1]], positions[indices[t*3+2]], &hitT, (float*)nullptr, (float*)nullptr) && hitT < expectT ) {
+					expectHit = true;
+					expectT = hitT;
+				}
+			}
+
+			cc::math::BvhRayHit<float> hit;
+			Assert::AreEqual(expectHit, bvh.intersectRay(origin, direction, 1000.0f, &hit));
+			Assert::AreEqual(expectHit, bvh.occluded(origin, direction, 1000.0f));
+			if( expectHit ) {
+				Assert::AreEqual(expectT, hit.t, TOLERANCE);
+				Assert::IsTrue(hit.triangle < indices.size() / 3);
+			}
+		}
+	}
+
+	TEST_METHOD(ClosestPoint) {
+		buildSoup(5000);
+		cc::Bvhf bvh;
+		bvh.build(positions, indices);
+
+		for( int i = 0; i < 200; ++i ) {
+			const cc::Vec3f point = randomVector(-15.0f, 15.0f);
+
+			float expectDist2 = 1e30f;
+			for( unsigned int t = 0; t < indices.size() / 3; ++t ) {
+				const cc::Vec3f q = cc::math::closestPointOnTriangle(point, positions[indices[t*3]], positions[indices[t*3+1]], positions[indices[t*3+2]]);
+				expectDist2 = cc::math::minimum(expectDist2, q.sqrDistance(point));
+			}
+
+			cc::Vec3f pos;
+			unsigned int tri = 0;
+			Assert::IsTrue(bvh.closestPoint(point, 1000.0f, &pos, &tri));
+			Assert::AreEqual(expectDist2, pos.sqrDistance(point), TOLERANCE);
+			const cc::Vec3f onTri = cc::math::closestPointOnTriangle(point, positions[indices[tri*3]], positions[indices[tri*3+1]], positions[indices[tri*3+2]]);
+			Assert::IsTrue(onTri.equalTo(pos));
+		}
+
+		// Nothing lies within a tiny radius of a far away point.
+		Assert::IsFalse(bvh.closestPoint(cc::Vec3f(100.0f), 1.0f, nullptr, nullptr));
+	}
+
+	TEST_METHOD(ClosestPointBatch) {
+		buildSoup(5000);
+		cc::Bvhf bvh;
+		bvh.build(positions, indices);
+
+		std::vector<cc::Vec3f> points;
+		for( int i = 0; i < 2000; ++i ) {
+			points.push_back(randomVector(-15.0f, 15.0f));
+		}
+		points.push_back(cc::Vec3f(100.0f));
+
+		std::vector<cc::math::BvhClosestPoint<float> > results;
+		Assert::AreEqual(2000u, bvh.closestPoints(points, 10.0f, &results));
+		Assert::AreEqual(points.size(), results.size());
+		Assert::IsFalse(results.back().found);
+
+		for( unsigned int i = 0; i < 2000; ++i ) {
+			cc::math::BvhClosestPoint<float> single;
+			Assert::IsTrue(bvh.closestPoint(points[i], 10.0f, &single));
+			Assert::IsTrue(results[i].found);
+			Assert::AreEqual(single.sqrDistance, results[i].sqrDistance, TOLERANCE);
+			Assert::AreEqual(single.sqrDistance, results[i].position.sqrDistance(points[i]), TOLERANCE);
+
+			// Barycentrics refer to the source triangle's vertices and reproduce the position.
+			const cc::math::BvhClosestPoint<float>& r = results[i];
+			const cc::Vec3f fromBary = positions[indices[r.triangle*3]] * r.barycentric.x + positions[indices[r.triangle*3+1]] * r.barycentric.y + positions[indices[r.triangle*3+2]] * r.barycentric.z;
+			Assert::IsTrue(fromBary.equalTo(r.position));
+			Assert::AreEqual(1.0f, r.barycentric.x + r.barycentric.y + r.barycentric.z, TOLERANCE);
+		}
+	}
+
+	TEST_METHOD(StridedPositions) {
+		buildSoup(2000);
+		std::vector<cc::Vec4f> interleaved;
+		for( unsigned int i = 0; i < positions.size(); ++i ) {
+			interleaved.push_back(cc::Vec4f(positions[i].x, positions[i].y, positions[i].z, 1.0f));
+		}
+		const cc::math::StridedSpan<const cc::Vec3f> strided(reinterpret_cast<const cc::Vec3f*>(&interleaved[0]), interleaved.size(), sizeof(cc::Vec4f));
+
+		cc::Bvhf packedBvh, stridedBvh;
+		packedBvh.build(positions, indices);
+		stridedBvh.build(strided, indices);
+		Assert::AreEqual(packedBvh.nodeCount(), stridedBvh.nodeCount());
+
+		for( int i = 0; i < 100; ++i ) {
+			const cc::Vec3f point = randomVector(-15.0f, 15.0f);
+			cc::math::BvhClosestPoint<float> a, b;
+			Assert::AreEqual(packedBvh.closestPoint(point, 100.0f, &a), stridedBvh.closestPoint(point, 100.0f, &b));
+			Assert::AreEqual(a.sqrDistance, b.sqrDistance, TOLERANCE);
+		}
+	}
+};
@@ -0,0 +1,99 @@
+#include "CppUnitTest.h"
+#include <cc/ClosestPoint.hpp>
+#include "Common.hpp"
+#include <cc/Random.hpp>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+TEST_CLASS(ClosestPointTest) {
+private:
+	cc::math::Random<float, int> rnd;
+
+	cc::Vec3f randomVector( float min, float max ) {
+		return cc::Vec3f(rnd.nextReal(min, max), rnd.nextReal(min, max), rnd.nextReal(min, max));
+	}
+
+public:
+	ClosestPointTest()
+		: rnd(4321) {
+	}
+
+	TEST_METHOD(Segment) {
+		const cc::Vec3f a(0.0f, 0.0f, 0.0f);
+		const cc::Vec3f b(2.0f, 0.0f, 0.0f);
+		float t = -1.0f;
+		Assert::IsTrue(cc::math::closestPointOnSegment(cc::Vec3f(1.0f, 3.0f, 0.0f), a, b, &t).equalTo(cc::Vec3f(1.0f, 0.0f, 0.0f)));
+		Assert::AreEqual(0.5f, t, TOLERANCE);
+		Assert::IsTrue(cc::math::closestPointOnSegment(cc::Vec3f(-4.0f, 1.0f, 0.0f), a, b, &t).equalTo(a));
+		Assert::AreEqual(0.0f, t, TOLERANCE);
+		Assert::IsTrue(cc::math::closestPointOnSegment(cc::Vec3f(5.0f, 0.0f, 1.0f), a, b, &t).equalTo(b));
+		Assert::AreEqual(1.0f, t, TOLERANCE);
+	}
+
+	TEST_METHOD(SegmentSegment) {
+		// Crossing segments a unit apart.
+		cc::Vec3f c1, c2;
+		float s = -1.0f, t = -1.0f;
+		float dist2 = cc::math::closestPointsBetweenSegments(cc::Vec3f(-1.0f, 0.0f, 0.0f), cc::Vec3f(1.0f, 0.0f, 0.0f), cc::Vec3f(0.0f, -1.0f, 1.0f), cc::Vec3f(0.0f, 1.0f, 1.0f), &s, &t, &c1, &c2);
+		Assert::AreEqual(1.0f, dist2, TOLERANCE);
+		Assert::AreEqual(0.5f, s, TOLERANCE);
+		Assert::AreEqual(0.5f, t, TOLERANCE);
+		Assert::IsTrue(c1.equalTo(cc::Vec3f(0.0f, 0.0f, 0.0f)));
+		Assert::IsTrue(c2.equalTo(cc::Vec3f(0.0f, 0.0f, 1.0f)));
+
+		// Parallel and degenerate segments.
+		dist2 = cc::math::closestPointsBetweenSegments(cc::Vec3f(0.0f), cc::Vec3f(1.0f, 0.0f, 0.0f), cc::Vec3f(0.5f, 2.0f, 0.0f), cc::Vec3f(3.0f, 2.0f, 0.0f), &s, &t, &c1, &c2);
+		Assert::AreEqual(4.0f, dist2, TOLERANCE);
+		dist2 = cc::math::closestPointsBetweenSegments(cc::Vec3f(1.0f), cc::Vec3f(1.0f), cc::Vec3f(3.0f), cc::Vec3f(3.0f), &s, &t, &c1, &c2);
+		Assert::AreEqual(12.0f, dist2, TOLERANCE);
+
+		// Against dense sampling of both segments.
+		for( int i = 0; i < 100; ++i ) {
+			const cc::Vec3f p1 = randomVector(-5.0f, 5.0f), q1 = randomVector(-5.0f, 5.0f);
+			const cc::Vec3f p2 = randomVector(-5.0f, 5.0f), q2 = randomVector(-5.0f, 5.0f);
+			float expected = 1e30f;
+			for( int si = 0; si <= 200; ++si ) {
+				for( int ti = 0; ti <= 200; ++ti ) {
+					const cc::Vec3f x = p1 + (q1 - p1) * (si / 200.0f);
+					const cc::Vec3f y = p2 + (q2 - p2) * (ti / 200.0f);
+					expected = cc::math::minimum(expected, x.sqrDistance(y));
+				}
+			}
+			dist2 = cc::math::closestPointsBetweenSegments(p1, q1, p2, q2, &s, &t, &c1, &c2);
+			Assert::IsTrue(dist2 <= expected + 1e-4f);
+			Assert::IsTrue(dist2 >= expected - 0.1f);
+			Assert::AreEqual(dist2, c1.sqrDistance(c2), TOLERANCE);
+		}
+	}
+
+	TEST_METHOD(SegmentSegmentBatch) {
+		for( int batch = 0; batch < 50; ++batch ) {
+			cc::Vec3Soa8f p1, q1, p2, q2;
+			for( unsigned int k = 0; k < 8; ++k ) {
+				p1.set(k, randomVector(-5.0f, 5.0f));
+				q1.set(k, randomVector(-5.0f, 5.0f));
+				p2.set(k, randomVector(-5.0f, 5.0f));
+				// Mix in degenerate and parallel lanes.
+				q2.set(k, (k == 3) ? p2.get(k) : ((k == 5) ? p2.get(k) + (q1.get(k) - p1.get(k)) : randomVector(-5.0f, 5.0f)));
+			}
+			if( batch % 2 ) {
+				q1.set(6, p1.get(6));
+			}
+
+			float s[8], t[8], dist2[8];
+			cc::math::closestPointsBetweenSegments(p1, q1, p2, q2, s, t, dist2);
+			for( unsigned int k = 0; k < 8; ++k ) {
+				float expectS, expectT;
+				const float expected = cc::math::closestPointsBetweenSegments(p1.get(k), q1.get(k), p2.get(k), q2.get(k), &expectS, &expectT, (cc::Vec3f*)nullptr, (cc::Vec3f*)nullptr);
+				Assert::AreEqual(expected, dist2[k], TOLERANCE);
+			}
+
+			float pointDist2[8];
+			cc::math::sqrDistanceToSegment(p2, p1, q1, pointDist2);
+			for( unsigned int k = 0; k < 8; ++k ) {
+				const cc::Vec3f closest = cc::math::closestPointOnSegment(p2.get(k), p1.get(k), q1.get(k), (float*)nullptr);
+				Assert::AreEqual(closest.sqrDistance(p2.get(k)), pointDist2[k], TOLERANCE);
+			}
+		}
+	}
+};
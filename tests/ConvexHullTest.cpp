@@ -0,0 +1,208 @@
+#include "CppUnitTest.h"
+#include <cc/ConvexHull.hpp>
+#include <cc/Random.hpp>
+#include "Common.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+TEST_CLASS(ConvexHullTest) {
+private:
+	cc::math::Random<float, int> rnd;
+
+	cc::Vec3f randomVector( float min, float max ) {
+		return cc::Vec3f(rnd.nextReal(min, max), rnd.nextReal(min, max), rnd.nextReal(min, max));
+	}
+
+	// Every point must be on or behind every face, every face must be used by the vertices it indexes, and every
+	// directed edge must have exactly one twin.
+	void checkHull( const std::vector<cc::Vec3f>& points, const cc::ConvexHullf& hull ) {
+		Assert::AreEqual(hull.indices.size(), hull.planes.size() * 3);
+		// Closed triangulated surface: F = 2V - 4.
+		Assert::AreEqual(hull.vertices.size() * 2 - 4, hull.planes.size());
+		std::map<std::pair<unsigned int, unsigned int>, unsigned int> edges;
+		for( size_t i = 0; i < hull.indices.size(); ++i ) {
+			const size_t next = (i % 3 == 2) ? i - 2 : i + 1;
+			++edges[std::make_pair(hull.indices[i], hull.indices[next])];
+		}
+		for( std::map<std::pair<unsigned int, unsigned int>, unsigned int>::const_iterator it = edges.begin(); it != edges.end(); ++it ) {
+			Assert::AreEqual(1u, it->second);
+			Assert::IsTrue(edges.count(std::make_pair(it->first.second, it->first.first)) == 1);
+		}
+
+		// Rounding in the planes grows with the coordinates.
+		float extent = 0.0f;
+		for( size_t i = 0; i < points.size(); ++i ) {
+			extent = std::max(extent, std::max(std::abs(points[i].x), std::max(std::abs(points[i].y), std::abs(points[i].z))));
+		}
+		const float tolerance = std::max(1e-4f, 16.0f * std::numeric_limits<float>::epsilon() * extent);
+		for( size_t f = 0; f < hull.planes.size(); ++f ) {
+			const cc::Planef& plane = hull.planes[f];
+			Assert::AreEqual(1.0f, plane.normal.magnitude(), TOLERANCE);
+			for( unsigned int k = 0; k < 3; ++k ) {
+				Assert::AreEqual(0.0f, plane.distance(hull.vertices[hull.indices[f * 3 + k]]), tolerance);
+			}
+			for( size_t i = 0; i < points.size(); ++i ) {
+				Assert::IsTrue(plane.distance(points[i]) < tolerance);
+			}
+		}
+	}
+
+public:
+	ConvexHullTest()
+		: rnd(4321) {
+	}
+
+	TEST_METHOD(Box) {
+		std::vector<cc::Vec3f> points;
+		for( unsigned int i = 0; i < 200; ++i ) {
+			points.push_back(randomVector(-0.9f, 0.9f));
+		}
+		for( unsigned int i = 0; i < 8; ++i ) {
+			points.push_back(cc::Vec3f((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : -1.0f));
+		}
+		// Duplicates and points on the faces add nothing.
+		points.push_back(cc::Vec3f(1.0f, 1.0f, 1.0f));
+		points.push_back(cc::Vec3f(1.0f, 0.2f, -0.3f));
+
+		cc::ConvexHullf hull;
+		Assert::IsTrue(cc::math::computeConvexHull(points, &hull));
+		Assert::AreEqual(static_cast<size_t>(8), hull.vertices.size());
+		Assert::AreEqual(static_cast<size_t>(12), hull.planes.size());
+		checkHull(points, hull);
+		for( size_t i = 0; i < hull.vertices.size(); ++i ) {
+			Assert::AreEqual(1.0f, std::abs(hull.vertices[i].x), TOLERANCE);
+			Assert::AreEqual(1.0f, std::abs(hull.vertices[i].y), TOLERANCE);
+			Assert::AreEqual(1.0f, std::abs(hull.vertices[i].z), TOLERANCE);
+		}
+	}
+
+	TEST_METHOD(Sphere) {
+		// Every point on a sphere is on its hull.
+		std::vector<cc::Vec3f> points;
+		while( points.size() < 500 ) {
+			const cc::Vec3f p = randomVector(-1.0f, 1.0f);
+			const float length = p.magnitude();
+			if( length > 0.1f && length <= 1.0f ) {
+				points.push_back(p * (5.0f / length) + cc::Vec3f(10.0f, -3.0f, 2.0f));
+			}
+		}
+		cc::QuickHullf quickHull;
+		cc::ConvexHullf hull;
+		Assert::IsTrue(quickHull.build(points, &hull));
+		Assert::AreEqual(points.size(), hull.vertices.size());
+		checkHull(points, hull);
+
+		// The same QuickHull, reused on a smaller input.
+		points.resize(50);
+		Assert::IsTrue(quickHull.build(points, &hull));
+		Assert::AreEqual(points.size(), hull.vertices.size());
+		checkHull(points, hull);
+	}
+
+	TEST_METHOD(BoxSurface) {
+		// Points on the faces of a box, off their planes by less than the roundoff of a float hull.
+		std::vector<cc::Vec3f> points;
+		for( unsigned int i = 0; i < 5000; ++i ) {
+			cc::Vec3f p = randomVector(-1.0f, 1.0f);
+			const float side = ((i / 3) & 1) ? 1.0f : -1.0f;
+			if( i % 3 == 0 ) {
+				p.x = side;
+			} else if( i % 3 == 1 ) {
+				p.y = side;
+			} else {
+				p.z = side;
+			}
+			points.push_back(p + randomVector(-1e-6f, 1e-6f));
+		}
+		cc::ConvexHullf hull;
+		Assert::IsTrue(cc::math::computeConvexHull(points, &hull));
+		checkHull(points, hull);
+	}
+
+	TEST_METHOD(Cylinder) {
+		// Every point is on one of two circles, so the sides are long slivers and the caps are flat.
+		std::vector<cc::Vec3f> points;
+		for( unsigned int i = 0; i < 3000; ++i ) {
+			const float angle = rnd.nextReal(0.0f, 6.2831853f);
+			points.push_back(cc::Vec3f(std::cos(angle), std::sin(angle), (i & 1) ? 1.0f : -1.0f));
+		}
+		cc::ConvexHullf hull;
+		Assert::IsTrue(cc::math::computeConvexHull(points, &hull));
+		checkHull(points, hull);
+	}
+
+	TEST_METHOD(OffsetSphere) {
+		// A small sphere far from the origin, where the float coordinates are coarse compared to the spacing of the points.
+		std::vector<cc::Vec3f> points;
+		while( points.size() < 20000 ) {
+			const cc::Vec3f p = randomVector(-1.0f, 1.0f);
+			const float length = p.magnitude();
+			if( length > 0.1f && length <= 1.0f ) {
+				points.push_back(p / length + cc::Vec3f(1000.0f, 1000.0f, 1000.0f));
+			}
+		}
+		cc::ConvexHullf hull;
+		Assert::IsTrue(cc::math::computeConvexHull(points, &hull));
+		checkHull(points, hull);
+	}
+
+	TEST_METHOD(Pool) {
+		// Points inside a cube replace many faces on the way to a small hull; recycled faces keep the pool near its size.
+		std::vector<cc::Vec3f> points;
+		for( unsigned int i = 0; i < 20000; ++i ) {
+			points.push_back(randomVector(-1.0f, 1.0f));
+		}
+		cc::QuickHullf quickHull;
+		cc::ConvexHullf hull;
+		Assert::IsTrue(quickHull.build(points, &hull));
+		const unsigned int poolSize = quickHull.poolSize();
+		Assert::IsTrue(poolSize < hull.planes.size() * 2);
+
+		// Rebuilding reuses the pool without growing it.
+		for( int i = 0; i < 3; ++i ) {
+			Assert::IsTrue(quickHull.build(points, &hull));
+			Assert::AreEqual(poolSize, quickHull.poolSize());
+			checkHull(points, hull);
+		}
+	}
+
+	TEST_METHOD(Degenerate) {
+		cc::ConvexHullf hull;
+		std::vector<cc::Vec3f> points;
+		Assert::IsFalse(cc::math::computeConvexHull(points, &hull));
+		for( unsigned int i = 0; i < 20; ++i ) {
+			points.push_back(cc::Vec3f(rnd.nextReal(-1.0f, 1.0f), rnd.nextReal(-1.0f, 1.0f), 3.0f));
+		}
+		Assert::IsFalse(cc::math::computeConvexHull(points, &hull));
+		Assert::IsTrue(hull.vertices.empty());
+	}
+
+	TEST_METHOD(Batch) {
+		std::vector<std::vector<cc::Vec3f> > inputs(16);
+		for( size_t i = 0; i < inputs.size(); ++i ) {
+			for( unsigned int p = 0; p < 100 + i * 10; ++p ) {
+				inputs[i].push_back(randomVector(-1.0f, 1.0f) * static_cast<float>(i + 1));
+			}
+		}
+		inputs[3].resize(3);
+
+		std::vector<cc::ConvexHullf> hulls;
+		Assert::AreEqual(15u, cc::math::computeConvexHulls(inputs, &hulls));
+		Assert::AreEqual(inputs.size(), hulls.size());
+		Assert::IsTrue(hulls[3].vertices.empty());
+		for( size_t i = 0; i < inputs.size(); ++i ) {
+			if( i == 3 ) {
+				continue;
+			}
+			cc::ConvexHullf single;
+			Assert::IsTrue(cc::math::computeConvexHull(inputs[i], &single));
+			Assert::AreEqual(single.vertices.size(), hulls[i].vertices.size());
+			checkHull(inputs[i], hulls[i]);
+		}
+	}
+};
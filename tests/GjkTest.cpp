@@ -0,0 +1,116 @@
+#include "CppUnitTest.h"
+#include <cc/Gjk.hpp>
+#include <cc/ClosestPoint.hpp>
+#include "Common.hpp"
+#include <cc/Random.hpp>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+TEST_CLASS(GjkTest) {
+private:
+	cc::math::Random<float, int> rnd;
+
+	cc::Vec3f randomVector( float min, float max ) {
+		return cc::Vec3f(rnd.nextReal(min, max), rnd.nextReal(min, max), rnd.nextReal(min, max));
+	}
+
+public:
+	GjkTest()
+		: rnd(2468) {
+	}
+
+	TEST_METHOD(SphereDistance) {
+		for( int i = 0; i < 100; ++i ) {
+			const cc::math::SphereSupport<float> a(randomVector(-5.0f, 5.0f), rnd.nextReal(0.1f, 2.0f));
+			const cc::math::SphereSupport<float> b(randomVector(-5.0f, 5.0f), rnd.nextReal(0.1f, 2.0f));
+			const float expected = a.center.distance(b.center) - a.radius - b.radius;
+
+			cc::math::GjkResult<float> result;
+			const float distance = cc::math::gjkDistance(a, b, (cc::math::GjkSimplex<float>*)nullptr, &result);
+			Assert::AreEqual(expected > 0.0f, !result.intersecting);
+			Assert::AreEqual(expected > 0.0f, !cc::math::gjkIntersects(a, b, (cc::math::GjkSimplex<float>*)nullptr));
+			if( expected > 0.01f ) {
+				Assert::AreEqual(expected, distance, TOLERANCE);
+				Assert::AreEqual(expected, result.pointA.distance(result.pointB), TOLERANCE);
+				Assert::AreEqual(a.radius, result.pointA.distance(a.center), TOLERANCE);
+			}
+		}
+	}
+
+	TEST_METHOD(BoxAndCapsuleDistance) {
+		const cc::math::AabbSupport<float> box(cc::Aabbf(cc::Vec3f(-1.0f), cc::Vec3f(1.0f)));
+		const cc::math::PointSupport<float> point(cc::Vec3f(3.0f, 3.0f, 0.5f));
+		Assert::AreEqual(sqrtf(8.0f), cc::math::gjkDistance(box, point, (cc::math::GjkSimplex<float>*)nullptr, (cc::math::GjkResult<float>*)nullptr), TOLERANCE);
+
+		// Hull of the box's corners behaves like the box.
+		std::vector<cc::Vec3f> corners;
+		for( int c = 0; c < 8; ++c ) {
+			corners.push_back(cc::Vec3f((c & 1) ? 1.0f : -1.0f, (c & 2) ? 1.0f : -1.0f, (c & 4) ? 1.0f : -1.0f));
+		}
+		const cc::math::PointsSupport<float> hull(corners);
+		Assert::AreEqual(sqrtf(8.0f), cc::math::gjkDistance(hull, point, (cc::math::GjkSimplex<float>*)nullptr, (cc::math::GjkResult<float>*)nullptr), TOLERANCE);
+
+		for( int i = 0; i < 100; ++i ) {
+			const cc::math::CapsuleSupport<float> a(randomVector(-5.0f, 5.0f), randomVector(-5.0f, 5.0f), 0.25f);
+			const cc::math::CapsuleSupport<float> b(randomVector(-5.0f, 5.0f), randomVector(-5.0f, 5.0f), 0.25f);
+			const float segDist = sqrtf(cc::math::closestPointsBetweenSegments(a.a, a.b, b.a, b.b, (float*)nullptr, (float*)nullptr, (cc::Vec3f*)nullptr, (cc::Vec3f*)nullptr));
+			const float distance = cc::math::gjkDistance(a, b, (cc::math::GjkSimplex<float>*)nullptr, (cc::math::GjkResult<float>*)nullptr);
+			if( segDist > 0.51f ) {
+				Assert::AreEqual(segDist - 0.5f, distance, TOLERANCE);
+			} else if( segDist < 0.49f ) {
+				Assert::AreEqual(0.0f, distance);
+			}
+		}
+	}
+
+	TEST_METHOD(WarmStart) {
+		const cc::math::AabbSupport<float> box(cc::Aabbf(cc::Vec3f(-1.0f), cc::Vec3f(1.0f)));
+		cc::math::GjkSimplex<float> simplex;
+		cc::math::GjkResult<float> result;
+		unsigned int coldIterations = 0;
+		unsigned int warmIterations = 0;
+		for( int frame = 0; frame < 100; ++frame ) {
+			// A sphere orbiting the box slowly.
+			const float angle = frame * 0.01f;
+			const cc::math::SphereSupport<float> sphere(cc::Vec3f(4.0f * cosf(angle), 2.0f, 4.0f * sinf(angle)), 0.5f);
+			cc::math::gjkDistance(box, sphere, (cc::math::GjkSimplex<float>*)nullptr, &result);
+			coldIterations += result.iterations;
+			const float cold = result.distance;
+			cc::math::gjkDistance(box, sphere, &simplex, &result);
+			warmIterations += result.iterations;
+			Assert::AreEqual(cold, result.distance, TOLERANCE);
+		}
+		Assert::IsTrue(warmIterations < coldIterations);
+		Assert::IsTrue(warmIterations <= 2 * 100);
+	}
+
+	TEST_METHOD(Penetration) {
+		// Overlapping spheres separate along the line between their centers.
+		const cc::math::SphereSupport<float> a(cc::Vec3f(0.0f), 1.0f);
+		const cc::math::SphereSupport<float> b(cc::Vec3f(1.5f, 0.0f, 0.0f), 1.0f);
+		cc::math::GjkSimplex<float> simplex;
+		cc::math::EpaResult<float> result;
+		Assert::IsTrue(cc::math::epaPenetration(a, b, &simplex, &result));
+		Assert::AreEqual(0.5f, result.depth, TOLERANCE);
+		Assert::IsTrue(result.normal.equalTo(cc::Vec3f(1.0f, 0.0f, 0.0f)) || result.normal.distance(cc::Vec3f(1.0f, 0.0f, 0.0f)) < 0.05f);
+		Assert::AreEqual(1.0f, result.pointA.x, 0.05f);
+		Assert::AreEqual(0.5f, result.pointB.x, 0.05f);
+
+		// Overlapping boxes separate along the axis of least overlap.
+		for( int i = 0; i < 50; ++i ) {
+			const cc::Vec3f offset = randomVector(-1.8f, 1.8f);
+			const cc::math::AabbSupport<float> boxA(cc::Aabbf(cc::Vec3f(-1.0f), cc::Vec3f(1.0f)));
+			const cc::math::AabbSupport<float> boxB(cc::Aabbf(cc::Vec3f(-1.0f) + offset, cc::Vec3f(1.0f) + offset));
+			const float expected = cc::math::minimum(2.0f - fabsf(offset.x), cc::math::minimum(2.0f - fabsf(offset.y), 2.0f - fabsf(offset.z)));
+			Assert::IsTrue(cc::math::epaPenetration(boxA, boxB, (cc::math::GjkSimplex<float>*)nullptr, &result));
+			Assert::AreEqual(expected, result.depth, TOLERANCE);
+			Assert::AreEqual(1.0f, result.normal.magnitude(), TOLERANCE);
+			Assert::IsTrue(result.normal.dot(offset) >= 0.0f);
+		}
+
+		// Separated shapes report no penetration.
+		const cc::math::SphereSupport<float> far(cc::Vec3f(5.0f, 0.0f, 0.0f), 1.0f);
+		Assert::IsFalse(cc::math::epaPenetration(a, far, (cc::math::GjkSimplex<float>*)nullptr, &result));
+	}
+};
@@ -0,0 +1,367 @@
+#include "CppUnitTest.h"
+#include <cc/Intersection.hpp>
+#include <cc/Gjk.hpp>
+#include "Common.hpp"
+#include <cc/Random.hpp>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+TEST_CLASS(IntersectionTest) {
+private:
+	cc::math::Random<float, int> rnd;
+
+	cc::Vec3f randomVector( float min, float max ) {
+		return cc::Vec3f(rnd.nextReal(min, max), rnd.nextReal(min, max), rnd.nextReal(min, max));
+	}
+
+	bool containsAll( const std::vector<cc::Vec3f>& points, const cc::Vec3f& center, float radius ) {
+		for( unsigned int i = 0; i < points.size(); ++i ) {
+			if( points[i].distance(center) > radius * 1.0001f + 1e-5f ) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+public:
+	TEST_METHOD(MostSeparatedPoints) {
+		std::vector<cc::Vec3f> points;
+		points.push_back(cc::Vec3f(0.0f, 0.0f, 0.0f));
+		points.push_back(cc::Vec3f(1.0f, -5.0f, 0.0f));
+		points.push_back(cc::Vec3f(2.0f, 0.0f, 1.0f));
+		points.push_back(cc::Vec3f(0.0f, 6.0f, 0.0f));
+		points.push_back(cc::Vec3f(-1.0f, 0.0f, 0.0f));
+		int minIdx = -1;
+		int maxIdx = -1;
+		cc::math::mostSeparatedPointsOnAabb(points, &minIdx, &maxIdx);
+		Assert::AreEqual(1, minIdx);
+		Assert::AreEqual(3, maxIdx);
+	}
+
+	TEST_METHOD(SphereFromPoints) {
+		for( int test = 0; test < 20; ++test ) {
+			std::vector<cc::Vec3f> points;
+			const int count = 1 + test * 997;
+			for( int i = 0; i < count; ++i ) {
+				points.push_back(randomVector(-10.0f, 10.0f) * cc::Vec3f(1.0f, 0.5f, 0.1f * (test % 4)));
+			}
+
+			cc::Vec3f ritterPos;
+			float ritterRadius = -1.0f;
+			cc::math::createSphereFromPoints(points, &ritterPos, &ritterRadius);
+			Assert::IsTrue(containsAll(points, ritterPos, ritterRadius));
+
+			cc::Vec3f minPos;
+			float minRadius = -1.0f;
+			cc::math::createMinimumSphereFromPoints(points, &minPos, &minRadius);
+			Assert::IsTrue(containsAll(points, minPos, minRadius));
+			Assert::IsTrue(minRadius <= ritterRadius * 1.0001f);
+		}
+	}
+
+	TEST_METHOD(MinimumSphere) {
+		// Points on a known sphere plus points inside it.
+		std::vector<cc::Vec3f> points;
+		const cc::Vec3f center(1.0f, 2.0f, 3.0f);
+		for( int i = 0; i < 500; ++i ) {
+			const cc::Vec3f dir = randomVector(-1.0f, 1.0f).normalized();
+			points.push_back(center + dir * ((i % 2) ? 4.0f : rnd.nextReal(0.0f, 4.0f)));
+		}
+		cc::Vec3f pos;
+		float radius = 0.0f;
+		cc::math::createMinimumSphereFromPoints(points, &pos, &radius);
+		Assert::AreEqual(4.0f, radius, TOLERANCE);
+		Assert::IsTrue(pos.distance(center) < TOLERANCE);
+
+		// A single point is a sphere of zero radius.
+		std::vector<cc::Vec3f> single(1, center);
+		cc::math::createMinimumSphereFromPoints(single, &pos, &radius);
+		Assert::AreEqual(0.0f, radius, TOLERANCE);
+		Assert::IsTrue(pos.equalTo(center));
+	}
+
+	TEST_METHOD(StridedPoints) {
+		// Positions interleaved with other attributes must give the same results as a packed copy.
+		struct Vertex {
+			cc::Vec3f position;
+			float weight;
+		};
+		std::vector<Vertex> vertices(5001);
+		std::vector<cc::Vec3f> packed;
+		for( unsigned int i = 0; i < vertices.size(); ++i ) {
+			vertices[i].position = randomVector(-10.0f, 10.0f);
+			vertices[i].weight = 1000.0f;
+			packed.push_back(vertices[i].position);
+		}
+		const cc::math::StridedSpan<const cc::Vec3f> positions(&vertices[0].position, vertices.size(), sizeof(Vertex));
+
+		int packedMin = -1, packedMax = -1, stridedMin = -1, stridedMax = -1;
+		cc::math::mostSeparatedPointsOnAabb(packed, &packedMin, &packedMax);
+		cc::math::mostSeparatedPointsOnAabb(positions, &stridedMin, &stridedMax);
+		Assert::AreEqual(packedMin, stridedMin);
+		Assert::AreEqual(packedMax, stridedMax);
+
+		cc::Vec3f packedPos, stridedPos;
+		float packedRadius = 0.0f, stridedRadius = 0.0f;
+		cc::math::createSphereFromPoints(packed, &packedPos, &packedRadius);
+		cc::math::createSphereFromPoints(positions, &stridedPos, &stridedRadius);
+		Assert::AreEqual(packedRadius, stridedRadius, TOLERANCE);
+		Assert::IsTrue(packedPos.equalTo(stridedPos));
+
+		cc::math::createMinimumSphereFromPoints(positions, &stridedPos, &stridedRadius);
+		Assert::IsTrue(containsAll(packed, stridedPos, stridedRadius));
+	}
+
+	TEST_METHOD(Capsules) {
+		const cc::Vec3f a0(0.0f, 0.0f, 0.0f), a1(0.0f, 4.0f, 0.0f);
+		Assert::IsTrue(cc::math::sphereIntersectsCapsule(cc::Vec3f(1.5f, 2.0f, 0.0f), 1.0f, a0, a1, 0.6f));
+		Assert::IsFalse(cc::math::sphereIntersectsCapsule(cc::Vec3f(1.5f, 2.0f, 0.0f), 1.0f, a0, a1, 0.4f));
+		Assert::IsTrue(cc::math::sphereIntersectsCapsule(cc::Vec3f(0.0f, 5.5f, 0.0f), 1.0f, a0, a1, 0.6f));
+
+		Assert::IsTrue(cc::math::capsuleIntersectsCapsule(a0, a1, 0.5f, cc::Vec3f(-3.0f, 1.0f, 0.9f), cc::Vec3f(3.0f, 1.0f, 0.9f), 0.5f));
+		Assert::IsFalse(cc::math::capsuleIntersectsCapsule(a0, a1, 0.5f, cc::Vec3f(-3.0f, 1.0f, 1.1f), cc::Vec3f(3.0f, 1.0f, 1.1f), 0.5f));
+
+		// Triangle in the y = 2 plane around the capsule's axis, then moved off to the side.
+		const cc::Vec3f t0(-1.0f, 2.0f, -1.0f), t1(1.0f, 2.0f, -1.0f), t2(0.0f, 2.0f, 1.0f);
+		Assert::IsTrue(cc::math::capsuleIntersectsTriangle(a0, a1, 0.1f, t0, t1, t2));
+		const cc::Vec3f side(3.0f, 0.0f, 0.0f);
+		Assert::IsFalse(cc::math::capsuleIntersectsTriangle(a0, a1, 0.1f, t0 + side, t1 + side, t2 + side));
+		Assert::IsFalse(cc::math::capsuleIntersectsTriangle(a0, a1, 2.2f, t0 + side, t1 + side, t2 + side));
+		Assert::IsTrue(cc::math::capsuleIntersectsTriangle(a0, a1, 2.3f, t0 + side, t1 + side, t2 + side));
+		// Below the capsule's end cap.
+		const cc::Vec3f down(0.0f, -2.5f, 0.0f);
+		Assert::IsTrue(cc::math::capsuleIntersectsTriangle(a0, a1, 0.6f, t0 + down, t1 + down, t2 + down));
+		Assert::IsFalse(cc::math::capsuleIntersectsTriangle(a0, a1, 0.4f, t0 + down, t1 + down, t2 + down));
+	}
+
+	TEST_METHOD(CapsuleBatch) {
+		// One capsule against many, broadcast into every lane.
+		const cc::Vec3f a0 = randomVector(-1.0f, 1.0f), a1 = randomVector(-1.0f, 1.0f);
+		const cc::Vec3Soa8f soaA0(a0), soaA1(a1);
+		float aRadius[8];
+		for( unsigned int k = 0; k < 8; ++k ) {
+			aRadius[k] = 0.5f;
+		}
+
+		for( int batch = 0; batch < 100; ++batch ) {
+			cc::Vec3Soa8f b0, b1;
+			float bRadius[8];
+			for( unsigned int k = 0; k < 8; ++k ) {
+				b0.set(k, randomVector(-3.0f, 3.0f));
+				b1.set(k, b0.get(k) + randomVector(-1.0f, 1.0f));
+				bRadius[k] = rnd.nextReal(0.1f, 1.0f);
+			}
+
+			const unsigned int capsuleMask = cc::math::capsuleIntersectsCapsule(soaA0, soaA1, aRadius, b0, b1, bRadius);
+			const unsigned int sphereMask = cc::math::sphereIntersectsCapsule(b0, bRadius, soaA0, soaA1, aRadius);
+			for( unsigned int k = 0; k < 8; ++k ) {
+				Assert::AreEqual(cc::math::capsuleIntersectsCapsule(a0, a1, 0.5f, b0.get(k), b1.get(k), bRadius[k]), (capsuleMask & (1u << k)) != 0);
+				Assert::AreEqual(cc::math::sphereIntersectsCapsule(b0.get(k), bRadius[k], a0, a1, 0.5f), (sphereMask & (1u << k)) != 0);
+			}
+		}
+	}
+
+	TEST_METHOD(TriangleAabb) {
+		const cc::Vec3f center(0.0f, 0.0f, 0.0f);
+		const cc::Vec3f halfSize(1.0f, 1.0f, 1.0f);
+		// Inside, and far away.
+		Assert::IsTrue(cc::math::triangleIntersectsAabb(cc::Vec3f(-0.5f, 0.0f, 0.0f), cc::Vec3f(0.5f, 0.0f, 0.0f), cc::Vec3f(0.0f, 0.5f, 0.0f), center, halfSize));
+		Assert::IsFalse(cc::math::triangleIntersectsAabb(cc::Vec3f(5.0f, 0.0f, 0.0f), cc::Vec3f(6.0f, 0.0f, 0.0f), cc::Vec3f(5.0f, 1.0f, 0.0f), center, halfSize));
+		// Large triangles in the planes x+y+z=3.5 and x+y+z=2.9; only the triangle normal separates the first from the corner (1,1,1).
+		const float sums[] = { 3.5f, 2.9f };
+		for( int i = 0; i < 2; ++i ) {
+			const cc::Vec3f t0(sums[i], 0.0f, 0.0f), t1(0.0f, sums[i], 0.0f), t2(0.0f, 0.0f, sums[i]);
+			Assert::AreEqual(i == 1, cc::math::triangleIntersectsAabb(t0, t1, t2, center, halfSize));
+		}
+
+		// Agrees with the distance from GJK.  GJK reports gaps below 128 epsilon of its vertex magnitudes as touching, and
+		// the Minkowski difference here stays within 16 of the origin, so every gap is judged against that tolerance.
+		const float tolerance = 128.0f * std::numeric_limits<float>::epsilon() * 16.0f;
+		for( int i = 0; i < 500; ++i ) {
+			cc::Vec3f tri[3] = { randomVector(-3.0f, 3.0f), randomVector(-3.0f, 3.0f), randomVector(-3.0f, 3.0f) };
+			const cc::Vec3f boxCenter = randomVector(-1.0f, 1.0f);
+			const cc::Vec3f boxHalfSize = randomVector(0.1f, 1.0f);
+			const cc::math::PointsSupport<float> triangle(cc::math::StridedSpan<const cc::Vec3f>(tri, 3));
+			const cc::math::AabbSupport<float> box(cc::Aabbf(boxCenter - boxHalfSize, boxCenter + boxHalfSize));
+			const float distance = cc::math::gjkDistance(triangle, box, (cc::math::GjkSimplex<float>*)nullptr, (cc::math::GjkResult<float>*)nullptr);
+			if( distance > tolerance ) {
+				Assert::IsFalse(cc::math::triangleIntersectsAabb(tri[0], tri[1], tri[2], boxCenter, boxHalfSize));
+			} else {
+				Assert::IsTrue(cc::math::triangleIntersectsAabb(tri[0], tri[1], tri[2], boxCenter, boxHalfSize + cc::Vec3f(tolerance)));
+			}
+			if( cc::math::triangleIntersectsAabb(tri[0], tri[1], tri[2], boxCenter, boxHalfSize - cc::Vec3f(tolerance)) ) {
+				Assert::AreEqual(0.0f, distance);
+			}
+		}
+	}
+
+	TEST_METHOD(TriangleAabbBatch) {
+		const cc::Vec3f halfSize(0.5f, 0.5f, 0.5f);
+		for( int batch = 0; batch < 100; ++batch ) {
+			const cc::Vec3f t0 = randomVector(-2.0f, 2.0f), t1 = randomVector(-2.0f, 2.0f), t2 = randomVector(-2.0f, 2.0f);
+			cc::Vec3Soa8f centers;
+			for( unsigned int k = 0; k < 8; ++k ) {
+				centers.set(k, randomVector(-2.0f, 2.0f));
+			}
+			const unsigned int mask = cc::math::triangleIntersectsAabb(t0, t1, t2, centers, halfSize);
+			for( unsigned int k = 0; k < 8; ++k ) {
+				Assert::AreEqual(cc::math::triangleIntersectsAabb(t0, t1, t2, centers.get(k), halfSize), (mask & (1u << k)) != 0);
+			}
+		}
+	}
+
+	TEST_METHOD(SweptSphereTriangle) {
+		const cc::Vec3f t0(0.0f, 0.0f, 0.0f), t1(4.0f, 0.0f, 0.0f), t2(0.0f, 4.0f, 0.0f);
+		float t = 0.0f;
+		cc::Vec3f normal, point;
+
+		// Face: falls onto the triangle from above; far too fast for a static test at either end.
+		Assert::IsTrue(cc::math::sweptSphereIntersectsTriangle(cc::Vec3f(1.0f, 1.0f, 10.0f), 1.0f, cc::Vec3f(0.0f, 0.0f, -20.0f), t0, t1, t2, &t, &normal, &point));
+		Assert::AreEqual(0.45f, t, TOLERANCE);
+		Assert::AreEqual(1.0f, normal.z, TOLERANCE);
+		Assert::AreEqual(1.0f, point.x, TOLERANCE);
+		Assert::AreEqual(0.0f, point.z, TOLERANCE);
+		// From below, the normal faces down.
+		Assert::IsTrue(cc::math::sweptSphereIntersectsTriangle(cc::Vec3f(1.0f, 1.0f, -10.0f), 1.0f, cc::Vec3f(0.0f, 0.0f, 20.0f), t0, t1, t2, &t, &normal, &point));
+		Assert::AreEqual(-1.0f, normal.z, TOLERANCE);
+
+		// Edge: passes beside the triangle along z, grazing the edge on the x axis.
+		Assert::IsTrue(cc::math::sweptSphereIntersectsTriangle(cc::Vec3f(2.0f, -0.5f, 5.0f), 1.0f, cc::Vec3f(0.0f, 0.0f, -10.0f), t0, t1, t2, &t, &normal, &point));
+		Assert::AreEqual(0.5f - std::sqrt(0.75f) / 10.0f, t, TOLERANCE);
+		Assert::AreEqual(2.0f, point.x, TOLERANCE);
+		Assert::AreEqual(0.0f, point.y, TOLERANCE);
+		Assert::AreEqual(-0.5f, normal.y, TOLERANCE);
+
+		// Vertex: moves towards the corner at the origin along the diagonal.
+		Assert::IsTrue(cc::math::sweptSphereIntersectsTriangle(cc::Vec3f(-3.0f, -3.0f, 0.0f), 1.0f, cc::Vec3f(6.0f, 6.0f, 0.0f), t0, t1, t2, &t, &normal, &point));
+		Assert::AreEqual((std::sqrt(18.0f) - 1.0f) / std::sqrt(72.0f), t, TOLERANCE);
+		Assert::AreEqual(0.0f, point.x, TOLERANCE);
+		Assert::AreEqual(-std::sqrt(0.5f), normal.x, TOLERANCE);
+
+		// Already touching, moving parallel, and missing.
+		Assert::IsTrue(cc::math::sweptSphereIntersectsTriangle(cc::Vec3f(1.0f, 1.0f, 0.5f), 1.0f, cc::Vec3f(0.0f, 0.0f, 5.0f), t0, t1, t2, &t, &normal, &point));
+		Assert::AreEqual(0.0f, t, TOLERANCE);
+		Assert::AreEqual(1.0f, normal.z, TOLERANCE);
+		Assert::IsFalse(cc::math::sweptSphereIntersectsTriangle(cc::Vec3f(1.0f, 1.0f, 2.0f), 1.0f, cc::Vec3f(5.0f, 0.0f, 0.0f), t0, t1, t2, &t, &normal, &point));
+		Assert::IsFalse(cc::math::sweptSphereIntersectsTriangle(cc::Vec3f(1.0f, 1.0f, 10.0f), 1.0f, cc::Vec3f(0.0f, 0.0f, -5.0f), t0, t1, t2, &t, &normal, &point));
+
+		// Against closest distances along the sweep: apart before the time of impact, touching at it.
+		for( int i = 0; i < 300; ++i ) {
+			const cc::Vec3f a = randomVector(-2.0f, 2.0f), b = randomVector(-2.0f, 2.0f), c = randomVector(-2.0f, 2.0f);
+			const cc::Vec3f start = randomVector(-5.0f, 5.0f);
+			const cc::Vec3f motion = randomVector(-10.0f, 10.0f);
+			const float radius = rnd.nextReal(0.1f, 1.0f);
+			const bool hit = cc::math::sweptSphereIntersectsTriangle(start, radius, motion, a, b, c, &t, &normal, &point);
+			const float end = hit ? t : 1.0f;
+			for( int step = 0; step < 50; ++step ) {
+				const cc::Vec3f p = start + motion * (end * static_cast<float>(step) / 50.0f);
+				Assert::IsTrue(std::sqrt(cc::math::closestPointOnTriangle(p, a, b, c).sqrDistance(p)) >= radius - 1e-3f || (hit && t == 0.0f));
+			}
+			if( hit ) {
+				const cc::Vec3f p = start + motion * t;
+				const cc::Vec3f closest = cc::math::closestPointOnTriangle(p, a, b, c);
+				Assert::AreEqual(radius, std::sqrt(closest.sqrDistance(p)), 1e-3f + (t == 0.0f ? radius : 0.0f));
+				Assert::AreEqual(1.0f, normal.magnitude(), TOLERANCE);
+			}
+		}
+	}
+
+	TEST_METHOD(SweptSphereTriangleBatch) {
+		for( int batch = 0; batch < 50; ++batch ) {
+			cc::Vec3Soa8f t0, t1, t2;
+			for( unsigned int k = 0; k < 8; ++k ) {
+				t0.set(k, randomVector(-2.0f, 2.0f));
+				t1.set(k, randomVector(-2.0f, 2.0f));
+				t2.set(k, randomVector(-2.0f, 2.0f));
+			}
+			const cc::Vec3f start = randomVector(-5.0f, 5.0f);
+			const cc::Vec3f motion = randomVector(-10.0f, 10.0f);
+			float times[8];
+			cc::Vec3Soa8f normals;
+			const unsigned int mask = cc::math::sweptSphereIntersectsTriangle(start, 0.5f, motion, t0, t1, t2, times, &normals, static_cast<cc::Vec3Soa8f*>(nullptr));
+			for( unsigned int k = 0; k < 8; ++k ) {
+				float t;
+				cc::Vec3f normal;
+				const bool hit = cc::math::sweptSphereIntersectsTriangle(start, 0.5f, motion, t0.get(k), t1.get(k), t2.get(k), &t, &normal, static_cast<cc::Vec3f*>(nullptr));
+				Assert::AreEqual(hit, (mask & (1u << k)) != 0);
+				if( hit ) {
+					Assert::AreEqual(t, times[k], TOLERANCE);
+					Assert::AreEqual(normal.x, normals.x[k], TOLERANCE);
+				}
+			}
+		}
+	}
+
+	TEST_METHOD(RaySphere) {
+		float t;
+		Assert::IsTrue(cc::math::rayIntersectsSphere(cc::Vec3f(-5.0f, 0.0f, 0.0f), cc::Vec3f(1.0f, 0.0f, 0.0f), cc::Vec3f(0.0f), 1.0f, &t));
+		Assert::AreEqual(4.0f, t, TOLERANCE);
+		Assert::IsTrue(cc::math::rayIntersectsSphere(cc::Vec3f(-5.0f, 0.0f, 0.0f), cc::Vec3f(2.0f, 0.0f, 0.0f), cc::Vec3f(0.0f), 1.0f, &t));
+		Assert::AreEqual(2.0f, t, TOLERANCE);
+		Assert::IsTrue(cc::math::rayIntersectsSphere(cc::Vec3f(0.5f, 0.0f, 0.0f), cc::Vec3f(1.0f, 0.0f, 0.0f), cc::Vec3f(0.0f), 1.0f, &t));
+		Assert::AreEqual(0.0f, t, TOLERANCE);
+		Assert::IsFalse(cc::math::rayIntersectsSphere(cc::Vec3f(-5.0f, 0.0f, 0.0f), cc::Vec3f(-1.0f, 0.0f, 0.0f), cc::Vec3f(0.0f), 1.0f, &t));
+		Assert::IsFalse(cc::math::rayIntersectsSphere(cc::Vec3f(-5.0f, 2.0f, 0.0f), cc::Vec3f(1.0f, 0.0f, 0.0f), cc::Vec3f(0.0f), 1.0f, &t));
+	}
+
+	TEST_METHOD(RayAabb) {
+		const cc::Vec3f boxMin(-1.0f);
+		const cc::Vec3f boxMax(1.0f);
+		float tNear, tFar;
+		Assert::IsTrue(cc::math::rayIntersectsAabb(cc::Vec3f(-5.0f, 0.5f, 0.0f), cc::Vec3f(1.0f, 0.0f, 0.0f), boxMin, boxMax, &tNear, &tFar));
+		Assert::AreEqual(4.0f, tNear, TOLERANCE);
+		Assert::AreEqual(6.0f, tFar, TOLERANCE);
+		Assert::IsTrue(cc::math::rayIntersectsAabb(cc::Vec3f(0.0f), cc::Vec3f(0.0f, 0.0f, -1.0f), boxMin, boxMax, &tNear, &tFar));
+		Assert::AreEqual(0.0f, tNear, TOLERANCE);
+		Assert::AreEqual(1.0f, tFar, TOLERANCE);
+		Assert::IsFalse(cc::math::rayIntersectsAabb(cc::Vec3f(-5.0f, 0.5f, 0.0f), cc::Vec3f(-1.0f, 0.0f, 0.0f), boxMin, boxMax, &tNear, &tFar));
+		Assert::IsFalse(cc::math::rayIntersectsAabb(cc::Vec3f(-5.0f, 2.0f, 0.0f), cc::Vec3f(1.0f, 0.0f, 0.0f), boxMin, boxMax, &tNear, &tFar));
+		Assert::IsFalse(cc::math::rayIntersectsAabb(cc::Vec3f(-5.0f, 0.0f, 0.0f), cc::Vec3f(1.0f, 1.0f, 0.0f), boxMin, boxMax, &tNear, &tFar));
+	}
+
+	TEST_METHOD(RayAabbPacket) {
+		const float maxT[8] = { 100.0f, 100.0f, 100.0f, 100.0f, 100.0f, 100.0f, 100.0f, 100.0f };
+		for( int batch = 0; batch < 50; ++batch ) {
+			// Eight rays against one box.
+			cc::Vec3Soa8f origins, invDirs;
+			for( unsigned int k = 0; k < 8; ++k ) {
+				origins.set(k, randomVector(-5.0f, 5.0f));
+				invDirs.set(k, 1.0f / randomVector(-1.0f, 1.0f));
+			}
+			const cc::Vec3f boxMin = randomVector(-2.0f, 0.0f);
+			const cc::Vec3f boxMax = boxMin + randomVector(0.1f, 2.0f);
+			float tNear[8];
+			unsigned int mask = cc::math::rayIntersectsAabb(origins, invDirs, boxMin, boxMax, maxT, tNear);
+			for( unsigned int k = 0; k < 8; ++k ) {
+				float t, tFar;
+				const bool hit = cc::math::rayIntersectsAabb(origins.get(k), 1.0f / invDirs.get(k), boxMin, boxMax, &t, &tFar) && t <= maxT[k];
+				Assert::AreEqual(hit, (mask & (1u << k)) != 0);
+				if( hit ) {
+					Assert::AreEqual(t, tNear[k], TOLERANCE);
+				}
+			}
+
+			// One ray against eight boxes.
+			cc::Vec3Soa8f boxMins, boxMaxs;
+			for( unsigned int k = 0; k < 8; ++k ) {
+				const cc::Vec3f lo = randomVector(-2.0f, 0.0f);
+				boxMins.set(k, lo);
+				boxMaxs.set(k, lo + randomVector(0.1f, 2.0f));
+			}
+			const cc::Vec3f origin = randomVector(-5.0f, 5.0f);
+			const cc::Vec3f direction = randomVector(-1.0f, 1.0f);
+			mask = cc::math::rayIntersectsAabb(origin, 1.0f / direction, boxMins, boxMaxs, 100.0f, tNear);
+			for( unsigned int k = 0; k < 8; ++k ) {
+				float t, tFar;
+				const bool hit = cc::math::rayIntersectsAabb(origin, direction, boxMins.get(k), boxMaxs.get(k), &t, &tFar) && t <= 100.0f;
+				Assert::AreEqual(hit, (mask & (1u << k)) != 0);
+				if( hit ) {
+					Assert::AreEqual(t, tNear[k], TOLERANCE);
+				}
+			}
+		}
+	}
+};
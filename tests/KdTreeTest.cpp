@@ -0,0 +1,144 @@
+#include "CppUnitTest.h"
+#include <cc/KdTree.hpp>
+#include <cc/Random.hpp>
+#include <algorithm>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+TEST_CLASS(KdTreeTest) {
+private:
+	cc::math::Random<float, int> rnd;
+	std::vector<cc::Vec3f> points;
+	std::vector<cc::Vec3f> queries;
+
+	cc::Vec3f randomVector( float min, float max ) {
+		return cc::Vec3f(rnd.nextReal(min, max), rnd.nextReal(min, max), rnd.nextReal(min, max));
+	}
+
+	// Flattened cloud with duplicates, plus queries both inside and outside it.
+	void buildCloud( unsigned int count ) {
+		points.clear();
+		for( unsigned int i = 0; i < count; ++i ) {
+			points.push_back(randomVector(-10.0f, 10.0f) * cc::Vec3f(1.0f, 0.25f, 2.0f));
+		}
+		for( unsigned int i = 0; i < count / 20; ++i ) {
+			points.push_back(points[i * 7]);
+		}
+		queries.clear();
+		for( unsigned int i = 0; i < 200; ++i ) {
+			queries.push_back(randomVector(-12.0f, 12.0f) * ((i % 10 == 0) ? 5.0f : 1.0f));
+		}
+	}
+
+	std::vector<float> sortedSqrDistances( const cc::Vec3f& point ) const {
+		std::vector<float> result;
+		for( size_t i = 0; i < points.size(); ++i ) {
+			result.push_back(points[i].sqrDistance(point));
+		}
+		std::sort(result.begin(), result.end());
+		return result;
+	}
+
+public:
+	KdTreeTest()
+		: rnd(8642) {
+	}
+
+	TEST_METHOD(Nearest) {
+		buildCloud(4000);
+		cc::KdTreef tree;
+		tree.build(points, 4);
+		Assert::AreEqual(static_cast<unsigned int>(points.size()), tree.size());
+
+		for( size_t q = 0; q < queries.size(); ++q ) {
+			unsigned int index;
+			float sqrDistance;
+			Assert::IsTrue(tree.nearest(queries[q], &index, &sqrDistance));
+			Assert::AreEqual(sortedSqrDistances(queries[q])[0], sqrDistance);
+			Assert::AreEqual(sqrDistance, points[index].sqrDistance(queries[q]));
+		}
+
+		// Every point finds itself.
+		for( unsigned int i = 0; i < points.size(); i += 13 ) {
+			float sqrDistance;
+			tree.nearest(points[i], (unsigned int*)nullptr, &sqrDistance);
+			Assert::AreEqual(0.0f, sqrDistance);
+		}
+
+		tree.clear();
+		Assert::IsFalse(tree.nearest(queries[0], (unsigned int*)nullptr, (float*)nullptr));
+	}
+
+	TEST_METHOD(KNearest) {
+		buildCloud(3000);
+		cc::KdTreef tree;
+		tree.build(points);
+
+		std::vector<unsigned int> found;
+		std::vector<float> sqrDistances;
+		for( size_t q = 0; q < queries.size(); ++q ) {
+			const unsigned int k = 1 + q % 16;
+			Assert::AreEqual(k, tree.nearest(queries[q], k, &found, &sqrDistances));
+			const std::vector<float> expected = sortedSqrDistances(queries[q]);
+			for( unsigned int i = 0; i < k; ++i ) {
+				Assert::AreEqual(expected[i], sqrDistances[i]);
+				Assert::AreEqual(expected[i], points[found[i]].sqrDistance(queries[q]));
+			}
+		}
+
+		// Batched results match the single queries.
+		const unsigned int k = 5;
+		std::vector<unsigned int> batchIndices;
+		std::vector<float> batchSqrDistances;
+		Assert::AreEqual(k, tree.nearestBatch(queries, k, &batchIndices, &batchSqrDistances));
+		Assert::AreEqual(queries.size() * k, batchIndices.size());
+		for( size_t q = 0; q < queries.size(); ++q ) {
+			tree.nearest(queries[q], k, &found, &sqrDistances);
+			for( unsigned int i = 0; i < k; ++i ) {
+				Assert::AreEqual(found[i], batchIndices[q * k + i]);
+				Assert::AreEqual(sqrDistances[i], batchSqrDistances[q * k + i]);
+			}
+		}
+
+		std::vector<unsigned int> nearestIndices;
+		tree.nearestBatch(queries, &nearestIndices, (std::vector<float>*)nullptr);
+		for( size_t q = 0; q < queries.size(); ++q ) {
+			Assert::AreEqual(batchSqrDistances[q * k], points[nearestIndices[q]].sqrDistance(queries[q]));
+		}
+	}
+
+	TEST_METHOD(Radius) {
+		buildCloud(5000);
+		cc::KdTreef tree;
+		tree.build(points);
+
+		const float radius = 1.5f;
+		std::vector<unsigned int> offsets;
+		std::vector<unsigned int> batch;
+		const unsigned int total = tree.queryRadiusBatch(queries, radius, &offsets, &batch);
+		Assert::AreEqual(queries.size() + 1, offsets.size());
+		Assert::AreEqual(static_cast<size_t>(total), batch.size());
+
+		std::vector<unsigned int> found;
+		for( size_t q = 0; q < queries.size(); ++q ) {
+			tree.queryRadius(queries[q], radius, &found);
+			std::sort(found.begin(), found.end());
+
+			std::vector<unsigned int> expected;
+			for( unsigned int i = 0; i < points.size(); ++i ) {
+				if( points[i].sqrDistance(queries[q]) <= radius * radius ) {
+					expected.push_back(i);
+				}
+			}
+			Assert::AreEqual(expected.size(), found.size());
+			for( size_t i = 0; i < expected.size(); ++i ) {
+				Assert::AreEqual(expected[i], found[i]);
+			}
+
+			std::vector<unsigned int> fromBatch(batch.begin() + offsets[q], batch.begin() + offsets[q + 1]);
+			std::sort(fromBatch.begin(), fromBatch.end());
+			Assert::IsTrue(fromBatch == expected);
+		}
+	}
+};
@@ -0,0 +1,96 @@
+#include "CppUnitTest.h"
+#include <cc/LowDiscrepancy.hpp>
+#include <cmath>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+TEST_CLASS(LowDiscrepancyTest) {
+public:
+	TEST_METHOD(Sobol) {
+		const cc::Sobolf sobol;
+		const float dim0[4] = { 0.0f, 0.5f, 0.25f, 0.75f };
+		const float dim1[4] = { 0.0f, 0.5f, 0.75f, 0.25f };
+		for( unsigned int i = 0; i < 4; ++i ) {
+			Assert::AreEqual(dim0[i], sobol.sample(i, 0), 1e-6f);
+			Assert::AreEqual(dim1[i], sobol.sample(i, 1), 1e-6f);
+		}
+
+		// Scrambling keeps every dimension stratified, and the first two dimensions jointly so.
+		const cc::Sobolf scrambled(7);
+		for( unsigned int d = 0; d < cc::Sobolf::MAX_DIMENSIONS; ++d ) {
+			std::vector<int> bins(256, 0);
+			for( unsigned int i = 0; i < 256; ++i ) {
+				const float x = scrambled.sample(i, d);
+				Assert::IsTrue(x >= 0.0f && x < 1.0f);
+				bins[static_cast<int>(x * 256.0f)] += 1;
+			}
+			for( int b = 0; b < 256; ++b ) {
+				Assert::AreEqual(1, bins[b]);
+			}
+		}
+		std::vector<int> cells(256, 0);
+		for( unsigned int i = 0; i < 256; ++i ) {
+			cells[static_cast<int>(scrambled.sample(i, 0) * 16.0f) * 16 + static_cast<int>(scrambled.sample(i, 1) * 16.0f)] += 1;
+		}
+		for( int c = 0; c < 256; ++c ) {
+			Assert::AreEqual(1, cells[c]);
+		}
+		Assert::IsTrue(scrambled.sample(1, 2) != cc::Sobolf(8).sample(1, 2));
+
+		// Bulk fills match random access from any starting index.
+		std::vector<double> out(300);
+		const cc::Sobold scrambledD(3);
+		scrambledD.fill(1001, 5, out);
+		for( unsigned int i = 0; i < out.size(); ++i ) {
+			Assert::AreEqual(scrambledD.sample(1001 + i, 5), out[i]);
+		}
+
+		// Integrating x * y over the unit square converges much faster than with random points.
+		double sum = 0.0;
+		for( unsigned int i = 0; i < 1024; ++i ) {
+			sum += scrambledD.sample(i, 0) * scrambledD.sample(i, 1);
+		}
+		Assert::AreEqual(0.25, sum / 1024.0, 1e-3);
+	}
+
+	TEST_METHOD(Halton) {
+		const cc::Haltonf halton;
+		Assert::AreEqual(0.0f, halton.sample(0, 1), 1e-6f);
+		Assert::AreEqual(1.0f / 3.0f, halton.sample(1, 1), 1e-6f);
+		Assert::AreEqual(2.0f / 3.0f, halton.sample(2, 1), 1e-6f);
+		Assert::AreEqual(1.0f / 9.0f, halton.sample(3, 1), 1e-6f);
+		Assert::AreEqual(0.375f, halton.sample(6, 0), 1e-6f);
+		for( unsigned int d = 0; d < cc::Haltonf::MAX_DIMENSIONS; ++d ) {
+			const float x = halton.sample(0xFFFFFFFFu, d);
+			Assert::IsTrue(x >= 0.0f && x < 1.0f);
+		}
+
+		std::vector<float> out(100);
+		halton.fill(77, 4, out);
+		for( unsigned int i = 0; i < out.size(); ++i ) {
+			Assert::AreEqual(halton.sample(77 + i, 4), out[i]);
+		}
+	}
+
+	TEST_METHOD(Kronecker) {
+		// R2: alphas are the inverse powers of the plastic number.
+		const cc::Kroneckerd r2;
+		Assert::AreEqual(2u, r2.dimensions());
+		const double plastic = 1.32471795724474602596;
+		for( unsigned int i = 0; i < 100; ++i ) {
+			const double x = 0.5 + i / plastic;
+			const double y = 0.5 + i / (plastic * plastic);
+			Assert::AreEqual(x - std::floor(x), r2.sample(i, 0), 1e-9);
+			Assert::AreEqual(y - std::floor(y), r2.sample(i, 1), 1e-9);
+		}
+
+		const cc::Kroneckerf r5(5, 0.0f);
+		std::vector<float> out(100);
+		r5.fill(12345, 4, out);
+		for( unsigned int i = 0; i < out.size(); ++i ) {
+			Assert::AreEqual(r5.sample(12345 + i, 4), out[i]);
+			Assert::IsTrue(out[i] >= 0.0f && out[i] < 1.0f);
+		}
+	}
+};
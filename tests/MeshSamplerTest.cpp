@@ -0,0 +1,110 @@
+#include "CppUnitTest.h"
+#include <cc/MeshSampler.hpp>
+#include <cc/Random.hpp>
+#include "Common.hpp"
+#include <cmath>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+TEST_CLASS(MeshSamplerTest) {
+private:
+	cc::math::Random<float, int> rnd;
+	std::vector<cc::Vec3f> positions;
+	std::vector<unsigned int> indices;
+
+	// Three triangles in the XY plane with areas 1, 0 and 3.
+	void buildMesh() {
+		positions.clear();
+		indices.clear();
+		positions.push_back(cc::Vec3f(0.0f, 0.0f, 0.0f)); positions.push_back(cc::Vec3f(2.0f, 0.0f, 0.0f)); positions.push_back(cc::Vec3f(0.0f, 1.0f, 0.0f));
+		positions.push_back(cc::Vec3f(5.0f, 0.0f, 0.0f)); positions.push_back(cc::Vec3f(6.0f, 0.0f, 0.0f)); positions.push_back(cc::Vec3f(7.0f, 0.0f, 0.0f));
+		positions.push_back(cc::Vec3f(10.0f, 0.0f, 0.0f)); positions.push_back(cc::Vec3f(13.0f, 0.0f, 0.0f)); positions.push_back(cc::Vec3f(10.0f, 2.0f, 0.0f));
+		for( unsigned int i = 0; i < 9; ++i ) {
+			indices.push_back(i);
+		}
+	}
+
+public:
+	MeshSamplerTest()
+		: rnd(1234) {
+	}
+
+	TEST_METHOD(AreasAndEmpty) {
+		cc::MeshSamplerf sampler;
+		Assert::IsTrue(sampler.empty());
+		Assert::IsFalse(sampler.sample(rnd, nullptr, nullptr, nullptr));
+		Assert::AreEqual(0u, sampler.sample(rnd, 10, nullptr, nullptr, nullptr));
+
+		buildMesh();
+		sampler.build(positions, indices);
+		Assert::IsFalse(sampler.empty());
+		Assert::AreEqual(3u, sampler.triangleCount());
+		Assert::AreEqual(4.0f, sampler.totalArea(), TOLERANCE);
+		Assert::AreEqual(1.0f, sampler.triangleArea(0), TOLERANCE);
+		Assert::AreEqual(0.0f, sampler.triangleArea(1), TOLERANCE);
+		Assert::AreEqual(3.0f, sampler.triangleArea(2), TOLERANCE);
+	}
+
+	TEST_METHOD(Distribution) {
+		buildMesh();
+		cc::MeshSamplerf sampler;
+		sampler.build(positions, indices);
+
+		const unsigned int COUNT = 40000;
+		std::vector<cc::Vec3f> points;
+		std::vector<unsigned int> triangles;
+		std::vector<cc::Vec3f> barycentrics;
+		Assert::AreEqual(COUNT, sampler.sample(rnd, COUNT, &points, &triangles, &barycentrics));
+		Assert::AreEqual(static_cast<size_t>(COUNT), points.size());
+
+		unsigned int perTriangle[3] = { 0, 0, 0 };
+		float meanU = 0.0f;
+		for( unsigned int i = 0; i < COUNT; ++i ) {
+			const unsigned int t = triangles[i];
+			++perTriangle[t];
+			const cc::Vec3f& b = barycentrics[i];
+			Assert::IsTrue(b.x >= -1e-6f && b.y >= -1e-6f && b.z >= -1e-6f);
+			Assert::AreEqual(1.0f, b.x + b.y + b.z, TOLERANCE);
+			const cc::Vec3f expected = positions[t * 3 + 0] * b.x + positions[t * 3 + 1] * b.y + positions[t * 3 + 2] * b.z;
+			Assert::AreEqual(expected.x, points[i].x, TOLERANCE);
+			Assert::AreEqual(expected.y, points[i].y, TOLERANCE);
+			meanU += b.x;
+		}
+		// Triangles are picked by area, and points are uniform within them: each weight averages a third.
+		Assert::AreEqual(0u, perTriangle[1]);
+		Assert::AreEqual(0.25f, static_cast<float>(perTriangle[0]) / COUNT, TOLERANCE);
+		Assert::AreEqual(0.75f, static_cast<float>(perTriangle[2]) / COUNT, TOLERANCE);
+		Assert::AreEqual(1.0f / 3.0f, meanU / COUNT, TOLERANCE);
+	}
+
+	TEST_METHOD(Update) {
+		buildMesh();
+		cc::MeshSamplerf sampler;
+		sampler.build(positions, indices);
+
+		// Uniform scale keeps the area ratios, so the table can be kept.
+		std::vector<cc::Vec3f> scaled(positions);
+		for( size_t i = 0; i < scaled.size(); ++i ) {
+			scaled[i] = scaled[i] * 2.0f;
+		}
+		sampler.update(scaled, false);
+		Assert::AreEqual(16.0f, sampler.totalArea(), TOLERANCE);
+		cc::Vec3f point;
+		unsigned int triangle = 0;
+		Assert::IsTrue(sampler.sample(rnd, &point, &triangle, nullptr));
+		Assert::IsTrue(triangle != 1);
+		Assert::IsTrue(point.x >= 0.0f && point.x <= 26.0f);
+
+		// Grow the middle triangle to area 4; it should now get half of the samples.
+		positions[5] = cc::Vec3f(5.0f, 8.0f, 0.0f);
+		sampler.update(positions);
+		Assert::AreEqual(8.0f, sampler.totalArea(), TOLERANCE);
+		const unsigned int COUNT = 20000;
+		unsigned int middle = 0;
+		for( unsigned int i = 0; i < COUNT; ++i ) {
+			middle += (sampler.pickTriangle(rnd) == 1) ? 1 : 0;
+		}
+		Assert::AreEqual(0.5f, static_cast<float>(middle) / COUNT, TOLERANCE);
+	}
+};
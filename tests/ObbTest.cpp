@@ -0,0 +1,162 @@
+#include "CppUnitTest.h"
+#include <cc/Obb.hpp>
+#include <cc/SymmetricEigen.hpp>
+#include <cc/Random.hpp>
+#include "Common.hpp"
+#include <cmath>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+TEST_CLASS(ObbTest) {
+private:
+	cc::math::Random<float, int> rnd;
+
+	cc::Vec3f randomVector( float min, float max ) {
+		return cc::Vec3f(rnd.nextReal(min, max), rnd.nextReal(min, max), rnd.nextReal(min, max));
+	}
+
+	cc::SymMat3f randomSymmetric() {
+		return cc::SymMat3f(rnd.nextReal(-5.0f, 5.0f), rnd.nextReal(-5.0f, 5.0f), rnd.nextReal(-5.0f, 5.0f), rnd.nextReal(-5.0f, 5.0f), rnd.nextReal(-5.0f, 5.0f), rnd.nextReal(-5.0f, 5.0f));
+	}
+
+	void checkEigen( const cc::SymMat3f& m, const cc::Vec3f& values, const cc::Vec3f* vectors ) {
+		Assert::IsTrue(values.x >= values.y && values.y >= values.z);
+		for( unsigned int i = 0; i < 3; ++i ) {
+			Assert::AreEqual(1.0f, vectors[i].magnitude(), TOLERANCE);
+			const cc::Vec3f mv = m * vectors[i];
+			const cc::Vec3f lv = vectors[i] * values[i];
+			Assert::AreEqual(lv.x, mv.x, TOLERANCE);
+			Assert::AreEqual(lv.y, mv.y, TOLERANCE);
+			Assert::AreEqual(lv.z, mv.z, TOLERANCE);
+		}
+		Assert::AreEqual(0.0f, vectors[0].dot(vectors[1]), TOLERANCE);
+		Assert::AreEqual(1.0f, vectors[0].cross(vectors[1]).dot(vectors[2]), TOLERANCE);
+	}
+
+	// Points filling a box of the given half extents, rotated about a random axis and moved away from the origin.
+	std::vector<cc::Vec3f> rotatedBox( const cc::Vec3f& halfExtents, cc::Onbf* outAxes ) {
+		cc::Onbf axes;
+		axes.initFromUV(randomVector(-1.0f, 1.0f), randomVector(-1.0f, 1.0f));
+		const cc::Vec3f center = randomVector(-100.0f, 100.0f);
+		std::vector<cc::Vec3f> points;
+		for( unsigned int i = 0; i < 2000; ++i ) {
+			const cc::Vec3f local(rnd.nextReal(-halfExtents.x, halfExtents.x), rnd.nextReal(-halfExtents.y, halfExtents.y), rnd.nextReal(-halfExtents.z, halfExtents.z));
+			points.push_back(center + axes.u() * local.x + axes.v() * local.y + axes.w() * local.z);
+		}
+		for( unsigned int i = 0; i < 8; ++i ) {
+			const cc::Vec3f local((i & 1) ? halfExtents.x : -halfExtents.x, (i & 2) ? halfExtents.y : -halfExtents.y, (i & 4) ? halfExtents.z : -halfExtents.z);
+			points.push_back(center + axes.u() * local.x + axes.v() * local.y + axes.w() * local.z);
+		}
+		*outAxes = axes;
+		return points;
+	}
+
+public:
+	ObbTest()
+		: rnd(2468) {
+	}
+
+	TEST_METHOD(Eigen) {
+		// Diagonal, repeated and zero eigenvalues.
+		cc::Vec3f values;
+		cc::Vec3f vectors[3];
+		const cc::SymMat3f diagonal(1.0f, 0.0f, 0.0f, 3.0f, 0.0f, 2.0f);
+		cc::math::symmetricEigen(diagonal, &values, vectors);
+		Assert::AreEqual(3.0f, values.x, TOLERANCE);
+		Assert::AreEqual(2.0f, values.y, TOLERANCE);
+		Assert::AreEqual(1.0f, values.z, TOLERANCE);
+		checkEigen(diagonal, values, vectors);
+		checkEigen(cc::SymMat3f(2.0f, 0.0f, 0.0f, 2.0f, 0.0f, 2.0f), cc::Vec3f(2.0f), vectors);
+		cc::math::symmetricEigen(cc::SymMat3f(), &values, vectors);
+		Assert::AreEqual(0.0f, values.x, TOLERANCE);
+		checkEigen(cc::SymMat3f(), values, vectors);
+
+		for( int i = 0; i < 200; ++i ) {
+			const cc::SymMat3f m = randomSymmetric();
+			cc::math::symmetricEigen(m, &values, vectors);
+			checkEigen(m, values, vectors);
+		}
+	}
+
+	TEST_METHOD(EigenBatch) {
+		for( int batch = 0; batch < 50; ++batch ) {
+			cc::math::SymMat3Soa<float, 8> matrices;
+			for( unsigned int k = 0; k < 8; ++k ) {
+				matrices.set(k, randomSymmetric());
+			}
+			cc::Vec3Soa8f values;
+			cc::Vec3Soa8f vectors[3];
+			cc::math::symmetricEigen(matrices, &values, vectors);
+			for( unsigned int k = 0; k < 8; ++k ) {
+				cc::Vec3f scalarValues;
+				cc::math::symmetricEigen(matrices.get(k), &scalarValues, static_cast<cc::Vec3f*>(nullptr));
+				Assert::AreEqual(scalarValues.x, values.x[k], TOLERANCE);
+				Assert::AreEqual(scalarValues.z, values.z[k], TOLERANCE);
+				const cc::Vec3f laneVectors[3] = { vectors[0].get(k), vectors[1].get(k), vectors[2].get(k) };
+				checkEigen(matrices.get(k), values.get(k), laneVectors);
+			}
+		}
+	}
+
+	TEST_METHOD(Covariance) {
+		std::vector<cc::Vec3f> points;
+		points.push_back(cc::Vec3f(1001.0f, 5.0f, 0.0f));
+		points.push_back(cc::Vec3f(999.0f, 5.0f, 0.0f));
+		points.push_back(cc::Vec3f(1000.0f, 6.0f, 0.0f));
+		points.push_back(cc::Vec3f(1000.0f, 4.0f, 0.0f));
+		cc::Vec3f mean;
+		const cc::SymMat3f c = cc::math::computeCovariance(points, &mean);
+		Assert::AreEqual(1000.0f, mean.x, TOLERANCE);
+		Assert::AreEqual(5.0f, mean.y, TOLERANCE);
+		Assert::AreEqual(0.5f, c.xx, TOLERANCE);
+		Assert::AreEqual(0.5f, c.yy, TOLERANCE);
+		Assert::AreEqual(0.0f, c.xy, TOLERANCE);
+		Assert::AreEqual(0.0f, c.zz, TOLERANCE);
+	}
+
+	TEST_METHOD(Fit) {
+		Assert::AreEqual(0.0f, cc::math::fitObb(std::vector<cc::Vec3f>()).volume(), TOLERANCE);
+
+		const cc::Vec3f halfExtents(4.0f, 2.0f, 0.5f);
+		cc::Onbf axes;
+		const std::vector<cc::Vec3f> points = rotatedBox(halfExtents, &axes);
+		const cc::Obbf box = cc::math::fitObb(points);
+
+		// Distinct spreads, so the fitted axes are the box's own (up to sign and sampling noise) and the box is tight.
+		Assert::AreEqual(1.0f, std::abs(box.axes.u().dot(axes.u())), TOLERANCE);
+		Assert::AreEqual(1.0f, std::abs(box.axes.v().dot(axes.v())), TOLERANCE);
+		Assert::AreEqual(1.0f, std::abs(box.axes.w().dot(axes.w())), TOLERANCE);
+		Assert::AreEqual(halfExtents.x, box.halfExtents.x, 0.05f);
+		Assert::AreEqual(halfExtents.y, box.halfExtents.y, 0.05f);
+		Assert::AreEqual(halfExtents.z, box.halfExtents.z, 0.05f);
+		Assert::AreEqual(32.0f, box.volume(), 3.0f);
+		for( size_t i = 0; i < points.size(); ++i ) {
+			const cc::Vec3f local = box.toLocal(points[i]);
+			Assert::IsTrue(std::abs(local.x) <= box.halfExtents.x + 1e-3f && std::abs(local.y) <= box.halfExtents.y + 1e-3f && std::abs(local.z) <= box.halfExtents.z + 1e-3f);
+		}
+		const cc::Vec3f corner = box.corner(7);
+		Assert::AreEqual(corner.x, box.toWorld(box.toLocal(corner)).x, TOLERANCE);
+		Assert::IsTrue(box.contains(box.center));
+		Assert::IsFalse(box.contains(box.center + box.axes.u() * 5.0f));
+	}
+
+	TEST_METHOD(FitBatch) {
+		std::vector<std::vector<cc::Vec3f> > inputs;
+		for( unsigned int i = 0; i < 19; ++i ) {
+			cc::Onbf axes;
+			inputs.push_back(rotatedBox(cc::Vec3f(1.0f + i, 0.5f + 0.1f * i, 0.25f), &axes));
+		}
+		inputs[5].clear();
+
+		std::vector<cc::Obbf> boxes;
+		cc::math::fitObbs(inputs, &boxes);
+		Assert::AreEqual(inputs.size(), boxes.size());
+		for( size_t i = 0; i < inputs.size(); ++i ) {
+			const cc::Obbf single = cc::math::fitObb(inputs[i]);
+			Assert::AreEqual(single.volume(), boxes[i].volume(), 0.01f * single.volume() + TOLERANCE);
+			Assert::AreEqual(single.center.x, boxes[i].center.x, TOLERANCE);
+			Assert::AreEqual(single.halfExtents.x, boxes[i].halfExtents.x, TOLERANCE);
+		}
+	}
+};
@@ -0,0 +1,103 @@
+#include "CppUnitTest.h"
+#include <cc/Plane.hpp>
+#include <cc/Distance.hpp>
+#include "Common.hpp"
+#include <cc/Random.hpp>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+TEST_CLASS(PlaneTest) {
+private:
+	cc::math::Random<float, int> rnd;
+
+	cc::Vec3f randomVector( float min, float max ) {
+		return cc::Vec3f(rnd.nextReal(min, max), rnd.nextReal(min, max), rnd.nextReal(min, max));
+	}
+
+public:
+	PlaneTest()
+		: rnd(24680) {
+	}
+
+	TEST_METHOD(Construction) {
+		const cc::Planef plane = cc::Planef::fromPoints(cc::Vec3f(0.0f, 2.0f, 0.0f), cc::Vec3f(0.0f, 2.0f, 1.0f), cc::Vec3f(1.0f, 2.0f, 0.0f));
+		Assert::AreEqual(0.0f, plane.normal.x, TOLERANCE);
+		Assert::AreEqual(1.0f, plane.normal.y, TOLERANCE);
+		Assert::AreEqual(0.0f, plane.normal.z, TOLERANCE);
+		Assert::AreEqual(2.0f, plane.d, TOLERANCE);
+
+		Assert::AreEqual(3.0f, plane.distance(cc::Vec3f(7.0f, 5.0f, -1.0f)), TOLERANCE);
+		Assert::AreEqual(-3.0f, plane.flipped().distance(cc::Vec3f(7.0f, 5.0f, -1.0f)), TOLERANCE);
+		Assert::AreEqual(2.0f, plane.project(cc::Vec3f(7.0f, 5.0f, -1.0f)).y, TOLERANCE);
+
+		Assert::IsTrue(cc::math::IN_FRONT_OF_PLANE == plane.classify(cc::Vec3f(0.0f, 2.5f, 0.0f), 0.01f));
+		Assert::IsTrue(cc::math::BEHIND_PLANE == plane.classify(cc::Vec3f(0.0f, 1.5f, 0.0f), 0.01f));
+		Assert::IsTrue(cc::math::ON_PLANE == plane.classify(cc::Vec3f(3.0f, 2.005f, 0.0f), 0.01f));
+
+		cc::Planef scaled(cc::Vec3f(0.0f, 0.0f, 4.0f), 8.0f);
+		scaled.normalize();
+		Assert::AreEqual(1.0f, scaled.normal.z, TOLERANCE);
+		Assert::AreEqual(2.0f, scaled.d, TOLERANCE);
+
+		// Matches the point/normal form, which now returns the vector's own type.
+		const cc::Vec3d point(1.0, 2.0, 3.0), planePoint(0.5, 0.5, 0.5), normal(0.0, 0.6, 0.8);
+		const double distance = cc::math::perpendicularDistanceToPointFromPlane(point, planePoint, normal);
+		Assert::AreEqual(cc::Planed(normal, planePoint).distance(point), distance, 1e-12);
+	}
+
+	TEST_METHOD(BulkDistances) {
+		const cc::Planef plane(randomVector(-1.0f, 1.0f).normalized(), rnd.nextReal(-2.0f, 2.0f));
+		std::vector<cc::Vec3f> points;
+		for( int i = 0; i < 1003; ++i ) {
+			points.push_back(randomVector(-5.0f, 5.0f));
+		}
+
+		std::vector<float> distances;
+		cc::math::distancesToPlane(plane, points, &distances);
+		Assert::AreEqual(points.size(), distances.size());
+		for( size_t i = 0; i < points.size(); ++i ) {
+			Assert::AreEqual(plane.distance(points[i]), distances[i], TOLERANCE);
+		}
+
+		std::vector<unsigned char> sides;
+		Assert::AreEqual(static_cast<unsigned char>(cc::math::STRADDLING_PLANE), cc::math::classifyPoints(plane, points, 0.5f, &sides));
+		for( size_t i = 0; i < points.size(); ++i ) {
+			Assert::AreEqual(static_cast<unsigned char>(plane.classify(points[i], 0.5f)), sides[i]);
+		}
+
+		// All in front.
+		std::vector<cc::Vec3f> front;
+		for( int i = 0; i < 20; ++i ) {
+			front.push_back(plane.normal * rnd.nextReal(3.0f, 4.0f) + plane.normal * plane.d);
+		}
+		Assert::AreEqual(static_cast<unsigned char>(cc::math::IN_FRONT_OF_PLANE), cc::math::classifyPoints(plane, front, 0.5f, &sides));
+	}
+
+	TEST_METHOD(Triangles) {
+		// Quad strip along x, cut by the plane x = 1.5: only the triangles spanning x = 1..2 straddle.
+		std::vector<cc::Vec3f> positions;
+		std::vector<unsigned int> indices;
+		for( unsigned int i = 0; i <= 4; ++i ) {
+			positions.push_back(cc::Vec3f(static_cast<float>(i), 0.0f, 0.0f));
+			positions.push_back(cc::Vec3f(static_cast<float>(i), 1.0f, 0.0f));
+		}
+		for( unsigned int i = 0; i < 4; ++i ) {
+			const unsigned int quad[6] = { i * 2, i * 2 + 2, i * 2 + 3, i * 2, i * 2 + 3, i * 2 + 1 };
+			indices.insert(indices.end(), quad, quad + 6);
+		}
+
+		const cc::Planef plane(cc::Vec3f(1.0f, 0.0f, 0.0f), 1.5f);
+		std::vector<unsigned char> sides;
+		Assert::AreEqual(2u, cc::math::classifyTriangles(plane, positions, indices, 0.001f, &sides));
+		Assert::AreEqual(static_cast<size_t>(8), sides.size());
+		Assert::AreEqual(static_cast<unsigned char>(cc::math::BEHIND_PLANE), sides[0]);
+		Assert::AreEqual(static_cast<unsigned char>(cc::math::STRADDLING_PLANE), sides[2]);
+		Assert::AreEqual(static_cast<unsigned char>(cc::math::STRADDLING_PLANE), sides[3]);
+		Assert::AreEqual(static_cast<unsigned char>(cc::math::IN_FRONT_OF_PLANE), sides[7]);
+
+		// Touching the plane at an edge is not straddling.
+		const cc::Planef edgePlane(cc::Vec3f(1.0f, 0.0f, 0.0f), 2.0f);
+		Assert::AreEqual(0u, cc::math::classifyTriangles(edgePlane, positions, indices, 0.001f, &sides));
+	}
+};
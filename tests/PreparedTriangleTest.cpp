@@ -0,0 +1,89 @@
+#include "CppUnitTest.h"
+#include <cc/PreparedTriangle.hpp>
+#include <cc/Intersection.hpp>
+#include "Common.hpp"
+#include <cc/Random.hpp>
+#include <algorithm>
+#include <cmath>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+TEST_CLASS(PreparedTriangleTest) {
+private:
+	cc::math::Random<float, int> rnd;
+
+	cc::Vec3f randomVector( float min, float max ) {
+		return cc::Vec3f(rnd.nextReal(min, max), rnd.nextReal(min, max), rnd.nextReal(min, max));
+	}
+
+public:
+	PreparedTriangleTest()
+		: rnd(11235) {
+	}
+
+	TEST_METHOD(Barycentric) {
+		const cc::Vec3f t0(0.0f, 0.0f, 0.0f), t1(2.0f, 0.0f, 0.0f), t2(0.0f, 2.0f, 0.0f);
+		const cc::PreparedTrianglef tri(t0, t1, t2);
+		Assert::AreEqual(1.0f, tri.normal().z, TOLERANCE);
+		Assert::AreEqual(3.0f, tri.signedDistance(cc::Vec3f(0.5f, 0.5f, 3.0f)), TOLERANCE);
+
+		float u, v, w;
+		tri.barycentric(cc::Vec3f(0.5f, 1.0f, 7.0f), &u, &v, &w);
+		Assert::AreEqual(0.25f, u, TOLERANCE);
+		Assert::AreEqual(0.25f, v, TOLERANCE);
+		Assert::AreEqual(0.5f, w, TOLERANCE);
+
+		// Vertices and edges are inside; just past an edge is not.
+		Assert::IsTrue(tri.contains(t1));
+		Assert::IsTrue(tri.contains(cc::Vec3f(1.0f, 1.0f, 0.0f)));
+		Assert::IsFalse(tri.contains(cc::Vec3f(1.01f, 1.01f, 0.0f)));
+		Assert::IsFalse(tri.contains(cc::Vec3f(-0.01f, 1.0f, 0.0f)));
+
+		// Degenerate triangles contain nothing.
+		const cc::PreparedTrianglef line(t0, t1, cc::Vec3f(4.0f, 0.0f, 0.0f));
+		Assert::IsFalse(line.contains(cc::Vec3f(1.0f, 0.0f, 0.0f)));
+	}
+
+	TEST_METHOD(MatchesPointInTriangle) {
+		for( int i = 0; i < 200; ++i ) {
+			const cc::Vec3f t0 = randomVector(-2.0f, 2.0f), t1 = randomVector(-2.0f, 2.0f), t2 = randomVector(-2.0f, 2.0f);
+			const cc::PreparedTrianglef tri(t0, t1, t2);
+			for( int j = 0; j < 20; ++j ) {
+				// Random points in the triangle's plane, away from its edges.
+				const float a = rnd.nextReal(-0.5f, 1.5f), b = rnd.nextReal(-0.5f, 1.5f);
+				const cc::Vec3f p = t0 + (t1 - t0) * a + (t2 - t0) * b;
+				const float nearest = std::min(std::min(a, b), 1.0f - a - b);
+				if( std::abs(nearest) < 0.01f ) {
+					continue;
+				}
+				Assert::AreEqual(cc::math::pointInTriangle(p, t0, t1, t2), tri.contains(p));
+
+				float u, v, w;
+				tri.barycentric(p, &u, &v, &w);
+				const cc::Vec3f rebuilt = t0 * u + t1 * v + t2 * w;
+				Assert::IsTrue(rebuilt.distance(p) < 1e-3f);
+			}
+		}
+	}
+
+	TEST_METHOD(Batch) {
+		const cc::PreparedTrianglef tri(randomVector(-1.0f, 1.0f), randomVector(-1.0f, 1.0f), randomVector(-1.0f, 1.0f));
+		for( int batch = 0; batch < 50; ++batch ) {
+			cc::Vec3Soa8f points;
+			for( unsigned int k = 0; k < 8; ++k ) {
+				points.set(k, randomVector(-1.0f, 1.0f));
+			}
+			float u[8], v[8], w[8];
+			tri.barycentric(points, u, v, w);
+			const unsigned int mask = tri.contains(points);
+			for( unsigned int k = 0; k < 8; ++k ) {
+				float su, sv, sw;
+				tri.barycentric(points.get(k), &su, &sv, &sw);
+				Assert::AreEqual(su, u[k], TOLERANCE);
+				Assert::AreEqual(sv, v[k], TOLERANCE);
+				Assert::AreEqual(sw, w[k], TOLERANCE);
+				Assert::AreEqual(tri.contains(points.get(k)), (mask & (1u << k)) != 0);
+			}
+		}
+	}
+};
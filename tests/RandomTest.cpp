@@ -1,6 +1,9 @@
 #include "CppUnitTest.h"
 #include <cc/Random.hpp>
 #include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
@@ -63,4 +66,153 @@ public:
 
 		Assert::IsTrue(a == b);
 	}
+
+	TEST_METHOD(Engines) {
+		// Reference outputs published with each generator.
+		cc::math::SplitMix64 splitMix(1234567);
+		Assert::IsTrue(splitMix() == 6457827717110365317ull);
+		Assert::IsTrue(splitMix() == 3203168211198807973ull);
+		Assert::IsTrue(splitMix() == 9817491932198370423ull);
+		cc::math::Pcg32 pcg(42, 54);
+		Assert::IsTrue(pcg() == 0xA15C02B7u);
+		Assert::IsTrue(pcg() == 0x7B47F409u);
+		Assert::IsTrue(pcg() == 0xBA1D3330u);
+		Assert::IsTrue(pcg() == 0x83D2F293u);
+
+		cc::math::Random<float, int, cc::math::Xoshiro256StarStar> xoshiroA(7);
+		cc::math::Random<float, int, cc::math::Xoshiro256StarStar> xoshiroB(7);
+		cc::math::Random<double, long long, cc::math::Pcg32> pcgRandom(7);
+		for( int i = 0; i < 1000; ++i ) {
+			Assert::AreEqual(xoshiroA.nextInt(), xoshiroB.nextInt());
+			const float f = xoshiroA.nextReal(-2.0f, 3.0f);
+			Assert::AreEqual(f, xoshiroB.nextReal(-2.0f, 3.0f));
+			Assert::IsTrue(f >= -2.0f && f < 3.0f);
+			const double d = pcgRandom.nextReal();
+			Assert::IsTrue(d >= 0.0 && d < 1.0);
+			const long long n = pcgRandom.nextInt(-5, 5);
+			Assert::IsTrue(n >= -5 && n <= 5);
+		}
+		const int val = cc::math::Random<float, int, cc::math::SplitMix64>::rangedInt(1, 6);
+		Assert::IsTrue(val >= 1 && val <= 6);
+	}
+
+	TEST_METHOD(StaticSeeding) {
+		typedef cc::math::Random<float, int> Rand;
+		const int RESULTS = 100;
+		std::array<int, RESULTS> a = {};
+		std::array<int, RESULTS> b = {};
+
+		// The same base seed repeats the calling thread's sequence.
+		Rand::seedThreadsDeterministic(42);
+		for( int i = 0; i < RESULTS; ++i ) {
+			a[i] = Rand::rangedInt(0, 1000000);
+		}
+		Rand::seedThreadsDeterministic(42);
+		for( int i = 0; i < RESULTS; ++i ) {
+			b[i] = Rand::rangedInt(0, 1000000);
+		}
+		Assert::IsTrue(a == b);
+
+		// So does seeding the thread directly, and it sticks until the next global reseed.
+		Rand::seedThread(7);
+		for( int i = 0; i < RESULTS; ++i ) {
+			a[i] = Rand::rangedInt(0, 1000000);
+		}
+		Rand::seedThread(7);
+		for( int i = 0; i < RESULTS; ++i ) {
+			b[i] = Rand::rangedInt(0, 1000000);
+		}
+		Assert::IsTrue(a == b);
+
+		Rand::seedThreadsRandom();
+		const float val = Rand::rangedReal(-1.0f, 1.0f);
+		Assert::IsTrue(val >= -1.0f && val < 1.0f);
+	}
+
+	TEST_METHOD(Fills) {
+		cc::math::Random<float, int, cc::math::Xoshiro256StarStar> rnd(3);
+		std::vector<float> reals(1003);
+		rnd.fillReal(reals, -2.0f, 6.0f);
+		double sum = 0.0;
+		for( size_t i = 0; i < reals.size(); ++i ) {
+			Assert::IsTrue(reals[i] >= -2.0f && reals[i] < 6.0f);
+			sum += reals[i];
+		}
+		Assert::AreEqual(2.0, sum / reals.size(), 0.3);
+
+		// Every value of a small range turns up, and nothing outside it.
+		std::vector<int> ints(1000);
+		rnd.fillInt(ints, -3, 3);
+		int counts[7] = {};
+		for( size_t i = 0; i < ints.size(); ++i ) {
+			Assert::IsTrue(ints[i] >= -3 && ints[i] <= 3);
+			counts[ints[i] + 3] += 1;
+		}
+		for( int i = 0; i < 7; ++i ) {
+			Assert::IsTrue(counts[i] > 80);
+		}
+
+		cc::math::Random<double, long long, cc::math::Pcg32> rnd64(3);
+		std::vector<long long> wide(100);
+		rnd64.fillInt(wide, -(1LL << 40), 1LL << 40);
+		for( size_t i = 0; i < wide.size(); ++i ) {
+			Assert::IsTrue(wide[i] >= -(1LL << 40) && wide[i] <= (1LL << 40));
+		}
+
+		std::vector<cc::Vec3f> dirs(1001);
+		rnd.fillUnitVec3(dirs);
+		cc::Vec3f mean(0.0f);
+		for( size_t i = 0; i < dirs.size(); ++i ) {
+			Assert::AreEqual(1.0f, dirs[i].magnitude(), 1e-4f);
+			mean = mean + dirs[i];
+		}
+		Assert::IsTrue((mean / static_cast<float>(dirs.size())).magnitude() < 0.1f);
+	}
+
+	TEST_METHOD(Streams) {
+		// Skipping ahead lands where stepping does.
+		cc::math::Pcg32 pcgA(11, 3);
+		cc::math::Pcg32 pcgB(11, 3);
+		cc::math::SplitMix64 mixA(11);
+		cc::math::SplitMix64 mixB(11);
+		cc::math::Philox4x32 philoxA(11, 3);
+		cc::math::Philox4x32 philoxB(11, 3);
+		for( int i = 0; i < 1001; ++i ) {
+			pcgA();
+			mixA();
+			philoxA();
+		}
+		pcgB.discard(1001);
+		mixB.discard(1001);
+		philoxB.discard(1001);
+		Assert::IsTrue(pcgA() == pcgB());
+		Assert::IsTrue(mixA() == mixB());
+		Assert::IsTrue(philoxA() == philoxB());
+
+		// Philox outputs are a pure function of (seed, stream, index).  Reference block from the Random123 test vectors.
+		std::uint32_t block[4];
+		cc::math::Philox4x32::block(0, 0, 0, block);
+		Assert::IsTrue(block[0] == 0x6627E8D5u && block[1] == 0xE169C58Du && block[2] == 0xBC57AC4Cu && block[3] == 0x9B00DBD8u);
+		cc::math::Philox4x32 philox(5, 9);
+		for( std::uint64_t i = 0; i < 10; ++i ) {
+			Assert::IsTrue(philox() == cc::math::Philox4x32::at(5, 9, i));
+		}
+		Assert::IsTrue(cc::math::Philox4x32::at(5, 9, 0) != cc::math::Philox4x32::at(5, 10, 0));
+
+		// Jumped xoshiro substreams are reproducible and distinct.
+		cc::math::Xoshiro256StarStar base(11);
+		cc::math::Xoshiro256StarStar sub1 = base;
+		sub1.jump();
+		cc::math::Xoshiro256StarStar sub1Again = base;
+		sub1Again.jump();
+		cc::math::Xoshiro256StarStar sub2 = sub1;
+		sub2.jump();
+		const std::uint64_t first = sub1();
+		Assert::IsTrue(first == sub1Again());
+		Assert::IsTrue(first != sub2() && first != base());
+
+		cc::math::Random<float, int, cc::math::Philox4x32> rndA(cc::math::Philox4x32(1, 2));
+		cc::math::Random<float, int, cc::math::Philox4x32> rndB(cc::math::Philox4x32(1, 2));
+		Assert::AreEqual(rndA.nextInt(), rndB.nextInt());
+	}
 };
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include "CppUnitTest.h"
+#include <cc/Sampling.hpp>
+#include <cc/PreparedTriangle.hpp>
+#include <cc/Random.hpp>
+#include "Common.hpp"
+#include <cmath>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+TEST_CLASS(SamplingTest) {
+private:
+	cc::math::Random<float, int, cc::math::Xoshiro256StarStar> rnd;
+
+	static const int SAMPLES = 4000;
+
+public:
+	SamplingTest()
+		: rnd(1234) {
+	}
+
+	TEST_METHOD(SphereAndBall) {
+		std::vector<float> u(SAMPLES * 3);
+		rnd.fillReal(u, 0.0f, 1.0f);
+		cc::Vec3f mean(0.0f);
+		float cubedRadius = 0.0f;
+		for( int i = 0; i < SAMPLES; ++i ) {
+			const cc::Vec3f s = cc::math::sampleSphere(u[i * 3 + 0], u[i * 3 + 1]);
+			Assert::AreEqual(1.0f, s.magnitude(), 1e-4f);
+			mean = mean + s;
+			const cc::Vec3f b = cc::math::sampleBall(u[i * 3 + 0], u[i * 3 + 1], u[i * 3 + 2]);
+			Assert::IsTrue(b.magnitude() <= 1.0f + 1e-4f);
+			cubedRadius += b.magnitude() * b.sqrMagnitude();
+		}
+		// Uniform in the ball means the cubed radius is uniform, with a mean of a half.
+		Assert::IsTrue((mean / static_cast<float>(SAMPLES)).magnitude() < 0.05f);
+		Assert::AreEqual(0.5f, cubedRadius / SAMPLES, 0.03f);
+
+		// Batched lanes match the scalar mapping.
+		cc::Vec3Soa8f sphere, ball;
+		cc::math::sampleSphere(&u[0], &u[8], &sphere);
+		cc::math::sampleBall(&u[0], &u[8], &u[16], &ball);
+		for( unsigned int k = 0; k < 8; ++k ) {
+			const cc::Vec3f s = cc::math::sampleSphere(u[k], u[8 + k]);
+			const cc::Vec3f b = cc::math::sampleBall(u[k], u[8 + k], u[16 + k]);
+			Assert::AreEqual(s.x, sphere.x[k], TOLERANCE);
+			Assert::AreEqual(s.z, sphere.z[k], TOLERANCE);
+			Assert::AreEqual(b.y, ball.y[k], TOLERANCE);
+		}
+	}
+
+	TEST_METHOD(Disc) {
+		std::vector<float> u(SAMPLES * 2);
+		rnd.fillReal(u, 0.0f, 1.0f);
+		float sqrRadius = 0.0f;
+		int inRightHalf = 0;
+		for( int i = 0; i < SAMPLES; ++i ) {
+			const cc::Vec2f d = cc::math::sampleDisc(u[i * 2 + 0], u[i * 2 + 1]);
+			const float r2 = d.x * d.x + d.y * d.y;
+			Assert::IsTrue(r2 <= 1.0f + 1e-4f);
+			sqrRadius += r2;
+			inRightHalf += (d.x > 0.0f) ? 1 : 0;
+		}
+		Assert::AreEqual(0.5f, sqrRadius / SAMPLES, 0.03f);
+		Assert::AreEqual(0.5f, static_cast<float>(inRightHalf) / SAMPLES, 0.03f);
+
+		float x[8], y[8];
+		cc::math::sampleDisc(&u[0], &u[8], x, y);
+		for( unsigned int k = 0; k < 8; ++k ) {
+			const cc::Vec2f d = cc::math::sampleDisc(u[k], u[8 + k]);
+			Assert::AreEqual(d.x, x[k], TOLERANCE);
+			Assert::AreEqual(d.y, y[k], TOLERANCE);
+		}
+	}
+
+	TEST_METHOD(Triangle) {
+		const cc::Vec3f t0(1.0f, 0.0f, 0.0f);
+		const cc::Vec3f t1(4.0f, 1.0f, 2.0f);
+		const cc::Vec3f t2(0.0f, 3.0f, -1.0f);
+		const cc::PreparedTrianglef prepared(t0, t1, t2);
+		std::vector<float> u(SAMPLES * 2);
+		rnd.fillReal(u, 0.0f, 1.0f);
+		cc::Vec3f mean(0.0f);
+		for( int i = 0; i < SAMPLES; ++i ) {
+			const cc::Vec3f p = cc::math::sampleTriangle(t0, t1, t2, u[i * 2 + 0], u[i * 2 + 1]);
+			Assert::AreEqual(0.0f, prepared.signedDistance(p), 1e-4f);
+			float bu, bv, bw;
+			prepared.barycentric(p, &bu, &bv, &bw);
+			Assert::IsTrue(bu >= -1e-4f && bv >= -1e-4f && bw >= -1e-4f);
+			mean = mean + p;
+		}
+		// Uniform samples average to the centroid.
+		mean = mean / static_cast<float>(SAMPLES);
+		const cc::Vec3f centroid = (t0 + t1 + t2) / 3.0f;
+		Assert::IsTrue(std::sqrt(mean.sqrDistance(centroid)) < 0.1f);
+
+		cc::Vec3Soa8f points;
+		cc::math::sampleTriangle(t0, t1, t2, &u[0], &u[8], &points);
+		for( unsigned int k = 0; k < 8; ++k ) {
+			const cc::Vec3f p = cc::math::sampleTriangle(t0, t1, t2, u[k], u[8 + k]);
+			Assert::AreEqual(p.x, points.x[k], TOLERANCE);
+			Assert::AreEqual(p.y, points.y[k], TOLERANCE);
+			Assert::AreEqual(p.z, points.z[k], TOLERANCE);
+		}
+	}
+
+	TEST_METHOD(CosineHemisphere) {
+		cc::Onbf frame;
+		frame.initFromW(cc::Vec3f(1.0f, 2.0f, -2.0f));
+		std::vector<float> u(SAMPLES * 2);
+		rnd.fillReal(u, 0.0f, 1.0f);
+		float meanCos = 0.0f;
+		for( int i = 0; i < SAMPLES; ++i ) {
+			const cc::Vec3f d = cc::math::sampleCosineHemisphere(frame, u[i * 2 + 0], u[i * 2 + 1]);
+			Assert::AreEqual(1.0f, d.magnitude(), 1e-3f);
+			const float cosTheta = d.dot(frame.w());
+			Assert::IsTrue(cosTheta >= -1e-4f);
+			meanCos += cosTheta;
+		}
+		// The mean cosine of a cosine-weighted hemisphere is 2/3.
+		Assert::AreEqual(2.0f / 3.0f, meanCos / SAMPLES, 0.02f);
+
+		cc::Vec3Soa8f dirs;
+		cc::math::sampleCosineHemisphere(frame, &u[0], &u[8], &dirs);
+		for( unsigned int k = 0; k < 8; ++k ) {
+			const cc::Vec3f d = cc::math::sampleCosineHemisphere(frame, u[k], u[8 + k]);
+			Assert::AreEqual(d.x, dirs.x[k], TOLERANCE);
+			Assert::AreEqual(d.y, dirs.y[k], TOLERANCE);
+			Assert::AreEqual(d.z, dirs.z[k], TOLERANCE);
+		}
+	}
+};
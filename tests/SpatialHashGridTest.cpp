@@ -0,0 +1,119 @@
+#include "CppUnitTest.h"
+#include <cc/SpatialHashGrid.hpp>
+#include <cc/Random.hpp>
+#include <algorithm>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+TEST_CLASS(SpatialHashGridTest) {
+private:
+	cc::math::Random<float, int> rnd;
+	std::vector<cc::Vec3f> points;
+
+	cc::Vec3f randomVector( float min, float max ) {
+		return cc::Vec3f(rnd.nextReal(min, max), rnd.nextReal(min, max), rnd.nextReal(min, max));
+	}
+
+	void buildCloud( unsigned int count ) {
+		points.clear();
+		for( unsigned int i = 0; i < count; ++i ) {
+			points.push_back(randomVector(-10.0f, 10.0f));
+		}
+	}
+
+public:
+	SpatialHashGridTest()
+		: rnd(97531) {
+	}
+
+	TEST_METHOD(Build) {
+		buildCloud(5000);
+		cc::SpatialHashGridf grid(0.5f);
+		grid.build(points);
+		Assert::AreEqual(5000u, grid.pointCount());
+		Assert::AreEqual(8192u, grid.tableSize());
+
+		// Every point is found by a zero radius query at its own position.
+		std::vector<unsigned int> found;
+		for( unsigned int i = 0; i < points.size(); i += 37 ) {
+			grid.queryRadius(points[i], 0.0f, &found);
+			Assert::IsTrue(std::find(found.begin(), found.end(), i) != found.end());
+		}
+
+		grid.clear();
+		Assert::AreEqual(0u, grid.pointCount());
+		Assert::AreEqual(0u, grid.queryRadius(cc::Vec3f(0.0f), 100.0f, &found));
+	}
+
+	TEST_METHOD(LargeBuild) {
+		// Enough points that the bucket ranges split across threads.
+		buildCloud(70000);
+		cc::SpatialHashGridf grid(0.25f);
+		grid.build(points);
+		Assert::AreEqual(70000u, grid.pointCount());
+		std::vector<unsigned int> found;
+		for( unsigned int i = 0; i < points.size(); i += 97 ) {
+			grid.queryRadius(points[i], 0.0f, &found);
+			Assert::IsTrue(std::find(found.begin(), found.end(), i) != found.end());
+		}
+		grid.queryRadius(cc::Vec3f(0.0f), 100.0f, &found);
+		Assert::AreEqual(70000u, static_cast<unsigned int>(found.size()));
+	}
+
+	TEST_METHOD(Radius) {
+		buildCloud(5000);
+		cc::SpatialHashGridf grid(1.0f);
+		grid.build(points);
+
+		std::vector<unsigned int> found;
+		const float radii[] = { 0.3f, 1.0f, 2.5f, 50.0f };
+		for( int q = 0; q < 100; ++q ) {
+			const cc::Vec3f center = randomVector(-12.0f, 12.0f);
+			const float radius = radii[q % 4];
+			grid.queryRadius(center, radius, &found);
+			std::sort(found.begin(), found.end());
+
+			std::vector<unsigned int> expected;
+			for( unsigned int i = 0; i < points.size(); ++i ) {
+				if( points[i].sqrDistance(center) <= radius * radius ) {
+					expected.push_back(i);
+				}
+			}
+			Assert::AreEqual(expected.size(), found.size());
+			for( size_t i = 0; i < expected.size(); ++i ) {
+				Assert::AreEqual(expected[i], found[i]);
+			}
+		}
+	}
+
+	TEST_METHOD(Nearest) {
+		buildCloud(3000);
+		cc::SpatialHashGridf grid(0.75f);
+		grid.build(points);
+
+		std::vector<unsigned int> found;
+		std::vector<float> sqrDistances;
+		for( int q = 0; q < 100; ++q ) {
+			// Include queries well outside the cloud.
+			const cc::Vec3f point = randomVector(-15.0f, 15.0f) * ((q % 10 == 0) ? 4.0f : 1.0f);
+			const unsigned int k = 1 + q % 12;
+			Assert::AreEqual(k, grid.nearest(point, k, &found, &sqrDistances));
+
+			std::vector<float> expected;
+			for( size_t i = 0; i < points.size(); ++i ) {
+				expected.push_back(points[i].sqrDistance(point));
+			}
+			std::sort(expected.begin(), expected.end());
+			for( unsigned int i = 0; i < k; ++i ) {
+				Assert::AreEqual(expected[i], sqrDistances[i]);
+				Assert::AreEqual(expected[i], points[found[i]].sqrDistance(point));
+			}
+		}
+
+		// Asking for more points than there are returns them all.
+		buildCloud(10);
+		grid.build(points);
+		Assert::AreEqual(10u, grid.nearest(cc::Vec3f(0.0f), 20, &found, (std::vector<float>*)nullptr));
+	}
+};
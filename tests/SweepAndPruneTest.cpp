@@ -0,0 +1,128 @@
+#include "CppUnitTest.h"
+#include <cc/SweepAndPrune.hpp>
+#include <cc/Random.hpp>
+#include <algorithm>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+TEST_CLASS(SweepAndPruneTest) {
+private:
+	cc::math::Random<float, int> rnd;
+
+	cc::Vec3f randomVector( float min, float max ) {
+		return cc::Vec3f(rnd.nextReal(min, max), rnd.nextReal(min, max), rnd.nextReal(min, max));
+	}
+
+	static bool pairLess( const cc::math::BroadphasePair& lhs, const cc::math::BroadphasePair& rhs ) {
+		return (lhs.first != rhs.first) ? (lhs.first < rhs.first) : (lhs.second < rhs.second);
+	}
+
+	// Sorted copy of the broadphase's pairs, for comparison against a brute force search.
+	static std::vector<cc::math::BroadphasePair> sortedPairs( const cc::SweepAndPrunef& sap ) {
+		std::vector<cc::math::BroadphasePair> pairs = sap.pairs();
+		std::sort(pairs.begin(), pairs.end(), pairLess);
+		return pairs;
+	}
+
+	static void assertSamePairs( const std::vector<cc::math::BroadphasePair>& expected, const std::vector<cc::math::BroadphasePair>& actual ) {
+		Assert::AreEqual(expected.size(), actual.size());
+		for( size_t i = 0; i < expected.size(); ++i ) {
+			Assert::AreEqual(expected[i].first, actual[i].first);
+			Assert::AreEqual(expected[i].second, actual[i].second);
+		}
+	}
+
+public:
+	SweepAndPruneTest()
+		: rnd(1357) {
+	}
+
+	TEST_METHOD(Boxes) {
+		std::vector<cc::Vec3f> centers;
+		std::vector<cc::Aabbf> boxes;
+		for( int i = 0; i < 300; ++i ) {
+			centers.push_back(randomVector(-20.0f, 20.0f) * cc::Vec3f(2.0f, 1.0f, 0.5f));
+			const cc::Vec3f half = randomVector(0.2f, 1.5f);
+			boxes.push_back(cc::Aabbf(centers.back() - half, centers.back() + half));
+		}
+
+		cc::SweepAndPrunef sap;
+		for( int frame = 0; frame < 10; ++frame ) {
+			sap.update(boxes);
+			// Most spread along x.
+			Assert::AreEqual(0, sap.axis());
+
+			std::vector<cc::math::BroadphasePair> expected;
+			for( unsigned int i = 0; i < boxes.size(); ++i ) {
+				for( unsigned int j = i + 1; j < boxes.size(); ++j ) {
+					if( boxes[i].overlaps(boxes[j]) ) {
+						const cc::math::BroadphasePair pair = { i, j };
+						expected.push_back(pair);
+					}
+				}
+			}
+			Assert::IsTrue(!expected.empty());
+			assertSamePairs(expected, sortedPairs(sap));
+
+			// Small moves keep the previous order nearly sorted.
+			for( size_t i = 0; i < boxes.size(); ++i ) {
+				const cc::Vec3f offset = randomVector(-0.5f, 0.5f);
+				boxes[i].boundsMin += offset;
+				boxes[i].boundsMax += offset;
+			}
+		}
+	}
+
+	TEST_METHOD(Spheres) {
+		std::vector<cc::Vec3f> centers;
+		std::vector<float> radii;
+		for( int i = 0; i < 300; ++i ) {
+			centers.push_back(randomVector(-10.0f, 10.0f));
+			radii.push_back(rnd.nextReal(0.1f, 1.0f));
+		}
+
+		cc::SweepAndPrunef sap;
+		for( int frame = 0; frame < 10; ++frame ) {
+			sap.update(centers, radii);
+
+			std::vector<cc::math::BroadphasePair> expected;
+			for( unsigned int i = 0; i < centers.size(); ++i ) {
+				for( unsigned int j = i + 1; j < centers.size(); ++j ) {
+					const float radius = radii[i] + radii[j];
+					if( centers[i].sqrDistance(centers[j]) <= radius * radius ) {
+						const cc::math::BroadphasePair pair = { i, j };
+						expected.push_back(pair);
+					}
+				}
+			}
+			Assert::IsTrue(!expected.empty());
+			assertSamePairs(expected, sortedPairs(sap));
+
+			for( size_t i = 0; i < centers.size(); ++i ) {
+				centers[i] += randomVector(-0.25f, 0.25f);
+			}
+		}
+	}
+
+	TEST_METHOD(ReusesBuffers) {
+		std::vector<cc::Vec3f> centers;
+		std::vector<float> radii;
+		for( int i = 0; i < 100; ++i ) {
+			centers.push_back(randomVector(-5.0f, 5.0f));
+			radii.push_back(1.0f);
+		}
+
+		cc::SweepAndPrunef sap;
+		const unsigned int count = sap.update(centers, radii);
+		Assert::AreEqual(static_cast<size_t>(count), sap.pairs().size());
+		const cc::math::BroadphasePair* pairs = sap.pairs().data();
+		for( int frame = 0; frame < 5; ++frame ) {
+			Assert::AreEqual(count, sap.update(centers, radii));
+			Assert::IsTrue(pairs == sap.pairs().data());
+		}
+
+		sap.clear();
+		Assert::IsTrue(sap.pairs().empty());
+	}
+};
@@ -0,0 +1,120 @@
+#include "CppUnitTest.h"
+#include <cc/TriMath.hpp>
+#include "Common.hpp"
+#include <cmath>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+TEST_CLASS(TriMathTest) {
+private:
+	std::vector<cc::Vec3f> positions;
+	std::vector<unsigned int> indices;
+
+	void addQuad( unsigned int a, unsigned int b, unsigned int c, unsigned int d ) {
+		const unsigned int quad[6] = { a, b, c, a, c, d };
+		indices.insert(indices.end(), quad, quad + 6);
+	}
+
+	// Closed box, two triangles per face, wound counter-clockwise from outside.
+	void buildBox( const cc::Vec3f& boxMin, const cc::Vec3f& boxMax ) {
+		positions.clear();
+		indices.clear();
+		for( unsigned int i = 0; i < 8; ++i ) {
+			positions.push_back(cc::Vec3f((i & 1) ? boxMax.x : boxMin.x, (i & 2) ? boxMax.y : boxMin.y, (i & 4) ? boxMax.z : boxMin.z));
+		}
+		addQuad(0, 2, 3, 1); addQuad(4, 5, 7, 6);
+		addQuad(0, 1, 5, 4); addQuad(2, 6, 7, 3);
+		addQuad(0, 4, 6, 2); addQuad(1, 3, 7, 5);
+	}
+
+	// Direction from the box's center to corner i.
+	cc::Vec3f cornerDirection( unsigned int i ) const {
+		const float s = 1.0f / std::sqrt(3.0f);
+		return cc::Vec3f((i & 1) ? s : -s, (i & 2) ? s : -s, (i & 4) ? s : -s);
+	}
+
+public:
+	TEST_METHOD(TriangleNormalAndArea) {
+		const cc::Vec3f p0(0.0f, 0.0f, 0.0f);
+		const cc::Vec3f p1(2.0f, 0.0f, 0.0f);
+		const cc::Vec3f p2(0.0f, 3.0f, 0.0f);
+		const cc::Vec3f n = cc::math::computeTriangleNormal(p0, p1, p2);
+		Assert::AreEqual(6.0f, n.z, TOLERANCE);
+		Assert::AreEqual(3.0f, cc::math::computeTriangleArea(p0, p1, p2), TOLERANCE);
+	}
+
+	TEST_METHOD(VertexNormalsPlane) {
+		// 20x20 grid of quads in the XY plane; every normal is +Z whatever the weighting.
+		positions.clear();
+		indices.clear();
+		const unsigned int size = 21;
+		for( unsigned int y = 0; y < size; ++y ) {
+			for( unsigned int x = 0; x < size; ++x ) {
+				positions.push_back(cc::Vec3f(static_cast<float>(x), static_cast<float>(y) * 0.5f, 0.0f));
+			}
+		}
+		for( unsigned int y = 0; y + 1 < size; ++y ) {
+			for( unsigned int x = 0; x + 1 < size; ++x ) {
+				addQuad(y * size + x, y * size + x + 1, (y + 1) * size + x + 1, (y + 1) * size + x);
+			}
+		}
+
+		std::vector<cc::Vec3f> normals;
+		for( int weighting = cc::math::WEIGHT_BY_AREA; weighting <= cc::math::WEIGHT_BY_ANGLE; ++weighting ) {
+			cc::math::computeVertexNormals(positions, indices, &normals, static_cast<cc::math::VertexNormalWeighting>(weighting));
+			Assert::AreEqual(positions.size(), normals.size());
+			for( size_t i = 0; i < normals.size(); ++i ) {
+				Assert::AreEqual(0.0f, normals[i].x, TOLERANCE);
+				Assert::AreEqual(0.0f, normals[i].y, TOLERANCE);
+				Assert::AreEqual(1.0f, normals[i].z, TOLERANCE);
+			}
+		}
+	}
+
+	TEST_METHOD(VertexNormalsBoxWeighting) {
+		buildBox(cc::Vec3f(-1.0f), cc::Vec3f(1.0f));
+
+		// Each face meets each corner at a right angle however the face is split, so angle weighting is symmetric.
+		std::vector<cc::Vec3f> normals;
+		cc::math::computeVertexNormals(positions, indices, &normals, cc::math::WEIGHT_BY_ANGLE);
+		for( unsigned int i = 0; i < 8; ++i ) {
+			const cc::Vec3f expected = cornerDirection(i);
+			Assert::AreEqual(expected.x, normals[i].x, TOLERANCE);
+			Assert::AreEqual(expected.y, normals[i].y, TOLERANCE);
+			Assert::AreEqual(expected.z, normals[i].z, TOLERANCE);
+		}
+
+		// By area, a face counts twice at corners touched by both of its triangles, which skews corner 1.
+		cc::math::computeVertexNormals(positions, indices, &normals, cc::math::WEIGHT_BY_AREA);
+		Assert::AreEqual(1.0f, normals[1].magnitude(), TOLERANCE);
+		Assert::IsTrue(normals[1].dot(cornerDirection(1)) < 0.99f);
+	}
+
+	TEST_METHOD(VertexNormalsReuseAdjacency) {
+		buildBox(cc::Vec3f(-1.0f), cc::Vec3f(1.0f));
+		positions.push_back(cc::Vec3f(5.0f)); // Not used by any face.
+
+		cc::math::VertexFaceAdjacency adjacency;
+		adjacency.build(positions.size(), indices);
+		Assert::AreEqual(positions.size() + 1, adjacency.offsets.size());
+		Assert::AreEqual(indices.size(), adjacency.corners.size());
+
+		std::vector<cc::Vec3f> normals;
+		std::vector<cc::Vec3f> expected;
+		for( unsigned int frame = 1; frame <= 3; ++frame ) {
+			// Deform the mesh; the connectivity, and so the adjacency, stays the same.
+			for( unsigned int i = 0; i < 8; ++i ) {
+				positions[i] = cornerDirection(i) * static_cast<float>(frame) + cc::Vec3f(static_cast<float>(frame), 0.0f, 0.0f);
+			}
+			cc::math::computeVertexNormals(positions, indices, adjacency, &normals, cc::math::WEIGHT_BY_ANGLE);
+			cc::math::computeVertexNormals(positions, indices, &expected, cc::math::WEIGHT_BY_ANGLE);
+			for( size_t i = 0; i < normals.size(); ++i ) {
+				Assert::AreEqual(expected[i].x, normals[i].x, TOLERANCE);
+				Assert::AreEqual(expected[i].y, normals[i].y, TOLERANCE);
+				Assert::AreEqual(expected[i].z, normals[i].z, TOLERANCE);
+			}
+			Assert::AreEqual(0.0f, normals[8].magnitude(), TOLERANCE);
+		}
+	}
+};
@@ -0,0 +1,115 @@
+#include "CppUnitTest.h"
+#include <cc/Voxelizer.hpp>
+#include "Common.hpp"
+#include <cmath>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+TEST_CLASS(VoxelizerTest) {
+private:
+	std::vector<cc::Vec3f> positions;
+	std::vector<unsigned int> indices;
+
+	void addQuad( unsigned int a, unsigned int b, unsigned int c, unsigned int d ) {
+		const unsigned int quad[6] = { a, b, c, a, c, d };
+		indices.insert(indices.end(), quad, quad + 6);
+	}
+
+	// Closed box, two triangles per face.
+	void buildBox( const cc::Vec3f& boxMin, const cc::Vec3f& boxMax ) {
+		positions.clear();
+		indices.clear();
+		for( unsigned int i = 0; i < 8; ++i ) {
+			positions.push_back(cc::Vec3f((i & 1) ? boxMax.x : boxMin.x, (i & 2) ? boxMax.y : boxMin.y, (i & 4) ? boxMax.z : boxMin.z));
+		}
+		addQuad(0, 2, 3, 1); addQuad(4, 5, 7, 6);
+		addQuad(0, 1, 5, 4); addQuad(2, 6, 7, 3);
+		addQuad(0, 4, 6, 2); addQuad(1, 3, 7, 5);
+	}
+
+	// Closed octahedron |x| + |y| + |z| = radius.
+	void buildOctahedron( float radius ) {
+		positions.clear();
+		indices.clear();
+		positions.push_back(cc::Vec3f(radius, 0.0f, 0.0f));  positions.push_back(cc::Vec3f(-radius, 0.0f, 0.0f));
+		positions.push_back(cc::Vec3f(0.0f, radius, 0.0f));  positions.push_back(cc::Vec3f(0.0f, -radius, 0.0f));
+		positions.push_back(cc::Vec3f(0.0f, 0.0f, radius));  positions.push_back(cc::Vec3f(0.0f, 0.0f, -radius));
+		for( unsigned int x = 0; x < 2; ++x ) {
+			for( unsigned int y = 2; y < 4; ++y ) {
+				for( unsigned int z = 4; z < 6; ++z ) {
+					indices.push_back(x); indices.push_back(y); indices.push_back(z);
+				}
+			}
+		}
+	}
+
+public:
+	TEST_METHOD(Grid) {
+		cc::VoxelGridf grid(cc::Aabbf(cc::Vec3f(0.0f), cc::Vec3f(10.0f, 2.0f, 1.0f)), 0.5f);
+		Assert::AreEqual(20u, grid.sizeX());
+		Assert::AreEqual(4u, grid.sizeY());
+		Assert::AreEqual(2u, grid.sizeZ());
+		Assert::AreEqual(1u, grid.wordsPerRow());
+		Assert::AreEqual(static_cast<size_t>(0), grid.count());
+
+		grid.set(19, 3, 1, true);
+		grid.set(0, 0, 0, true);
+		Assert::IsTrue(grid.get(19, 3, 1));
+		Assert::IsFalse(grid.get(18, 3, 1));
+		Assert::AreEqual(static_cast<size_t>(2), grid.count());
+		grid.set(0, 0, 0, false);
+		Assert::AreEqual(static_cast<size_t>(1), grid.count());
+
+		const cc::Vec3f center = grid.voxelCenter(1, 2, 1);
+		Assert::AreEqual(0.75f, center.x, TOLERANCE);
+		Assert::AreEqual(1.25f, center.y, TOLERANCE);
+		Assert::AreEqual(0.75f, center.z, TOLERANCE);
+	}
+
+	TEST_METHOD(SurfaceAndSolidBox) {
+		// Box faces fall between voxel boundaries; 10 cells per axis touch the box and 8 have their centers inside.
+		buildBox(cc::Vec3f(-1.05f), cc::Vec3f(1.05f));
+		cc::VoxelGridf grid(cc::Vec3f(-2.0f), 0.25f, 16, 16, 16);
+
+		cc::math::voxelizeSurface(positions, indices, &grid);
+		Assert::AreEqual(static_cast<size_t>(10 * 10 * 10 - 8 * 8 * 8), grid.count());
+		Assert::IsTrue(grid.get(3, 8, 8));
+		Assert::IsFalse(grid.get(8, 8, 8));
+
+		cc::math::voxelizeSolid(positions, indices, &grid);
+		Assert::AreEqual(static_cast<size_t>(8 * 8 * 8), grid.count());
+		Assert::IsTrue(grid.get(4, 4, 4));
+		Assert::IsFalse(grid.get(3, 8, 8));
+	}
+
+	TEST_METHOD(SolidMatchesInsideTest) {
+		// Rows wider than one word.
+		const float radius = 1.3f;
+		buildOctahedron(radius);
+		cc::VoxelGridf grid(cc::Vec3f(-1.5f, -1.5f, -1.5f), 3.0f / 70.0f, 70, 70, 70);
+		cc::math::voxelizeSolid(positions, indices, &grid);
+
+		size_t inside = 0;
+		for( unsigned int z = 0; z < grid.sizeZ(); ++z ) {
+			for( unsigned int y = 0; y < grid.sizeY(); ++y ) {
+				for( unsigned int x = 0; x < grid.sizeX(); ++x ) {
+					const cc::Vec3f c = grid.voxelCenter(x, y, z);
+					const float sum = std::abs(c.x) + std::abs(c.y) + std::abs(c.z);
+					if( std::abs(sum - radius) < 1e-4f ) {
+						continue;
+					}
+					inside += (sum < radius) ? 1 : 0;
+					Assert::AreEqual(sum < radius, grid.get(x, y, z));
+				}
+			}
+		}
+		Assert::IsTrue(inside > 0);
+
+		// Rows of voxel centers pass exactly through the diagonals splitting the box's faces.
+		buildBox(cc::Vec3f(-1.0f), cc::Vec3f(1.0f));
+		grid.reset(cc::Vec3f(-1.5f), 0.25f, 12, 12, 12);
+		cc::math::voxelizeSolid(positions, indices, &grid);
+		Assert::AreEqual(static_cast<size_t>(8 * 8 * 8), grid.count());
+	}
+};